@@ -72,6 +72,10 @@ class ObsGroupingParameters : public oops::Parameters {
     /// treatment of missing sort values
     oops::Parameter<MissingSortValueTreatment> missingSortValueTreatment{
       "missing sort value treatment", MissingSortValueTreatment::SORT, this};
+
+    /// number of threads used to sort the locations within the records (values
+    /// below 2 sort the records serially)
+    oops::Parameter<int> sortThreads{"sort threads", 1, this};
 };
 
 class ObsDataInParameters : public oops::Parameters {
@@ -86,6 +90,14 @@ class ObsDataInParameters : public oops::Parameters {
 
     /// maximum frame size
     oops::Parameter<int> maxFrameSize{"max frame size", DefaultFrameSize, this};
+
+    /// number of frames to read ahead of the frame being processed, using a background
+    /// thread (zero disables the prefetch)
+    oops::Parameter<int> prefetchFrames{"prefetch frames", 0, this};
+
+    /// number of threads used to transfer the variables of each frame into the obs space
+    /// (values below 2 transfer the variables serially)
+    oops::Parameter<int> transferThreads{"transfer threads", 1, this};
 };
 
 class ObsDataOutParameters : public oops::Parameters {
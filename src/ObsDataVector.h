@@ -8,6 +8,7 @@
 #ifndef OBSDATAVECTOR_H_
 #define OBSDATAVECTOR_H_
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <ostream>
@@ -180,9 +181,8 @@ ObsDataVector<DATATYPE> & ObsDataVector<DATATYPE>::operator= (const ObsDataVecto
 template <typename DATATYPE>
 void ObsDataVector<DATATYPE>::zero() {
   for (size_t jv = 0; jv < nvars_; ++jv) {
-    for (size_t jj = 0; jj < nlocs_; ++jj) {
-      rows_.at(jv).at(jj) = static_cast<DATATYPE>(0);
-    }
+    ASSERT(rows_.at(jv).size() >= nlocs_);
+    std::fill_n(rows_[jv].begin(), nlocs_, static_cast<DATATYPE>(0));
   }
 }
 // -----------------------------------------------------------------------------
@@ -191,8 +191,11 @@ void ObsDataVector<DATATYPE>::mask(const ObsDataVector<int> & flags) {
   ASSERT(nvars_ == flags.nvars());
   ASSERT(nlocs_ == flags.nlocs());
   for (size_t jv = 0; jv < nvars_; ++jv) {
+    ObsDataRow<DATATYPE> & row = rows_.at(jv);
+    const ObsDataRow<int> & flagRow = flags[jv];
+    ASSERT(row.size() >= nlocs_ && flagRow.size() >= nlocs_);
     for (size_t jj = 0; jj < nlocs_; ++jj) {
-      if (flags[jv][jj] > 0) rows_.at(jv).at(jj) = missing_;
+      if (flagRow[jj] > 0) row[jj] = missing_;
     }
   }
 }
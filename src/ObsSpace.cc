@@ -9,13 +9,20 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <cstdlib>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -65,6 +72,223 @@ bool extractChannelSuffixIfPresent(const std::string &name,
     return false;
 }
 
+// Create a memory selection of column \p offset of a row-major buffer holding \p numRows
+// rows of \p stride elements.
+Selection createStridedSelection(const std::size_t numRows, const std::size_t offset,
+                                 const std::size_t stride) {
+    const Dimensions_t rows = static_cast<Dimensions_t>(numRows);
+    const Dimensions_t cols = static_cast<Dimensions_t>(stride);
+    return Selection().extent({rows, cols})
+        .select({SelectionOperator::SET, {0, static_cast<Dimensions_t>(offset)}, {rows, 1}});
+}
+
+// Create a selection of \p count consecutive elements, starting at element \p start, of a
+// one-dimensional variable or buffer holding \p size elements.
+Selection createRangeSelection(const std::size_t size, const std::size_t start,
+                               const std::size_t count) {
+    return Selection().extent({static_cast<Dimensions_t>(size)})
+        .select({SelectionOperator::SET, {static_cast<Dimensions_t>(start)},
+                 {static_cast<Dimensions_t>(count)}});
+}
+
+template <typename T>
+void checkStridedSpan(const StridedSpan<T> & vdata, const std::size_t numElements,
+                      const std::string & varName) {
+    if ((vdata.stride == 0) || (vdata.offset >= vdata.stride) ||
+        (vdata.buffer.size() % vdata.stride != 0) || (vdata.size() != numElements)) {
+        throw eckit::BadParameter("Strided view does not match the " +
+            std::to_string(numElements) + " selected elements of variable " + varName, Here());
+    }
+}
+
+// Call \p func(begin, end) on contiguous blocks that together cover [0, \p n), running the
+// blocks on up to \p numThreads threads. Exceptions thrown by \p func are rethrown on the
+// calling thread once all blocks have finished.
+template <typename Func>
+void parallelForBlocks(const std::size_t n, const int numThreads, const Func & func) {
+    const std::size_t numBlocks =
+        std::min(n, static_cast<std::size_t>(std::max(numThreads, 1)));
+    if (numBlocks <= 1) {
+        func(0, n);
+        return;
+    }
+    const std::size_t blockSize = n / numBlocks;
+    const std::size_t remainder = n % numBlocks;
+    std::vector<std::exception_ptr> errors(numBlocks);
+    auto runBlock = [&](const std::size_t iblock) {
+        const std::size_t begin = iblock * blockSize + std::min(iblock, remainder);
+        const std::size_t end = begin + blockSize + (iblock < remainder ? 1 : 0);
+        try {
+            func(begin, end);
+        } catch (...) {
+            errors[iblock] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(numBlocks - 1);
+    for (std::size_t iblock = 1; iblock < numBlocks; ++iblock) {
+        threads.emplace_back(runBlock, iblock);
+    }
+    runBlock(0);
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    for (const auto & error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+// Worker threads that run batches of independent tasks. The threads are started once and
+// reused for every batch, and each thread takes the next task as soon as it is free, so
+// tasks of very different cost still keep all threads busy. The thread calling run() works
+// on the batch too, so a pool of \p numThreads threads starts numThreads - 1 of its own.
+class TaskPool {
+ public:
+    explicit TaskPool(const int numThreads)
+        : tasks_(nullptr), nextTask_(0), numRunning_(0), stop_(false) {
+        for (int i = 1; i < numThreads; ++i) {
+            threads_.emplace_back([this]() { work(); });
+        }
+    }
+
+    ~TaskPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        tasksReady_.notify_all();
+        for (auto & thread : threads_) {
+            thread.join();
+        }
+    }
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool & operator=(const TaskPool &) = delete;
+
+    // Run all of \p tasks and wait for them to finish. The first exception thrown by a task
+    // is rethrown here once the others have finished.
+    void run(const std::vector<std::function<void()>> & tasks) {
+        if (threads_.empty()) {
+            for (const auto & task : tasks) task();
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        tasks_ = &tasks;
+        nextTask_ = 0;
+        error_ = nullptr;
+        tasksReady_.notify_all();
+        runTasks(lock);
+        tasksDone_.wait(lock, [this]() { return numRunning_ == 0; });
+        tasks_ = nullptr;
+        if (error_) std::rethrow_exception(error_);
+    }
+
+ private:
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            tasksReady_.wait(lock, [this]() {
+                return stop_ || (tasks_ != nullptr && nextTask_ < tasks_->size());
+            });
+            if (stop_) return;
+            runTasks(lock);
+        }
+    }
+
+    // Take tasks from the current batch until none are left. Called with \p lock held.
+    void runTasks(std::unique_lock<std::mutex> & lock) {
+        while (nextTask_ < tasks_->size()) {
+            const std::function<void()> & task = (*tasks_)[nextTask_++];
+            ++numRunning_;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                task();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !error_) error_ = error;
+            if (--numRunning_ == 0 && nextTask_ == tasks_->size()) tasksDone_.notify_all();
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable tasksReady_;
+    std::condition_variable tasksDone_;
+    const std::vector<std::function<void()>> * tasks_;
+    std::size_t nextTask_;
+    std::size_t numRunning_;
+    std::exception_ptr error_;
+    bool stop_;
+};
+
+// Sort the locations within each record of a compressed record index (\p offsets and
+// \p locs) by the values of \p keys, using up to \p numThreads threads. Locations with
+// equal keys stay in their original order. \p keyMissing flags the locations whose sort
+// value is missing, which are handled according to \p missingSortValueTreatment.
+template <typename KeyType>
+void sortRecordSegments(const std::vector<std::size_t> & offsets,
+                        std::vector<std::size_t> & locs,
+                        const std::vector<KeyType> & keys,
+                        const std::vector<char> & keyMissing,
+                        const MissingSortValueTreatment missingSortValueTreatment,
+                        const bool ascending, const int numThreads) {
+    typedef std::pair<KeyType, std::size_t> KeyLoc;
+    const bool ignoreMissing =
+        (missingSortValueTreatment == MissingSortValueTreatment::IGNORE_MISSING);
+
+    // Break ties on the location index so that std::sort gives the same result as a
+    // stable sort in both directions.
+    auto keyLocLess = [](const KeyLoc & p1, const KeyLoc & p2) {
+        return (p1.first < p2.first || (!(p2.first < p1.first) && p1.second < p2.second));
+    };
+    auto keyLocGreater = [](const KeyLoc & p1, const KeyLoc & p2) {
+        return (p2.first < p1.first || (!(p1.first < p2.first) && p1.second < p2.second));
+    };
+
+    // (key, location) pairs laid out like locs. Each record sorts its own segment, so no
+    // memory is allocated per record.
+    std::vector<KeyLoc> keyLocs(locs.size());
+    const std::size_t numRecs = offsets.empty() ? 0 : offsets.size() - 1;
+    parallelForBlocks(numRecs, numThreads,
+                      [&](const std::size_t recBegin, const std::size_t recEnd) {
+        for (std::size_t irec = recBegin; irec < recEnd; ++irec) {
+            const std::size_t begin = offsets[irec];
+            const std::size_t end = offsets[irec + 1];
+            bool anyMissing = false;
+            std::size_t numToSort = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::size_t iloc = locs[i];
+                if (keyMissing[iloc]) {
+                    anyMissing = true;
+                    if (ignoreMissing) continue;
+                }
+                keyLocs[begin + numToSort++] = KeyLoc(keys[iloc], iloc);
+            }
+            // Records containing a missing sort value are left unsorted on request.
+            if (anyMissing && missingSortValueTreatment == MissingSortValueTreatment::NO_SORT)
+                continue;
+
+            const auto first = keyLocs.begin() + begin;
+            const auto last = first + numToSort;
+            if (ascending) {
+                std::sort(first, last, keyLocLess);
+            } else {
+                std::sort(first, last, keyLocGreater);
+            }
+
+            // Write the sorted locations back. When missing sort values are ignored, the
+            // locations holding them keep their slots.
+            auto sorted = first;
+            for (std::size_t i = begin; i < end; ++i) {
+                if (!(ignoreMissing && keyMissing[locs[i]])) locs[i] = (sorted++)->second;
+            }
+        }
+    });
+}
+
 }  // namespace
 
 // ----------------------------- public functions ------------------------------
@@ -121,7 +345,8 @@ ObsSpace::ObsSpace(const Parameters_ & params, const eckit::mpi::Comm & comm,
                      : oops::ObsSpaceBase(params, comm, bgn, end),
                        winbgn_(bgn), winend_(end), commMPI_(comm),
                        gnlocs_(0), nrecs_(0), obsvars_(),
-                       obs_group_(), obs_params_(params, bgn, end, comm, timeComm)
+                       obs_group_(), obs_params_(params, bgn, end, comm, timeComm),
+                       var_handles_version_(0)
 {
     // Determine if run stats should be dumped out from the environment variable
     // IODA_PRINT_RUNSTATS.
@@ -284,12 +509,12 @@ void ObsSpace::save() {
           Group writerGroup = ioda::Engines::ODC::createFile(odcparams, obs_group_);
         } else {
           // Write the output file
-          std::vector<bool> patchObsVec(nlocs());
-          dist_->patchObs(patchObsVec);
+          std::vector<std::pair<std::size_t, std::size_t>> patchObsRuns;
+          dist_->patchObsRuns(nlocs(), patchObsRuns);
           WriterPool obsPool(obs_params_.top_level_.ioPool,
               obs_params_.top_level_.obsDataOut.value()->engine.value().engineParameters,
               obs_params_.comm(), obs_params_.timeComm() ,
-              obs_params_.windowStart(), obs_params_.windowEnd(), patchObsVec);
+              obs_params_.windowStart(), obs_params_.windowEnd(), nlocs(), patchObsRuns);
           obsPool.save(obs_group_);
           // Wait for all processes to finish the save call so that we know the file
           // is complete and closed.
@@ -366,8 +591,8 @@ bool ObsSpace::has(const std::string & group, const std::string & name, bool ski
     std::string nameToUse;
     std::vector<int> chanSelectToUse;
     splitChanSuffix(group, name, { }, nameToUse, chanSelectToUse, skipDerived);
-    return obs_group_.vars.exists(fullVarName(group, nameToUse)) ||
-           (!skipDerived && obs_group_.vars.exists(fullVarName("Derived" + group, nameToUse)));
+    return findVar(fullVarName(group, nameToUse)) != nullptr ||
+           (!skipDerived && findVar(fullVarName("Derived" + group, nameToUse)) != nullptr);
 }
 
 // -----------------------------------------------------------------------------
@@ -380,14 +605,15 @@ ObsDtype ObsSpace::dtype(const std::string & group, const std::string & name,
     splitChanSuffix(group, name, { }, nameToUse, chanSelectToUse, skipDerived);
 
     std::string groupToUse = "Derived" + group;
-    if (skipDerived || !obs_group_.vars.exists(fullVarName(groupToUse, nameToUse)))
+    if (skipDerived || findVar(fullVarName(groupToUse, nameToUse)) == nullptr)
       groupToUse = group;
 
     // Set the type to None if there is no type from the backend
     ObsDtype VarType = ObsDtype::None;
     if (has(groupToUse, nameToUse, skipDerived)) {
         const std::string varNameToUse = fullVarName(groupToUse, nameToUse);
-        Variable var = obs_group_.vars.open(varNameToUse);
+        const Variable * cachedVar = findVar(varNameToUse);
+        Variable var = cachedVar ? *cachedVar : obs_group_.vars.open(varNameToUse);
         VarUtils::switchOnSupportedVariableType(
               var,
               [&] (int)   {
@@ -482,43 +708,158 @@ void ObsSpace::get_db(const std::string & group, const std::string & name,
     vdata.assign(charData.begin(), charData.end());
 }
 
+void ObsSpace::get_db(const std::string & group, const std::string & name,
+                      gsl::span<int> vdata,
+                      const std::vector<int> & chanSelect, bool skipDerived) const {
+    loadVar<int>(group, name, chanSelect, vdata, skipDerived);
+}
+
+void ObsSpace::get_db(const std::string & group, const std::string & name,
+                      gsl::span<int64_t> vdata,
+                      const std::vector<int> & chanSelect, bool skipDerived) const {
+    loadVar<int64_t>(group, name, chanSelect, vdata, skipDerived);
+}
+
+void ObsSpace::get_db(const std::string & group, const std::string & name,
+                      gsl::span<float> vdata,
+                      const std::vector<int> & chanSelect, bool skipDerived) const {
+    loadVar<float>(group, name, chanSelect, vdata, skipDerived);
+}
+
+void ObsSpace::get_db(const std::string & group, const std::string & name,
+                      gsl::span<double> vdata,
+                      const std::vector<int> & chanSelect, bool skipDerived) const {
+    // load the float values from the database and convert to double
+    std::vector<float> floatData(vdata.size());
+    const std::size_t numElements =
+        loadVar<float>(group, name, chanSelect, gsl::make_span(floatData), skipDerived);
+    ConvertVarType<float, double>(gsl::make_span(floatData.data(), numElements), vdata);
+}
+
+void ObsSpace::get_db(const std::string & group, const std::string & name,
+                      gsl::span<util::DateTime> vdata,
+                      const std::vector<int> & chanSelect, bool skipDerived) const {
+    std::vector<int64_t> timeOffsets(vdata.size());
+    const std::size_t numElements =
+        loadVar<int64_t>(group, name, chanSelect, gsl::make_span(timeOffsets), skipDerived);
+    Variable dtVar = obs_group_.vars.open(group + std::string("/") + name);
+    util::DateTime epochDt = getEpochAsDtime(dtVar);
+    convertEpochDtToDtime(epochDt, gsl::make_span(timeOffsets.data(), numElements), vdata);
+}
+
+void ObsSpace::get_db(const std::string & group, const std::string & name,
+                      gsl::span<bool> vdata,
+                      const std::vector<int> & chanSelect, bool skipDerived) const {
+    // See the vector version for why the values are loaded as bytes.
+    std::vector<char> charData(vdata.size());
+    const std::size_t numElements =
+        loadVar<char>(group, name, chanSelect, gsl::make_span(charData), skipDerived);
+    std::copy(charData.begin(), charData.begin() + numElements, vdata.begin());
+}
+
+void ObsSpace::get_db(const std::string & group, const std::string & name, int channel,
+                      StridedSpan<int> vdata, bool skipDerived) const {
+    loadVar<int>(group, name, channel, vdata, skipDerived);
+}
+
+void ObsSpace::get_db(const std::string & group, const std::string & name, int channel,
+                      StridedSpan<float> vdata, bool skipDerived) const {
+    loadVar<float>(group, name, channel, vdata, skipDerived);
+}
+
+void ObsSpace::get_db(const std::string & group, const std::string & name, int channel,
+                      StridedSpan<double> vdata, bool skipDerived) const {
+    // Load the channel as contiguous floats and convert while scattering into the column.
+    std::vector<float> floatData(vdata.size());
+    const std::size_t numElements =
+        loadVar<float>(group, name, {channel}, gsl::make_span(floatData), skipDerived);
+    checkStridedSpan(vdata, numElements, fullVarName(group, name));
+    const float missingFloat = util::missingValue(missingFloat);
+    const double missingDouble = util::missingValue(missingDouble);
+    for (std::size_t i = 0; i < numElements; ++i) {
+        vdata[i] = (floatData[i] == missingFloat) ? missingDouble
+                                                  : static_cast<double>(floatData[i]);
+    }
+}
+
 // -----------------------------------------------------------------------------
 void ObsSpace::put_db(const std::string & group, const std::string & name,
                      const std::vector<int> & vdata,
                      const std::vector<std::string> & dimList) {
-    saveVar(group, name, vdata, dimList);
+    saveVar<int>(group, name, gsl::make_span(vdata), dimList);
 }
 
 void ObsSpace::put_db(const std::string & group, const std::string & name,
                      const std::vector<int64_t> & vdata,
                      const std::vector<std::string> & dimList) {
-    saveVar(group, name, vdata, dimList);
+    saveVar<int64_t>(group, name, gsl::make_span(vdata), dimList);
 }
 
 void ObsSpace::put_db(const std::string & group, const std::string & name,
                      const std::vector<float> & vdata,
                      const std::vector<std::string> & dimList) {
-    saveVar(group, name, vdata, dimList);
+    saveVar<float>(group, name, gsl::make_span(vdata), dimList);
 }
 
 void ObsSpace::put_db(const std::string & group, const std::string & name,
                      const std::vector<double> & vdata,
                      const std::vector<std::string> & dimList) {
-    // convert to float, then save to the database
-    std::vector<float> floatData;
-    ConvertVarType<double, float>(vdata, floatData);
-    saveVar(group, name, floatData, dimList);
+    put_db(group, name, gsl::make_span(vdata), dimList);
 }
 
 void ObsSpace::put_db(const std::string & group, const std::string & name,
                      const std::vector<std::string> & vdata,
                      const std::vector<std::string> & dimList) {
-    saveVar(group, name, vdata, dimList);
+    saveVar<std::string>(group, name, gsl::make_span(vdata), dimList);
 }
 
 void ObsSpace::put_db(const std::string & group, const std::string & name,
                      const std::vector<util::DateTime> & vdata,
                      const std::vector<std::string> & dimList) {
+    put_db(group, name, gsl::make_span(vdata), dimList);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name,
+                      const std::vector<bool> & vdata,
+                      const std::vector<std::string> & dimList) {
+    // Boolean variables are currently stored internally as arrays of bytes (with each byte
+    // holding one element of the variable).
+    // TODO(wsmigaj): Store them as arrays of bits instead, at least in the ObsStore backend,
+    // to reduce memory consumption and speed up the get_db and put_db functions.
+    std::vector<char> boolsAsBytes(vdata.begin(), vdata.end());
+    saveVar<char>(group, name, gsl::make_span(boolsAsBytes), dimList);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name,
+                      gsl::span<const int> vdata,
+                      const std::vector<std::string> & dimList) {
+    saveVar<int>(group, name, vdata, dimList);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name,
+                      gsl::span<const int64_t> vdata,
+                      const std::vector<std::string> & dimList) {
+    saveVar<int64_t>(group, name, vdata, dimList);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name,
+                      gsl::span<const float> vdata,
+                      const std::vector<std::string> & dimList) {
+    saveVar<float>(group, name, vdata, dimList);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name,
+                      gsl::span<const double> vdata,
+                      const std::vector<std::string> & dimList) {
+    // convert to float, then save to the database
+    std::vector<float> floatData(vdata.size());
+    ConvertVarType<double, float>(vdata, gsl::make_span(floatData));
+    saveVar<float>(group, name, gsl::make_span(floatData), dimList);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name,
+                      gsl::span<const util::DateTime> vdata,
+                      const std::vector<std::string> & dimList) {
     // Make sure the variable exists before calling saveVar. Doing it this way instead
     // of through the openCreateVar call in saveVar because of the need to get the
     // epoch value for converting the data before calling saveVar. Use the epoch DateTime
@@ -527,68 +868,98 @@ void ObsSpace::put_db(const std::string & group, const std::string & name,
     openCreateEpochDtimeVar(group, name, obs_params_.top_level_.epochDateTime,
                             dtVar, obs_group_.vars);
     util::DateTime epochDtime = getEpochAsDtime(dtVar);
-    std::vector<int64_t> timeOffsets = convertDtimeToTimeOffsets(epochDtime, vdata);
-    saveVar(group, name, timeOffsets, dimList);
+    std::vector<int64_t> timeOffsets(vdata.size());
+    convertDtimeToTimeOffsets(epochDtime, vdata, gsl::make_span(timeOffsets));
+    saveVar<int64_t>(group, name, gsl::make_span(timeOffsets), dimList);
 }
 
 void ObsSpace::put_db(const std::string & group, const std::string & name,
-                      const std::vector<bool> & vdata,
+                      gsl::span<const bool> vdata,
                       const std::vector<std::string> & dimList) {
-    // Boolean variables are currently stored internally as arrays of bytes (with each byte
-    // holding one element of the variable).
-    // TODO(wsmigaj): Store them as arrays of bits instead, at least in the ObsStore backend,
-    // to reduce memory consumption and speed up the get_db and put_db functions.
+    // See the vector version for why the values are stored as bytes.
     std::vector<char> boolsAsBytes(vdata.begin(), vdata.end());
-    saveVar(group, name, boolsAsBytes, dimList);
+    saveVar<char>(group, name, gsl::make_span(boolsAsBytes), dimList);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name, int channel,
+                      StridedSpan<const int> vdata) {
+    saveVar<int>(group, name, channel, vdata);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name, int channel,
+                      StridedSpan<const float> vdata) {
+    saveVar<float>(group, name, channel, vdata);
+}
+
+void ObsSpace::put_db(const std::string & group, const std::string & name, int channel,
+                      StridedSpan<const double> vdata) {
+    // Gather the column into contiguous floats, then save to the database.
+    checkStridedSpan(vdata, vdata.size(), fullVarName(group, name));
+    const float missingFloat = util::missingValue(missingFloat);
+    const double missingDouble = util::missingValue(missingDouble);
+    std::vector<float> floatData(vdata.size());
+    for (std::size_t i = 0; i < floatData.size(); ++i) {
+        floatData[i] = (vdata[i] == missingDouble) ? missingFloat
+                                                   : static_cast<float>(vdata[i]);
+    }
+    saveVar<float>(group, name, channel,
+        StridedSpan<const float>(gsl::make_span(floatData), 0, 1));
 }
 
 // -----------------------------------------------------------------------------
 const ObsSpace::RecIdxIter ObsSpace::recidx_begin() const {
-  return recidx_.begin();
+  return recidx_recnums_.begin();
 }
 
 // -----------------------------------------------------------------------------
 const ObsSpace::RecIdxIter ObsSpace::recidx_end() const {
-  return recidx_.end();
+  return recidx_recnums_.end();
 }
 
 // -----------------------------------------------------------------------------
 bool ObsSpace::recidx_has(const std::size_t recNum) const {
-  RecIdxIter irec = recidx_.find(recNum);
-  return (irec != recidx_.end());
+  return (recidx_find(recNum) != recidx_recnums_.end());
 }
 
 // -----------------------------------------------------------------------------
 std::size_t ObsSpace::recidx_recnum(const RecIdxIter & irec) const {
-  return irec->first;
+  return *irec;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<std::size_t> ObsSpace::recidx_vector(const RecIdxIter & irec) const {
+  const gsl::span<const std::size_t> locs = recidx_span(irec);
+  return std::vector<std::size_t>(locs.begin(), locs.end());
 }
 
 // -----------------------------------------------------------------------------
-const std::vector<std::size_t> & ObsSpace::recidx_vector(const RecIdxIter & irec) const {
-  return irec->second;
+std::vector<std::size_t> ObsSpace::recidx_vector(const std::size_t recNum) const {
+  const gsl::span<const std::size_t> locs = recidx_span(recNum);
+  return std::vector<std::size_t>(locs.begin(), locs.end());
 }
 
 // -----------------------------------------------------------------------------
-const std::vector<std::size_t> & ObsSpace::recidx_vector(const std::size_t recNum) const {
-  RecIdxIter Irec = recidx_.find(recNum);
-  if (Irec == recidx_.end()) {
+gsl::span<const std::size_t> ObsSpace::recidx_span(const RecIdxIter & irec) const {
+  const std::size_t irecPos = irec - recidx_recnums_.begin();
+  const std::size_t start = recidx_offsets_[irecPos];
+  return gsl::make_span(recidx_locs_.data() + start, recidx_offsets_[irecPos + 1] - start);
+}
+
+// -----------------------------------------------------------------------------
+gsl::span<const std::size_t> ObsSpace::recidx_span(const std::size_t recNum) const {
+  RecIdxIter Irec = recidx_find(recNum);
+  if (Irec == recidx_recnums_.end()) {
     std::string ErrMsg =
       "ObsSpace::recidx_vector: Record number, " + std::to_string(recNum) +
       ", does not exist in record index map.";
     ABORT(ErrMsg);
   }
-  return Irec->second;
+  return recidx_span(Irec);
 }
 
 // -----------------------------------------------------------------------------
 std::vector<std::size_t> ObsSpace::recidx_all_recnums() const {
-  std::vector<std::size_t> RecNums(nrecs_);
-  std::size_t recnum = 0;
-  for (RecIdxIter Irec = recidx_.begin(); Irec != recidx_.end(); ++Irec) {
-    RecNums[recnum] = Irec->first;
-    recnum++;
-  }
-  return RecNums;
+  return recidx_recnums_;
 }
 
 // ----------------------------- private functions -----------------------------
@@ -659,6 +1030,8 @@ void ObsSpace::createObsGroupFromObsFrame(ObsFrameRead & obsFrame) {
 
     // Create the ObsGroup and attach the backend.
     obs_group_ = ObsGroup::generate(backend, newDims);
+    var_handles_.clear();
+    var_handles_version_ = obs_group_.vars.structureVersion();
 
     // fill in dimension coordinate values
     for (auto & dimNameObject : obsFrame.backendDimVarList()) {
@@ -700,51 +1073,48 @@ void ObsSpace::createObsGroupFromObsFrame(ObsFrameRead & obsFrame) {
 // -----------------------------------------------------------------------------
 template<typename VarType>
 bool ObsSpace::readObsSource(ObsFrameRead & obsFrame,
-                            const std::string & varName, std::vector<VarType> & varValues) {
+                            const std::string & varName, std::vector<VarType> & varValues,
+                            bool & hasSourceFillValue, VarType & sourceFillValue) {
     Variable sourceVar = obsFrame.getObsGroup().vars.open(varName);
 
     // Read the variable
     bool gotVarData = obsFrame.readFrameVar(varName, varValues);
 
-    // Replace source fill values with corresponding missing marks
-    if ((gotVarData) && (sourceVar.hasFillValue())) {
-        VarType sourceFillValue;
+    // Record the source fill value so that it can be replaced by the missing marks
+    hasSourceFillValue = gotVarData && sourceVar.hasFillValue();
+    if (hasSourceFillValue) {
         detail::FillValueData_t sourceFvData = sourceVar.getFillValue();
         sourceFillValue = detail::getFillValue<VarType>(sourceFvData);
-        VarType varFillValue = this->getFillValue<VarType>();
-        for (std::size_t i = 0; i < varValues.size(); ++i) {
-            if ((varValues[i] == sourceFillValue) || std::isinf(varValues[i])
-                                                  || std::isnan(varValues[i])) {
-                varValues[i] = varFillValue;
-            }
-        }
     }
     return gotVarData;
 }
 
-template<>
-bool ObsSpace::readObsSource(ObsFrameRead & obsFrame,
-                            const std::string & varName, std::vector<std::string> & varValues) {
-    Variable sourceVar = obsFrame.getObsGroup().vars.open(varName);
+namespace {
 
-    // Read the variable
-    bool gotVarData = obsFrame.readFrameVar(varName, varValues);
+// Replace source fill values with corresponding missing marks
+template<typename VarType>
+void replaceSourceFillValues(std::vector<VarType> & varValues, const VarType sourceFillValue,
+                             const VarType varFillValue) {
+    for (std::size_t i = 0; i < varValues.size(); ++i) {
+        if ((varValues[i] == sourceFillValue) || std::isinf(varValues[i])
+                                              || std::isnan(varValues[i])) {
+            varValues[i] = varFillValue;
+        }
+    }
+}
 
-    // Replace source fill values with corresponding missing marks
-    if ((gotVarData) && (sourceVar.hasFillValue())) {
-        std::string sourceFillValue;
-        detail::FillValueData_t sourceFvData = sourceVar.getFillValue();
-        sourceFillValue = detail::getFillValue<std::string>(sourceFvData);
-        std::string varFillValue = this->getFillValue<std::string>();
-        for (std::size_t i = 0; i < varValues.size(); ++i) {
-            if (varValues[i] == sourceFillValue) {
-                varValues[i] = varFillValue;
-            }
+void replaceSourceFillValues(std::vector<std::string> & varValues,
+                             const std::string & sourceFillValue,
+                             const std::string & varFillValue) {
+    for (std::size_t i = 0; i < varValues.size(); ++i) {
+        if (varValues[i] == sourceFillValue) {
+            varValues[i] = varFillValue;
         }
     }
-    return gotVarData;
 }
 
+}  // namespace
+
 // -----------------------------------------------------------------------------
 void ObsSpace::initFromObsSource(ObsFrameRead & obsFrame) {
     // Walk through the frames and copy the data to the obs_group_ storage
@@ -756,6 +1126,19 @@ void ObsSpace::initFromObsSource(ObsFrameRead & obsFrame) {
     obsFrame.frameInit(obs_group_.atts);
     dims_attached_to_vars_ = obsFrame.varDimMap();
     createVariables(obsFrame.getObsGroup().vars, obs_group_.vars, dims_attached_to_vars_);
+    // Allocate the storage for the locations expected on this rank once, instead of
+    // growing it with every frame.
+    reserveLocation(obsFrame.locationCapacityHint());
+
+    // With more than one transfer thread, the variables of a frame are read from the obs
+    // source on this thread, while the fill value replacement and the write into obs_group_
+    // of each variable are queued up and run concurrently at the end of the frame. Each
+    // queued transfer writes a different variable, which the ObsStore backend allows while
+    // no variable is created or resized, and the shared state (variable handles, selection
+    // caches) is only touched on this thread.
+    const int transferThreads = obs_params_.top_level_.obsDataIn.value().transferThreads;
+    TaskPool transferPool(transferThreads);
+    std::vector<std::function<void()>> frameTransfers;
     for ( ; obsFrame.frameAvailable(); obsFrame.frameNext()) {
         Dimensions_t frameStart = obsFrame.frameStart();
 
@@ -773,6 +1156,7 @@ void ObsSpace::initFromObsSource(ObsFrameRead & obsFrame) {
         // (variable MetaData/dateTime) so the string datetime variable can be omitted
         // from the ObsSpace container. Same for the offset datetime representation
         // (variable MetaData/time)
+        frameTransfers.clear();
         for (auto & varNameObject : obsFrame.varList()) {
             std::string varName = varNameObject.name;
             if ((varName == "MetaData/datetime") || (varName == "MetaData/time")) {
@@ -792,16 +1176,45 @@ void ObsSpace::initFromObsSource(ObsFrameRead & obsFrame) {
                   var,
                   [&](auto typeDiscriminator) {
                       typedef decltype(typeDiscriminator) T;
-                      std::vector<T> varValues;
-                      if (readObsSource<T>(obsFrame, varName, varValues)) {
-                          storeVar<T>(varName, varValues, beFrameStart, frameCount);
+                      auto varValues = std::make_shared<std::vector<T>>();
+                      bool hasSourceFillValue;
+                      T sourceFillValue{};
+                      if (!readObsSource<T>(obsFrame, varName, *varValues,
+                                            hasSourceFillValue, sourceFillValue)) {
+                          return;
+                      }
+                      Variable destVar = obs_group_.vars.open(varName);
+                      Selection feSelect;
+                      Selection beSelect;
+                      storeSelections(varName, destVar, beFrameStart, frameCount,
+                                      feSelect, beSelect);
+                      const T varFillValue = this->getFillValue<T>();
+                      auto transfer = [varValues, hasSourceFillValue, sourceFillValue,
+                                       varFillValue, destVar, feSelect, beSelect]() mutable {
+                          if (hasSourceFillValue) {
+                              replaceSourceFillValues(*varValues, sourceFillValue,
+                                                      varFillValue);
+                          }
+                          destVar.write<T>(*varValues, feSelect, beSelect);
+                      };
+                      if (transferThreads > 1) {
+                          frameTransfers.push_back(transfer);
+                      } else {
+                          transfer();
                       }
                   },
                   VarUtils::ThrowIfVariableIsOfUnsupportedType(varName));
         }
+
+        // Run the queued transfers
+        transferPool.run(frameTransfers);
         iframe++;
     }
 
+    // The capacity hint is an estimate and the storage grows geometrically past it, so
+    // give back what the variables did not fill. This costs nothing when the hint was exact.
+    obs_group_.shrinkToFit();
+
     // Record locations and channels dimension sizes
     // The HDF library has an issue when a dimension marked UNLIMITED is queried for its
     // size a zero is returned instead of the proper current size. As a workaround for this
@@ -837,12 +1250,18 @@ void ObsSpace::resizeLocation(const Dimensions_t LocationSize, const bool append
 }
 
 // -----------------------------------------------------------------------------
+void ObsSpace::reserveLocation(const Dimensions_t LocationCapacity) {
+    Variable LocationVar = obs_group_.vars.open(dim_info_.get_dim_name(ObsDimensionId::Location));
+    obs_group_.reserve(
+        { std::pair<Variable, Dimensions_t>(LocationVar, LocationCapacity) });
+}
 
-template<typename VarType>
-void ObsSpace::loadVar(const std::string & group, const std::string & name,
-                       const std::vector<int> & chanSelect,
-                       std::vector<VarType> & varValues,
-                       bool skipDerived) const {
+// -----------------------------------------------------------------------------
+
+Variable ObsSpace::openLoadVar(const std::string & group, const std::string & name,
+                               const std::vector<int> & chanSelect, bool skipDerived,
+                               Selection & memSelect, Selection & obsGroupSelect,
+                               std::size_t & numElements) const {
     // For backward compatibility, recognize and handle appropriately variable names with
     // channel suffixes.
     std::string nameToUse;
@@ -851,50 +1270,98 @@ void ObsSpace::loadVar(const std::string & group, const std::string & name,
 
     // Prefer variables from Derived* groups.
     std::string groupToUse = "Derived" + group;
-    if (skipDerived || !obs_group_.vars.exists(fullVarName(groupToUse, nameToUse)))
+    if (skipDerived || findVar(fullVarName(groupToUse, nameToUse)) == nullptr)
       groupToUse = group;
 
     // Try to open the variable.
-    ioda::Variable var = obs_group_.vars.open(fullVarName(groupToUse, nameToUse));
+    const std::string varNameToUse = fullVarName(groupToUse, nameToUse);
+    const Variable * cachedVar = findVar(varNameToUse);
+    ioda::Variable var = cachedVar ? *cachedVar : obs_group_.vars.open(varNameToUse);
 
     std::string ChannelVarName = this->get_dim_name(ObsDimensionId::Channel);
 
     // In the following code, assume that if a variable has channels, the
     // Channel dimension will be the second dimension.
-    if (obs_group_.vars.exists(ChannelVarName)) {
-        Variable ChannelVar = obs_group_.vars.open(ChannelVarName);
-        if (var.getDimensions().dimensionality > 1) {
-            if (var.isDimensionScaleAttached(1, ChannelVar) && (chanSelectToUse.size() > 0)) {
-                // This variable has Channel as the second dimension, and channel
-                // selection has been specified. Build selection objects based on the
-                // channel numbers. For now, select all locations (first dimension).
-                const std::size_t ChannelDimIndex = 1;
-                Selection memSelect;
-                Selection obsGroupSelect;
-                const std::size_t numElements = createChannelSelections(
-                      var, ChannelDimIndex, chanSelectToUse, memSelect, obsGroupSelect);
-
-                var.read<VarType>(varValues, memSelect, obsGroupSelect);
-                varValues.resize(numElements);
-            } else {
-              // Not a radiance variable, just read in the whole variable
-              var.read<VarType>(varValues);
-            }
-        } else {
-            // Not a radiance variable, just read in the whole variable
-            var.read<VarType>(varValues);
+    const Variable * cachedChannelVar = findVar(ChannelVarName);
+    if ((cachedChannelVar != nullptr) && (chanSelectToUse.size() > 0)) {
+        const Variable & ChannelVar = *cachedChannelVar;
+        if ((var.getDimensions().dimensionality > 1) &&
+            var.isDimensionScaleAttached(1, ChannelVar)) {
+            // This variable has Channel as the second dimension, and channel
+            // selection has been specified. Build selection objects based on the
+            // channel numbers. For now, select all locations (first dimension).
+            const std::size_t ChannelDimIndex = 1;
+            numElements = createChannelSelections(
+                  var, ChannelDimIndex, chanSelectToUse, memSelect, obsGroupSelect);
+            return var;
         }
-    } else {
-        // Not a radiance variable, just read in the whole variable
-        var.read<VarType>(varValues);
     }
+
+    // Not a radiance variable, just read in the whole variable
+    memSelect = Selection::all;
+    obsGroupSelect = Selection::all;
+    numElements = var.getDimensions().numElements;
+    return var;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename VarType>
+void ObsSpace::loadVar(const std::string & group, const std::string & name,
+                       const std::vector<int> & chanSelect,
+                       std::vector<VarType> & varValues,
+                       bool skipDerived) const {
+    Selection memSelect;
+    Selection obsGroupSelect;
+    std::size_t numElements;
+    Variable var = openLoadVar(group, name, chanSelect, skipDerived,
+                               memSelect, obsGroupSelect, numElements);
+    varValues.resize(numElements);
+    var.read<VarType>(gsl::make_span(varValues), memSelect, obsGroupSelect);
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename VarType>
+std::size_t ObsSpace::loadVar(const std::string & group, const std::string & name,
+                              const std::vector<int> & chanSelect,
+                              gsl::span<VarType> varValues,
+                              bool skipDerived) const {
+    Selection memSelect;
+    Selection obsGroupSelect;
+    std::size_t numElements;
+    Variable var = openLoadVar(group, name, chanSelect, skipDerived,
+                               memSelect, obsGroupSelect, numElements);
+    if (varValues.size() < numElements) {
+        throw eckit::BadParameter("Buffer holding " + std::to_string(varValues.size()) +
+            " elements is too small for the " + std::to_string(numElements) +
+            " selected elements of variable " + fullVarName(group, name), Here());
+    }
+    var.read<VarType>(varValues.first(numElements), memSelect, obsGroupSelect);
+    return numElements;
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename VarType>
+void ObsSpace::loadVar(const std::string & group, const std::string & name, int channel,
+                       StridedSpan<VarType> varValues, bool skipDerived) const {
+    Selection memSelect;
+    Selection obsGroupSelect;
+    std::size_t numElements;
+    Variable var = openLoadVar(group, name, {channel}, skipDerived,
+                               memSelect, obsGroupSelect, numElements);
+    checkStridedSpan(varValues, numElements, fullVarName(group, name));
+    var.read<VarType>(varValues.buffer,
+                      createStridedSelection(numElements, varValues.offset, varValues.stride),
+                      obsGroupSelect);
 }
 
 // -----------------------------------------------------------------------------
 
 template<typename VarType>
 void ObsSpace::saveVar(const std::string & group, std::string name,
-                      const std::vector<VarType> & varValues,
+                      gsl::span<const VarType> varValues,
                       const std::vector<std::string> & dimList) {
     // For backward compatibility, recognize and handle appropriately variable names with
     // channel suffixes.
@@ -902,7 +1369,7 @@ void ObsSpace::saveVar(const std::string & group, std::string name,
     std::vector<int> channels;
 
     const std::string ChannelVarName = this->get_dim_name(ObsDimensionId::Channel);
-    if (group != "MetaData" && obs_group_.vars.exists(ChannelVarName)) {
+    if (group != "MetaData" && findVar(ChannelVarName) != nullptr) {
         // If the variable does not already exist and its name ends with an underscore followed by
         // a number, interpret the latter as a channel number selecting a slice of the "Channel"
         // dimension.
@@ -914,7 +1381,7 @@ void ObsSpace::saveVar(const std::string & group, std::string name,
     const std::string fullName = fullVarName(group, name);
 
     std::vector<std::string> dimListToUse = dimList;
-    if (!obs_group_.vars.exists(fullName) && !channels.empty()) {
+    if (findVar(fullName) == nullptr && !channels.empty()) {
         // Append "channels" to the dimensions list if not already present.
         const size_t ChannelDimIndex =
             std::find(dimListToUse.begin(), dimListToUse.end(), ChannelVarName) -
@@ -927,20 +1394,9 @@ void ObsSpace::saveVar(const std::string & group, std::string name,
     if (channels.empty()) {
         var.write<VarType>(varValues);
     } else {
-        // Find the index of the Channel dimension
-        Variable ChannelVar = obs_group_.vars.open(ChannelVarName);
-        std::vector<std::vector<Named_Variable>> dimScales =
-            var.getDimensionScaleMappings({Named_Variable(ChannelVarName, ChannelVar)});
-        size_t ChannelDimIndex = std::find_if(dimScales.begin(), dimScales.end(),
-                                             [](const std::vector<Named_Variable> &x)
-                                             { return !x.empty(); }) - dimScales.begin();
-        if (ChannelDimIndex == dimScales.size())
-            throw eckit::UserError("Variable " + fullName +
-                                   " is not indexed by channel numbers", Here());
-
         Selection memSelect;
         Selection obsGroupSelect;
-        createChannelSelections(var, ChannelDimIndex, channels,
+        createChannelSelections(var, channelDimIndex(var, fullName), channels,
                                 memSelect, obsGroupSelect);
         var.write<VarType>(varValues, memSelect, obsGroupSelect);
     }
@@ -948,6 +1404,47 @@ void ObsSpace::saveVar(const std::string & group, std::string name,
 
 // -----------------------------------------------------------------------------
 
+template<typename VarType>
+void ObsSpace::saveVar(const std::string & group, const std::string & name, int channel,
+                       StridedSpan<const VarType> varValues) {
+    const std::string ChannelVarName = this->get_dim_name(ObsDimensionId::Channel);
+    const std::string LocationVarName = this->get_dim_name(ObsDimensionId::Location);
+    const std::string fullName = fullVarName(group, name);
+    if (findVar(ChannelVarName) == nullptr) {
+        throw eckit::UserError("Cannot save a channel of variable " + fullName +
+                               " since the ObsSpace has no channels", Here());
+    }
+    Variable var = openCreateVar<VarType>(fullName, {LocationVarName, ChannelVarName});
+
+    Selection memSelect;
+    Selection obsGroupSelect;
+    const std::size_t numElements = createChannelSelections(
+        var, channelDimIndex(var, fullName), {channel}, memSelect, obsGroupSelect);
+    checkStridedSpan(varValues, numElements, fullName);
+    var.write<VarType>(varValues.buffer,
+                       createStridedSelection(numElements, varValues.offset, varValues.stride),
+                       obsGroupSelect);
+}
+
+// -----------------------------------------------------------------------------
+
+std::size_t ObsSpace::channelDimIndex(const Variable & var, const std::string & varName) const {
+    // Find the index of the Channel dimension
+    const std::string ChannelVarName = this->get_dim_name(ObsDimensionId::Channel);
+    Variable ChannelVar = obs_group_.vars.open(ChannelVarName);
+    std::vector<std::vector<Named_Variable>> dimScales =
+        var.getDimensionScaleMappings({Named_Variable(ChannelVarName, ChannelVar)});
+    size_t ChannelDimIndex = std::find_if(dimScales.begin(), dimScales.end(),
+                                         [](const std::vector<Named_Variable> &x)
+                                         { return !x.empty(); }) - dimScales.begin();
+    if (ChannelDimIndex == dimScales.size())
+        throw eckit::UserError("Variable " + varName +
+                               " is not indexed by channel numbers", Here());
+    return ChannelDimIndex;
+}
+
+// -----------------------------------------------------------------------------
+
 std::size_t ObsSpace::createChannelSelections(const Variable & variable,
                                              std::size_t ChannelDimIndex,
                                              const std::vector<int> & channels,
@@ -1021,11 +1518,10 @@ std::size_t ObsSpace::createChannelSelections(const Variable & variable,
 // What this means is that you can always transfer the data as a single contiguous
 // block which can be accomplished with a single hyperslab selection. There should
 // be no need to cache these selections because of this.
-template<typename VarType>
-void ObsSpace::storeVar(const std::string & varName, std::vector<VarType> & varValues,
-                       const Dimensions_t frameStart, const Dimensions_t frameCount) {
+void ObsSpace::storeSelections(const std::string & varName, const Variable & var,
+                               const Dimensions_t frameStart, const Dimensions_t frameCount,
+                               Selection & feSelect, Selection & beSelect) {
     // get the dimensions of the variable
-    Variable var = obs_group_.vars.open(varName);
     std::vector<Dimensions_t> varDims = var.getDimensions().dimsCur;
 
     // check the caches for the selectors
@@ -1057,10 +1553,12 @@ void ObsSpace::storeVar(const std::string & varName, std::vector<VarType> & varV
         known_be_selections_[dims] = Selection()
             .extent(varDims).select({ SelectionOperator::SET, beStarts, beCounts });
     }
-    Selection & feSelect = known_fe_selections_[dims];
-    Selection & beSelect = known_be_selections_[dims];
-
-    var.write<VarType>(varValues, feSelect, beSelect);
+    // Hand out copies without the concretized backend selections, so that transfers
+    // running concurrently do not share any selection state.
+    feSelect = known_fe_selections_[dims];
+    beSelect = known_be_selections_[dims];
+    feSelect.invalidate();
+    beSelect.invalidate();
 }
 
 // -----------------------------------------------------------------------------
@@ -1146,6 +1644,19 @@ void ObsSpace::fillChanNumToIndexMap() {
     }
 }
 
+// -----------------------------------------------------------------------------
+const Variable * ObsSpace::findVar(const std::string & varName) const {
+    const std::size_t version = obs_group_.vars.structureVersion();
+    if (version != var_handles_version_) {
+        var_handles_.clear();
+        var_handles_version_ = version;
+    }
+    auto ivar = var_handles_.find(varName);
+    if (ivar != var_handles_.end()) return &ivar->second;
+    if (!obs_group_.vars.exists(varName)) return nullptr;
+    return &var_handles_.emplace(varName, obs_group_.vars.open(varName)).first->second;
+}
+
 // -----------------------------------------------------------------------------
 void ObsSpace::splitChanSuffix(const std::string & group, const std::string & name,
                                const std::vector<int> & chanSelect, std::string & nameToUse,
@@ -1156,8 +1667,8 @@ void ObsSpace::splitChanSuffix(const std::string & group, const std::string & na
     // For backward compatibility, recognize and handle appropriately variable names with
     // channel suffixes.
     if (chanSelect.empty() &&
-        !obs_group_.vars.exists(fullVarName(group, name)) &&
-        (skipDerived || !obs_group_.vars.exists(fullVarName("Derived" + group, name)))) {
+        findVar(fullVarName(group, name)) == nullptr &&
+        (skipDerived || findVar(fullVarName("Derived" + group, name)) == nullptr)) {
         int channelNumber;
         if (extractChannelSuffixIfPresent(name, nameToUse, channelNumber))
             chanSelectToUse = {channelNumber};
@@ -1166,149 +1677,123 @@ void ObsSpace::splitChanSuffix(const std::string & group, const std::string & na
 
 // -----------------------------------------------------------------------------
 void ObsSpace::buildSortedObsGroups() {
-    typedef std::map<std::size_t, std::vector<std::pair<float, std::size_t>>> TmpRecIdxMap;
-    typedef TmpRecIdxMap::iterator TmpRecIdxIter;
+    const ObsGroupingParameters & groupingParams =
+      obs_params_.top_level_.obsDataIn.value().obsGrouping.value();
+    const bool ascending = (this->obs_sort_order() == "ascending");
 
-    const float missingFloat = util::missingValue(missingFloat);
-    const util::DateTime missingDateTime = util::missingValue(missingDateTime);
-    const MissingSortValueTreatment missingSortValueTreatment =
-      obs_params_.top_level_.obsDataIn.value().obsGrouping.value().missingSortValueTreatment;
-
-    // Get the sort variable from the data store, and convert to a vector of floats.
-    std::size_t nLocs = this->nlocs();
-    std::vector<float> SortValues(nLocs);
-    std::vector<bool> sortValueMissing(nLocs, false);
+    // Group the locations by record, in their original order, then sort each record
+    // segment of the index in place.
+    buildRecIdxUnsorted();
+
+    const std::size_t nLocs = this->nlocs();
+    std::vector<char> sortValueMissing(nLocs, 0);
     if (this->obs_sort_var() == "dateTime") {
-        std::vector<util::DateTime> Dates(nLocs);
-        get_db("MetaData", this->obs_sort_var(), Dates);
+        // Sort on the stored epoch offsets. These order the same way as the date times and,
+        // unlike floats, represent them exactly. Missing date times are later than any
+        // valid one, so give them the largest key.
+        const int64_t missingInt64 = util::missingValue(missingInt64);
+        std::vector<int64_t> SortValues(nLocs);
+        get_db("MetaData", this->obs_sort_var(), gsl::make_span(SortValues));
         for (std::size_t iloc = 0; iloc < nLocs; iloc++) {
-            SortValues[iloc] = (Dates[iloc] - Dates[0]).toSeconds();
-            if (Dates[iloc] == missingDateTime)
-              sortValueMissing[iloc] = true;
+            if (SortValues[iloc] == missingInt64) {
+              SortValues[iloc] = std::numeric_limits<int64_t>::max();
+              sortValueMissing[iloc] = 1;
+            }
         }
+        sortRecordSegments(recidx_offsets_, recidx_locs_, SortValues, sortValueMissing,
+                           groupingParams.missingSortValueTreatment, ascending,
+                           groupingParams.sortThreads);
     } else {
-        get_db(this->obs_sort_group(), this->obs_sort_var(), SortValues);
+        const float missingFloat = util::missingValue(missingFloat);
+        std::vector<float> SortValues(nLocs);
+        get_db(this->obs_sort_group(), this->obs_sort_var(), gsl::make_span(SortValues));
         for (std::size_t iloc = 0; iloc < nLocs; iloc++) {
-          if (SortValues[iloc] == missingFloat)
-            sortValueMissing[iloc] = true;
-        }
-    }
-
-    // Construct a temporary structure to do the sorting, then transfer the results
-    // to the data member recidx_.
-    TmpRecIdxMap TmpRecIdx;
-    // Indices of missing sort values for each record number.
-    std::map<std::size_t, std::vector<std::size_t>> TmpRecIdx_missing;
-    // Whether or not each location in a record has a missing sort value.
-    std::map<std::size_t, std::vector<bool>> sortValueMissingInRecord;
-    // Indicates whether a particular record has at least one missing sort value.
-    std::map<std::size_t, bool> recordContainsAtLeastOneMissingSortValue;
-
-    for (size_t iloc = 0; iloc < nLocs; iloc++) {
-        const std::size_t recnum = recnums_[iloc];
-        if (missingSortValueTreatment == MissingSortValueTreatment::SORT) {
-          TmpRecIdx[recnum].push_back(std::make_pair(SortValues[iloc], iloc));
-        } else if (missingSortValueTreatment == MissingSortValueTreatment::NO_SORT) {
-          TmpRecIdx[recnum].push_back(std::make_pair(SortValues[iloc], iloc));
-          if (sortValueMissing[iloc])
-            recordContainsAtLeastOneMissingSortValue[recnum] = true;
-        } else if (missingSortValueTreatment == MissingSortValueTreatment::IGNORE_MISSING) {
-          if (sortValueMissing[iloc]) {
-            TmpRecIdx_missing[recnum].push_back(iloc);
-            sortValueMissingInRecord[recnum].push_back(true);
-          } else {
-            TmpRecIdx[recnum].push_back(std::make_pair(SortValues[iloc], iloc));
-            sortValueMissingInRecord[recnum].push_back(false);
-          }
-        }
-    }
-
-    for (TmpRecIdxIter irec = TmpRecIdx.begin(); irec != TmpRecIdx.end(); ++irec) {
-        // Check if any values of the sort variable in this profile are missing.
-        // If so, do not proceed with the sort.
-        if (missingSortValueTreatment == MissingSortValueTreatment::NO_SORT &&
-            recordContainsAtLeastOneMissingSortValue[irec->first])
-          continue;
-
-        if (this->obs_sort_order() == "ascending") {
-            sort(irec->second.begin(), irec->second.end());
-        } else {
-            // Use a lambda function to access the std::pair greater-than operator to
-            // implement a descending order sort, ensuring the associated indices remain
-            // in ascending order.
-            sort(irec->second.begin(), irec->second.end(),
-                        [](const std::pair<float, std::size_t> & p1,
-                           const std::pair<float, std::size_t> & p2){
-                   return (p2.first < p1.first ||
-                           (!(p1.first < p2.first) && p2.second > p1.second));});
-        }
-    }
-
-    // Copy indexing to the recidx_ data member.
-    for (TmpRecIdxIter irec = TmpRecIdx.begin(); irec != TmpRecIdx.end(); ++irec) {
-        const size_t recnum = irec->first;
-        recidx_[recnum].resize(irec->second.size());
-        if (missingSortValueTreatment == MissingSortValueTreatment::SORT ||
-            missingSortValueTreatment == MissingSortValueTreatment::NO_SORT) {
-          for (std::size_t iloc = 0; iloc < irec->second.size(); iloc++) {
-            recidx_[recnum][iloc] = irec->second[iloc].second;
-          }
-        } else if (missingSortValueTreatment == MissingSortValueTreatment::IGNORE_MISSING) {
-          // Locations with missing sort values in this record.
-          const std::vector<std::size_t> locations_missing = TmpRecIdx_missing[recnum];
-          // Locations with non-missing sort values in this record.
-          const std::vector<std::pair<float, std::size_t>> locations_present = TmpRecIdx[recnum];
-          // Whether or not sort values are missing at each location in this record.
-          const std::vector<bool> sortValueMissingInThisRecord = sortValueMissingInRecord[recnum];
-          recidx_[recnum].resize(sortValueMissingInThisRecord.size());
-          // Indices of locations with a non-missing sort value.
-          std::vector<std::size_t> locations_present_vector;
-          for (std::size_t iloc = 0; iloc < locations_present.size(); ++iloc) {
-            locations_present_vector.push_back(locations_present[iloc].second);
-          }
-          // Counts of missing and non-missing locations.
-          std::size_t count_present = 0;
-          std::size_t count_missing = 0;
-          for (std::size_t iloc = 0; iloc < sortValueMissingInThisRecord.size(); ++iloc) {
-            if (sortValueMissingInThisRecord[iloc]) {
-              recidx_[recnum][iloc] = locations_missing[count_missing++];
-            } else {
-              recidx_[recnum][iloc] = locations_present_vector[count_present++];
-            }
-          }
+            if (SortValues[iloc] == missingFloat)
+              sortValueMissing[iloc] = 1;
         }
+        sortRecordSegments(recidx_offsets_, recidx_locs_, SortValues, sortValueMissing,
+                           groupingParams.missingSortValueTreatment, ascending,
+                           groupingParams.sortThreads);
     }
 }
 
 // -----------------------------------------------------------------------------
 void ObsSpace::buildRecIdxUnsorted() {
-  std::size_t nLocs = this->nlocs();
-  for (size_t iloc = 0; iloc < nLocs; iloc++) {
-    recidx_[recnums_[iloc]].push_back(iloc);
+  const std::size_t nLocs = this->nlocs();
+
+  // Collect the distinct record numbers in ascending order. The locations of a record
+  // are usually adjacent, so only the first of each run of equal record numbers is kept
+  // before sorting.
+  recidx_recnums_.clear();
+  for (std::size_t iloc = 0; iloc < nLocs; ++iloc) {
+    if (iloc == 0 || recnums_[iloc] != recnums_[iloc - 1])
+      recidx_recnums_.push_back(recnums_[iloc]);
+  }
+  std::sort(recidx_recnums_.begin(), recidx_recnums_.end());
+  recidx_recnums_.erase(std::unique(recidx_recnums_.begin(), recidx_recnums_.end()),
+                        recidx_recnums_.end());
+
+  // Counting sort of the locations by the position of their record number, which keeps
+  // the locations of each record in ascending order.
+  std::vector<std::size_t> recPositions(nLocs);
+  recidx_offsets_.assign(recidx_recnums_.size() + 1, 0);
+  std::size_t recPos = 0;
+  for (std::size_t iloc = 0; iloc < nLocs; ++iloc) {
+    if (iloc == 0 || recnums_[iloc] != recnums_[iloc - 1])
+      recPos = recidx_find(recnums_[iloc]) - recidx_recnums_.begin();
+    recPositions[iloc] = recPos;
+    ++recidx_offsets_[recPos + 1];
+  }
+  std::partial_sum(recidx_offsets_.begin(), recidx_offsets_.end(), recidx_offsets_.begin());
+
+  std::vector<std::size_t> nextSlot(recidx_offsets_.begin(), recidx_offsets_.end() - 1);
+  recidx_locs_.resize(nLocs);
+  for (std::size_t iloc = 0; iloc < nLocs; ++iloc) {
+    recidx_locs_[nextSlot[recPositions[iloc]]++] = iloc;
   }
 }
 
+// -----------------------------------------------------------------------------
+ObsSpace::RecIdxIter ObsSpace::recidx_find(const std::size_t recNum) const {
+  RecIdxIter irec = std::lower_bound(recidx_recnums_.begin(), recidx_recnums_.end(), recNum);
+  if (irec != recidx_recnums_.end() && *irec != recNum) irec = recidx_recnums_.end();
+  return irec;
+}
+
 // -----------------------------------------------------------------------------
 template <typename DataType>
 void ObsSpace::extendVariable(Variable & extendVar,
-                              const size_t upperBoundOnGlobalNumOriginalRecs) {
+                              const size_t upperBoundOnGlobalNumOriginalRecs,
+                              const size_t numOriginalLocs, const size_t numCompanionLocs) {
     const DataType missing = util::missingValue(missing);
+    if (numCompanionLocs == 0) return;
+    const size_t numExtendedLocs = numOriginalLocs + numCompanionLocs;
 
-    // Read in variable data values. At this point the values will contain
-    // the extended region filled with missing values. The read call will size
-    // the varVals vector accordingly.
-    std::vector<DataType> varVals;
-    extendVar.read<DataType>(varVals);
-
-    for (const auto & recordindex : recidx_) {
+    // Read in the values of the original locations, and the current values (missing
+    // values) of the companion locations, which follow them.
+    std::vector<DataType> originalVals(numOriginalLocs);
+    if (numOriginalLocs > 0) {
+      extendVar.read<DataType>(gsl::make_span(originalVals),
+                               createRangeSelection(numOriginalLocs, 0, numOriginalLocs),
+                               createRangeSelection(numExtendedLocs, 0, numOriginalLocs));
+    }
+    const Selection companionMemSelect =
+      createRangeSelection(numCompanionLocs, 0, numCompanionLocs);
+    const Selection companionFileSelect =
+      createRangeSelection(numExtendedLocs, numOriginalLocs, numCompanionLocs);
+    std::vector<DataType> companionVals(numCompanionLocs);
+    extendVar.read<DataType>(gsl::make_span(companionVals), companionMemSelect,
+                             companionFileSelect);
+
+    for (RecIdxIter irec = recidx_begin(); irec != recidx_end(); ++irec) {
       // Only deal with records in the original ObsSpace.
-      if (recordindex.first >= upperBoundOnGlobalNumOriginalRecs) break;
+      if (*irec >= upperBoundOnGlobalNumOriginalRecs) break;
 
       // Find the first non-missing value in the original record.
       DataType fillValue = missing;
-      for (const auto & jloc : recordindex.second) {
-        if (varVals[jloc] != missing) {
-          fillValue = varVals[jloc];
+      for (const auto & jloc : recidx_span(irec)) {
+        if (originalVals[jloc] != missing) {
+          fillValue = originalVals[jloc];
           break;
         }
       }
@@ -1316,14 +1801,15 @@ void ObsSpace::extendVariable(Variable & extendVar,
       // Fill the companion record with the first non-missing value in the original record.
       // (If all values are missing, do nothing.)
       if (fillValue != missing) {
-        for (const auto & jloc : recidx_[recordindex.first + upperBoundOnGlobalNumOriginalRecs]) {
-          varVals[jloc] = fillValue;
+        for (const auto & jloc : recidx_span(*irec + upperBoundOnGlobalNumOriginalRecs)) {
+          companionVals[jloc - numOriginalLocs] = fillValue;
         }
       }
     }
 
-    // Write out values of the companion record.
-    extendVar.write<DataType>(varVals);
+    // Write out values of the companion records.
+    extendVar.write<DataType>(gsl::make_span(companionVals), companionMemSelect,
+                              companionFileSelect);
 }
 
 // -----------------------------------------------------------------------------
@@ -1344,8 +1830,8 @@ void ObsSpace::extendObsSpace(const ObsExtendParameters & params) {
   if (nlevs > 0 &&
       gnlocs_ > 0 &&
       recordsExist) {
-    // Identify the indices of all local original records.
-    const std::set<size_t> uniqueOriginalRecs(recnums_.begin(), recnums_.end());
+    // The record index holds the indices of all local original records in ascending order.
+    const size_t numOriginalRecs = recidx_recnums_.size();
 
     // Find the largest global indices of locations and records in the original ObsSpace.
     // Increment them by one to produce the initial values for the global indices of locations
@@ -1357,7 +1843,7 @@ void ObsSpace::extendObsSpace(const ObsExtendParameters & params) {
     size_t upperBoundOnGlobalNumOriginalRecs = 0;
     if (numOriginalLocs > 0) {
       upperBoundOnGlobalNumOriginalLocs = indx_.back() + 1;
-      upperBoundOnGlobalNumOriginalRecs = *uniqueOriginalRecs.rbegin() + 1;
+      upperBoundOnGlobalNumOriginalRecs = recidx_recnums_.back() + 1;
     }
     dist_->max(upperBoundOnGlobalNumOriginalLocs);
     dist_->max(upperBoundOnGlobalNumOriginalRecs);
@@ -1369,16 +1855,27 @@ void ObsSpace::extendObsSpace(const ObsExtendParameters & params) {
 
     // Create companion locations and records.
 
+    // Reserve space for the companion locations and records up front.
+    const size_t numCompanionLocsToAdd = numOriginalRecs * nlevs;
+    recnums_.reserve(numOriginalLocs + numCompanionLocsToAdd);
+    indx_.reserve(numOriginalLocs + numCompanionLocsToAdd);
+    recidx_recnums_.reserve(2 * numOriginalRecs);
+    recidx_offsets_.reserve(2 * numOriginalRecs + 1);
+    recidx_locs_.reserve(numOriginalLocs + numCompanionLocsToAdd);
+
     // Local index of a companion location. Note that these indices, like local indices of
     // original locations, start from 0.
     size_t companionLoc = 0;
-    for (size_t originalRec : uniqueOriginalRecs) {
+    for (size_t jrec = 0; jrec < numOriginalRecs; ++jrec) {
+      const size_t originalRec = recidx_recnums_[jrec];
       ASSERT(dist_->isMyRecord(originalRec));
       const size_t companionRec = originalRec;
       const size_t extendedRec = upperBoundOnGlobalNumOriginalRecs + companionRec;
       nrecs_++;
-      // recidx_ stores the locations belonging to each record on the local processor.
-      std::vector<size_t> &locsInRecord = recidx_[extendedRec];
+      // The record index stores the locations belonging to each record on the local
+      // processor. Companion record numbers exceed all original ones, so appending them
+      // keeps the record numbers in ascending order.
+      recidx_recnums_.push_back(extendedRec);
       for (int ilev = 0; ilev < nlevs; ++ilev, ++companionLoc) {
         const size_t extendedLoc = numOriginalLocs + companionLoc;
         const size_t globalCompanionLoc = originalRec * nlevs + ilev;
@@ -1389,15 +1886,17 @@ void ObsSpace::extendObsSpace(const ObsExtendParameters & params) {
         ASSERT(replicaDist->isMyRecord(companionRec));
         recnums_.push_back(extendedRec);
         indx_.push_back(globalExtendedLoc);
-        locsInRecord.push_back(extendedLoc);
+        recidx_locs_.push_back(extendedLoc);
       }
+      recidx_offsets_.push_back(recidx_locs_.size());
     }
     replicaDist->computePatchLocs();
 
     const size_t numCompanionLocs = companionLoc;
     const size_t numExtendedLocs = numOriginalLocs + numCompanionLocs;
 
-    // Extend all existing vectors with missing values.
+    // Extend all existing vectors with missing values. This is a single resize of the
+    // Location dimension covering every variable at once.
     // Only vectors with (at least) one dimension equal to nlocs are modified.
     // Second argument (bool) to resizeLocation tells function:
     //       true -> append the amount in first argument to the existing size
@@ -1411,8 +1910,8 @@ void ObsSpace::extendObsSpace(const ObsExtendParameters & params) {
     // The resizeLocation() call above has extended all variables with Location as a first
     // dimension to the new Locationext size, and filled all the extended parts with
     // missing values. Go through the list of variables that are to be filled with
-    // non-missing values, check if they exist and if so fill in the extended section
-    // with non-missing values.
+    // non-missing values, check if they exist and if so write the non-missing values
+    // into the extended section only.
     const std::vector <std::string> &nonMissingExtendedVars = params.nonMissingExtendedVars;
     for (auto & varName : nonMissingExtendedVars) {
       // It is implied that these variables are in the MetaData group
@@ -1426,7 +1925,8 @@ void ObsSpace::extendObsSpace(const ObsExtendParameters & params) {
               extendVar,
               [&](auto typeDiscriminator) {
                   typedef decltype(typeDiscriminator) T;
-                  extendVariable<T>(extendVar, upperBoundOnGlobalNumOriginalRecs);
+                  extendVariable<T>(extendVar, upperBoundOnGlobalNumOriginalRecs,
+                                    numOriginalLocs, numCompanionLocs);
               },
               VarUtils::ThrowIfVariableIsOfUnsupportedType(fullVname));
       }
@@ -112,6 +112,24 @@ namespace ioda {
       typedef float to_type;
     };
 
+    /// \brief View of one channel in a caller-owned (Location x Channel) buffer
+    /// \details The buffer is row-major with \p stride channels per location, so the values
+    /// for the viewed channel are buffer[offset], buffer[offset + stride], and so on.
+    template <typename T>
+    struct StridedSpan {
+      StridedSpan(gsl::span<T> buffer, std::size_t offset, std::size_t stride)
+        : buffer(buffer), offset(offset), stride(stride) {}
+
+      /// \brief number of elements (locations) in the view
+      std::size_t size() const { return (stride > 0) ? buffer.size() / stride : 0; }
+
+      T & operator[](std::size_t i) const { return buffer[i * stride + offset]; }
+
+      gsl::span<T> buffer;
+      std::size_t offset;
+      std::size_t stride;
+    };
+
     /// \brief Observation data class for IODA
     ///
     /// \details This class handles the memory store of observation data. It handles
@@ -126,8 +144,7 @@ namespace ioda {
     class ObsSpace : public oops::ObsSpaceBase {
      public:
         //---------------------------- typedefs -------------------------------
-        typedef std::map<std::size_t, std::vector<std::size_t>> RecIdxMap;
-        typedef RecIdxMap::const_iterator RecIdxIter;
+        typedef std::vector<std::size_t>::const_iterator RecIdxIter;
         typedef ObsTopLevelParameters Parameters_;
 
         //---------------------------- functions ------------------------------
@@ -361,6 +378,53 @@ namespace ioda {
                     const std::vector<int> & chanSelect = { },
                     bool skipDerived = false) const;
 
+        /// \brief transfer data from the obs container into caller-owned memory
+        ///
+        /// \details These get_db methods behave like the ones above, but write directly into
+        /// the memory viewed by vdata instead of resizing a vector. vdata must hold at least
+        /// as many elements as are selected from the variable; any extra elements are left
+        /// untouched. Type conversions (float to double, epoch offsets to DateTime, bytes to
+        /// bool) are done in a single pass into vdata.
+        void get_db(const std::string & group, const std::string & name,
+                    gsl::span<int> vdata,
+                    const std::vector<int> & chanSelect = { },
+                    bool skipDerived = false) const;
+        void get_db(const std::string & group, const std::string & name,
+                    gsl::span<int64_t> vdata,
+                    const std::vector<int> & chanSelect = { },
+                    bool skipDerived = false) const;
+        void get_db(const std::string & group, const std::string & name,
+                    gsl::span<float> vdata,
+                    const std::vector<int> & chanSelect = { },
+                    bool skipDerived = false) const;
+        void get_db(const std::string & group, const std::string & name,
+                    gsl::span<double> vdata,
+                    const std::vector<int> & chanSelect = { },
+                    bool skipDerived = false) const;
+        void get_db(const std::string & group, const std::string & name,
+                    gsl::span<util::DateTime> vdata,
+                    const std::vector<int> & chanSelect = { },
+                    bool skipDerived = false) const;
+        void get_db(const std::string & group, const std::string & name,
+                    gsl::span<bool> vdata,
+                    const std::vector<int> & chanSelect = { },
+                    bool skipDerived = false) const;
+
+        /// \brief transfer one channel of a (Location x Channel) variable from the obs
+        ///        container into one column of a caller-owned buffer
+        ///
+        /// \param group Name of container group (ObsValue, ObsError, MetaData, etc.)
+        /// \param name  Name of container variable
+        /// \param channel Channel number to be transferred
+        /// \param vdata View of the destination column, must have one element per location
+        /// \param skipDerived see the get_db methods above
+        void get_db(const std::string & group, const std::string & name, int channel,
+                    StridedSpan<int> vdata, bool skipDerived = false) const;
+        void get_db(const std::string & group, const std::string & name, int channel,
+                    StridedSpan<float> vdata, bool skipDerived = false) const;
+        void get_db(const std::string & group, const std::string & name, int channel,
+                    StridedSpan<double> vdata, bool skipDerived = false) const;
+
         /// \brief transfer data from vdata to the obs container
         ///
         /// \details The following put_db methods are the same except for the data type
@@ -393,6 +457,45 @@ namespace ioda {
                     const std::vector<bool> & vdata,
                     const std::vector<std::string> & dimList = { "Location" });
 
+        /// \brief transfer data from caller-owned memory to the obs container
+        ///
+        /// \details These put_db methods behave like the ones above, but read directly from
+        /// the memory viewed by vdata instead of from a vector.
+        void put_db(const std::string & group, const std::string & name,
+                    gsl::span<const int> vdata,
+                    const std::vector<std::string> & dimList = { "Location" });
+        void put_db(const std::string & group, const std::string & name,
+                    gsl::span<const int64_t> vdata,
+                    const std::vector<std::string> & dimList = { "Location" });
+        void put_db(const std::string & group, const std::string & name,
+                    gsl::span<const float> vdata,
+                    const std::vector<std::string> & dimList = { "Location" });
+        void put_db(const std::string & group, const std::string & name,
+                    gsl::span<const double> vdata,
+                    const std::vector<std::string> & dimList = { "Location" });
+        void put_db(const std::string & group, const std::string & name,
+                    gsl::span<const util::DateTime> vdata,
+                    const std::vector<std::string> & dimList = { "Location" });
+        void put_db(const std::string & group, const std::string & name,
+                    gsl::span<const bool> vdata,
+                    const std::vector<std::string> & dimList = { "Location" });
+
+        /// \brief transfer one column of a caller-owned buffer into one channel of a
+        ///        (Location x Channel) variable in the obs container
+        ///
+        /// \details The variable is created with the Location and Channel dimensions if it
+        /// does not already exist.
+        /// \param group Name of container group (ObsValue, ObsError, MetaData, etc.)
+        /// \param name  Name of container variable
+        /// \param channel Channel number to be transferred
+        /// \param vdata View of the source column, must have one element per location
+        void put_db(const std::string & group, const std::string & name, int channel,
+                    StridedSpan<const int> vdata);
+        void put_db(const std::string & group, const std::string & name, int channel,
+                    StridedSpan<const float> vdata);
+        void put_db(const std::string & group, const std::string & name, int channel,
+                    StridedSpan<const double> vdata);
+
         /// @}
         /// @name Record index and sorting functions
         /// @{
@@ -415,12 +518,24 @@ namespace ioda {
         std::size_t recidx_recnum(const RecIdxIter & irec) const;
 
         /// \brief return record number vector pointed to by the given iterator
+        /// \details This returns a copy of the locations; use recidx_span to avoid the copy.
         /// \param irec Iterator into the recidx_ data member
-        const std::vector<std::size_t> & recidx_vector(const RecIdxIter & irec) const;
+        std::vector<std::size_t> recidx_vector(const RecIdxIter & irec) const;
 
         /// \brief return record number vector selected by the given record number
+        /// \details This returns a copy of the locations; use recidx_span to avoid the copy.
+        /// \param recNum Record number being searched for
+        std::vector<std::size_t> recidx_vector(const std::size_t recNum) const;
+
+        /// \brief return the locations of the record pointed to by the given iterator
+        /// \details The span refers to the record index and remains valid until the
+        /// ObsSpace is extended or destroyed.
+        /// \param irec Iterator into the recidx_ data member
+        gsl::span<const std::size_t> recidx_span(const RecIdxIter & irec) const;
+
+        /// \brief return the locations of the record selected by the given record number
         /// \param recNum Record number being searched for
-        const std::vector<std::size_t> & recidx_vector(const std::size_t recNum) const;
+        gsl::span<const std::size_t> recidx_span(const std::size_t recNum) const;
 
         /// \brief return all record numbers from the recidx_ data member
         std::vector<std::size_t> recidx_all_recnums() const;
@@ -490,8 +605,13 @@ namespace ioda {
         /// \brief record numbers associated with the location indexes
         std::vector<std::size_t> recnums_;
 
-        /// \brief profile ordering
-        RecIdxMap recidx_;
+        /// \brief profile ordering, stored as a compressed record index. recidx_recnums_
+        /// holds the local record numbers in ascending order, and the locations of record
+        /// recidx_recnums_[i] are recidx_locs_[recidx_offsets_[i]] up to (but excluding)
+        /// recidx_locs_[recidx_offsets_[i+1]].
+        std::vector<std::size_t> recidx_recnums_;
+        std::vector<std::size_t> recidx_offsets_;
+        std::vector<std::size_t> recidx_locs_;
 
         /// \brief indicator whether the data in recidx_ is sorted
         bool recidx_is_sorted_;
@@ -499,6 +619,15 @@ namespace ioda {
         /// \brief map showing association of dim names with each variable name
         VarUtils::VarDimMap dims_attached_to_vars_;
 
+        /// \brief cache of the handles of variables in obs_group_, keyed by full name
+        /// \details Filled by findVar() so that repeated lookups of the same variable skip
+        /// resolving its name. Variables can be removed through getObsGroup(), so the cache
+        /// is dropped whenever the structure version of obs_group_ changes.
+        mutable std::unordered_map<std::string, Variable> var_handles_;
+
+        /// \brief structure version of obs_group_ that the handles in var_handles_ belong to
+        mutable std::size_t var_handles_version_;
+
         /// \brief cache for frontend selection
         std::map<VarUtils::Vec_Named_Variable, Selection> known_fe_selections_;
 
@@ -538,6 +667,11 @@ namespace ioda {
         /// any particular ordering of the record groups.
         void buildRecIdxUnsorted();
 
+        /// \brief Find the given record number in the recidx data structure
+        /// \return iterator to the record number, or recidx_end() if it is not present
+        /// \param recNum Record number being searched for
+        RecIdxIter recidx_find(const std::size_t recNum) const;
+
         /// \brief initialize the in-memory obs_group_ (ObsGroup) object from the ObsIo source
         /// \param obsIo obs source object
         void initFromObsSource(ObsFrameRead & obsFrame);
@@ -547,23 +681,35 @@ namespace ioda {
         /// \param append when true append LocationSize to current size, otherwise reset size
         void resizeLocation(const Dimensions_t LocationSize, const bool append);
 
+        /// \brief reserve storage along Location dimension
+        /// \details The storage of all variables dimensioned by Location is reserved
+        /// in one pass so that growing the dimension frame by frame does not reallocate.
+        /// \param LocationCapacity number of locations to reserve storage for
+        void reserveLocation(const Dimensions_t LocationCapacity);
+
         /// \brief read in values for variable from obs source
+        /// \details The fill values of the obs source are not replaced here, see
+        ///          replaceSourceFillValues.
         /// \param obsFrame obs frame object
         /// \param varName Name of variable in obs source object
         /// \param varValues values for variable
+        /// \param hasSourceFillValue set to true if the obs source variable has a fill value
+        /// \param sourceFillValue set to the fill value of the obs source variable
         template<typename VarType>
         bool readObsSource(ObsFrameRead & obsFrame,
-                           const std::string & varName, std::vector<VarType> & varValues);
+                           const std::string & varName, std::vector<VarType> & varValues,
+                           bool & hasSourceFillValue, VarType & sourceFillValue);
 
-        /// \brief store a variable in the obs_group_ object
-        /// \param obsIo obs source object
+        /// \brief set up the selections for storing a frame of a variable in obs_group_
         /// \param varName Name of obs_group_ variable for obs_group_ object
-        /// \param varValues Values for obs_group_ variable
+        /// \param var obs_group_ variable
         /// \param frameStart is the start of the ObsFrame
         /// \param frameCount is the size of the ObsFrame
-        template<typename VarType>
-        void storeVar(const std::string & varName, std::vector<VarType> & varValues,
-                      const Dimensions_t frameStart, const Dimensions_t frameCount);
+        /// \param feSelect set to the frontend (memory) selection
+        /// \param beSelect set to the backend (obs_group_) selection
+        void storeSelections(const std::string & varName, const Variable & var,
+                             const Dimensions_t frameStart, const Dimensions_t frameCount,
+                             Selection & feSelect, Selection & beSelect);
 
         /// \brief get fill value for use in the obs_group_ object
         template<typename DataType>
@@ -591,6 +737,31 @@ namespace ioda {
                      const std::vector<int> & chanSelect,
                      std::vector<VarType> & varValues, bool skipDerived = false) const;
 
+        /// \brief load a variable from the obs_group_ object into caller-owned memory
+        /// \details Same as the vector version, except that varValues is not resized
+        ///          and must hold at least as many elements as are selected.
+        /// \return the number of elements loaded into varValues
+        template<typename VarType>
+        std::size_t loadVar(const std::string & group, const std::string & name,
+                            const std::vector<int> & chanSelect,
+                            gsl::span<VarType> varValues, bool skipDerived = false) const;
+
+        /// \brief load one channel of a variable from the obs_group_ object into one
+        ///        column of a caller-owned buffer
+        template<typename VarType>
+        void loadVar(const std::string & group, const std::string & name, int channel,
+                     StridedSpan<VarType> varValues, bool skipDerived = false) const;
+
+        /// \brief open a variable for loading and set up the selections to be used
+        /// \details The group, name and channel selection are resolved in the same way as
+        ///          for loadVar. If no channel selection applies, the selections are left
+        ///          as selecting the whole variable.
+        /// \param numElements is set to the number of elements selected
+        Variable openLoadVar(const std::string & group, const std::string & name,
+                             const std::vector<int> & chanSelect, bool skipDerived,
+                             Selection & memSelect, Selection & obsGroupSelect,
+                             std::size_t & numElements) const;
+
         /// \brief save a variable to the obs_group_ object
         /// \param group Name of Group in obs_group_
         /// \param name Name of Variable in group.
@@ -604,9 +775,19 @@ namespace ioda {
         /// exists but is not associated with the `Channel` dimension, an exception will be thrown.
         template<typename VarType>
         void saveVar(const std::string & group, std::string name,
-                     const std::vector<VarType> & varValues,
+                     gsl::span<const VarType> varValues,
                      const std::vector<std::string> & dimList);
 
+        /// \brief save one column of a caller-owned buffer to one channel of an
+        ///        obs_group_ variable
+        template<typename VarType>
+        void saveVar(const std::string & group, const std::string & name, int channel,
+                     StridedSpan<const VarType> varValues);
+
+        /// \brief return the index of the Channel dimension of a variable
+        /// \throws eckit::UserError if the variable is not indexed by channel numbers
+        std::size_t channelDimIndex(const Variable & var, const std::string & varName) const;
+
         /// \brief Create selections of slices of the variable \p variable along dimension
         /// \p ChannelDimIndex corresponding to channels \p channels.
         ///
@@ -630,8 +811,8 @@ namespace ioda {
         Variable openCreateVar(const std::string & varName,
                                const std::vector<std::string> & varDimList) {
             Variable var;
-            if (obs_group_.vars.exists(varName)) {
-                var = obs_group_.vars.open(varName);
+            if (const Variable * cachedVar = findVar(varName)) {
+                var = *cachedVar;
             } else {
                 // Create a vector of the dimension variables
                 std::vector<Variable> varDims;
@@ -648,6 +829,7 @@ namespace ioda {
                 params.setFillValue<VarType>(fillVal);
 
                 var = obs_group_.vars.createWithScales<VarType>(varName, varDims, params);
+                var_handles_.emplace(varName, var);
             }
             return var;
         }
@@ -655,6 +837,11 @@ namespace ioda {
         /// \brief fill in the channel number to channel index map
         void fillChanNumToIndexMap();
 
+        /// \brief look up a variable in obs_group_ through the handle cache
+        /// \param varName Full name (group/name) of the variable
+        /// \return pointer to the cached handle, or nullptr if the variable does not exist
+        const Variable * findVar(const std::string & varName) const;
+
         /// \brief split off the channel number suffix from a given variable name
         /// \details If the given variable name does not exist, the channelSelect vector
         ///          is empty, and the given variable name has a suffix matching
@@ -679,11 +866,17 @@ namespace ioda {
                              bool skipDerived = false) const;
 
         /// \brief Extend the given variable
+        /// \details Fills each companion record with the first non-missing value of the
+        /// corresponding original record. Only the original locations are read and only
+        /// the companion locations are written.
         /// \param extendVar database variable to be extended
         /// \param upperBoundOnGlobalNumOriginalRecs upper bound, across all processors,
         ///        of the number of records in the original ObsSpace.
+        /// \param numOriginalLocs number of local locations before the extension
+        /// \param numCompanionLocs number of local locations added by the extension
         template <typename DataType>
-        void extendVariable(Variable & extendVar, const size_t upperBoundOnGlobalNumOriginalRecs);
+        void extendVariable(Variable & extendVar, const size_t upperBoundOnGlobalNumOriginalRecs,
+                            const size_t numOriginalLocs, const size_t numCompanionLocs);
     };
 
 }  // namespace ioda
@@ -77,6 +77,10 @@ class ObsTopLevelParameters : public oops::ObsSpaceParametersBase {
     /// Io pool parameters
     oops::Parameter<IoPoolParameters> ioPool{"io pool", {}, this};
 
+    /// If true, dot products and norms of obs vectors are computed with an exact summation
+    /// whose result does not depend on the number of MPI tasks or on the distribution.
+    oops::Parameter<bool> reproducibleReductions{"reproducible reductions", false, this};
+
     /// extend the ObsSpace with extra fixed-size records
     oops::OptionalParameter<ObsExtendParameters> obsExtend{"extension", this};
 
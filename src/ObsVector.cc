@@ -8,9 +8,11 @@
 #include "ioda/ObsVector.h"
 
 #include <math.h>
+#include <algorithm>
 #include <limits>
 
 #include "eckit/config/LocalConfiguration.h"
+#include "ioda/core/MissingValueKernels.h"
 #include "ioda/distribution/DistributionUtils.h"
 #include "ioda/ObsDataVector.h"
 #include "ioda/ObsSpace.h"
@@ -49,70 +51,36 @@ ObsVector & ObsVector::operator= (const ObsVector & rhs) {
 }
 // -----------------------------------------------------------------------------
 ObsVector & ObsVector::operator*= (const double & zz) {
-  for (size_t jj = 0; jj < values_.size() ; ++jj) {
-    if (values_[jj] != missing_) {
-      values_[jj] = zz * values_[jj];
-    }
-  }
+  missingAwareScale<double>(gsl::make_span(values_), zz, missing_);
   return *this;
 }
 // -----------------------------------------------------------------------------
 ObsVector & ObsVector::operator+= (const ObsVector & rhs) {
-  const size_t nn = values_.size();
-  ASSERT(rhs.values_.size() == nn);
-  for (size_t jj = 0; jj < nn ; ++jj) {
-    if (values_[jj] == missing_ || rhs.values_[jj] == missing_) {
-      values_[jj] = missing_;
-    } else {
-      values_[jj] += rhs.values_[jj];
-    }
-  }
+  ASSERT(rhs.values_.size() == values_.size());
+  missingAwareAdd<double>(gsl::make_span(values_), gsl::make_span(rhs.values_), missing_);
   return *this;
 }
 // -----------------------------------------------------------------------------
 ObsVector & ObsVector::operator-= (const ObsVector & rhs) {
-  const size_t nn = values_.size();
-  ASSERT(rhs.values_.size() == nn);
-  for (size_t jj = 0; jj < nn ; ++jj) {
-    if (values_[jj] == missing_ || rhs.values_[jj] == missing_) {
-      values_[jj] = missing_;
-    } else {
-      values_[jj] -= rhs.values_[jj];
-    }
-  }
+  ASSERT(rhs.values_.size() == values_.size());
+  missingAwareSubtract<double>(gsl::make_span(values_), gsl::make_span(rhs.values_), missing_);
   return *this;
 }
 // -----------------------------------------------------------------------------
 ObsVector & ObsVector::operator*= (const ObsVector & rhs) {
-  const size_t nn = values_.size();
-  ASSERT(rhs.values_.size() == nn);
-  for (size_t jj = 0; jj < nn ; ++jj) {
-    if (values_[jj] == missing_ || rhs.values_[jj] == missing_) {
-      values_[jj] = missing_;
-    } else {
-      values_[jj] *= rhs.values_[jj];
-    }
-  }
+  ASSERT(rhs.values_.size() == values_.size());
+  missingAwareMultiply<double>(gsl::make_span(values_), gsl::make_span(rhs.values_), missing_);
   return *this;
 }
 // -----------------------------------------------------------------------------
 ObsVector & ObsVector::operator/= (const ObsVector & rhs) {
-  const size_t nn = values_.size();
-  ASSERT(rhs.values_.size() == nn);
-  for (size_t jj = 0; jj < nn ; ++jj) {
-    if (values_[jj] == missing_ || rhs.values_[jj] == missing_) {
-      values_[jj] = missing_;
-    } else {
-      values_[jj] /= rhs.values_[jj];
-    }
-  }
+  ASSERT(rhs.values_.size() == values_.size());
+  missingAwareDivide<double>(gsl::make_span(values_), gsl::make_span(rhs.values_), missing_);
   return *this;
 }
 // -----------------------------------------------------------------------------
 void ObsVector::zero() {
-  for (size_t jj = 0; jj < values_.size() ; ++jj) {
-    values_[jj] = 0.0;
-  }
+  std::fill(values_.begin(), values_.end(), 0.0);
 }
 // -----------------------------------------------------------------------------
 void ObsVector::ones() {
@@ -120,39 +88,19 @@ void ObsVector::ones() {
 }
 // -----------------------------------------------------------------------------
 void ObsVector::axpy(const double & zz, const ObsVector & rhs) {
-  const size_t nn = values_.size();
-  ASSERT(rhs.values_.size() == nn);
-  for (size_t jj = 0; jj < nn ; ++jj) {
-    if (values_[jj] == missing_ || rhs.values_[jj] == missing_) {
-      values_[jj] = missing_;
-    } else {
-      values_[jj] += zz * rhs.values_[jj];
-    }
-  }
+  ASSERT(rhs.values_.size() == values_.size());
+  missingAwareAxpy<double>(gsl::make_span(values_), zz, gsl::make_span(rhs.values_), missing_);
 }
 // -----------------------------------------------------------------------------
 void ObsVector::axpy(const std::vector<double> & beta, const ObsVector & y) {
   ASSERT(y.values_.size() == values_.size());
   ASSERT(beta.size() == nvars_);
-
-  size_t ivec = 0;
-  for (size_t jloc = 0; jloc < nlocs_; ++jloc) {
-    for (size_t jvar = 0; jvar < nvars_; ++jvar, ++ivec) {
-      if (values_[ivec] == missing_ || y.values_[ivec] == missing_) {
-        values_[ivec] = missing_;
-      } else {
-        values_[ivec] += beta[jvar] * y.values_[ivec];
-      }
-    }
-  }
+  missingAwareAxpy<double>(gsl::make_span(values_), gsl::make_span(beta),
+                           gsl::make_span(y.values_), missing_);
 }
 // -----------------------------------------------------------------------------
 void ObsVector::invert() {
-  for (size_t jj = 0; jj < values_.size() ; ++jj) {
-    if (values_[jj] != missing_) {
-      values_[jj] = 1.0 / values_[jj];
-    }
-  }
+  missingAwareInvert<double>(gsl::make_span(values_), missing_);
 }
 // -----------------------------------------------------------------------------
 void ObsVector::random() {
@@ -176,7 +124,8 @@ void ObsVector::random() {
 }
 // -----------------------------------------------------------------------------
 double ObsVector::dot_product_with(const ObsVector & other) const {
-  double zz = dotProduct(*obsdb_.distribution(), nvars_, values_, other.values_);
+  double zz = dotProduct(*obsdb_.distribution(), nvars_, values_, other.values_,
+                         obsdb_.params().top_level_.reproducibleReductions);
   return zz;
 }
 // -----------------------------------------------------------------------------
@@ -192,7 +141,8 @@ std::vector<double> ObsVector::multivar_dot_product_with(const ObsVector & other
       x1[jloc] = values_[jvar + (jloc * nvars_)];
       x2[jloc] = other.values_[jvar + (jloc*nvars_)];
     }
-    result[jvar] = dotProduct(*obsdb_.distribution(), 1, x1, x2);
+    result[jvar] = dotProduct(*obsdb_.distribution(), 1, x1, x2,
+                              obsdb_.params().top_level_.reproducibleReductions);
   }
   return result;
 }
@@ -292,11 +242,8 @@ ObsVector & ObsVector::operator=(const ObsDataVector<float> & rhs) {
 }
 // -----------------------------------------------------------------------------
 void ObsVector::mask(const ObsVector & mask) {
-  const size_t nn = values_.size();
-  assert(mask.values_.size() == nn);
-  for (size_t jj = 0; jj < nn; ++jj) {
-    if (mask[jj] == missing_) values_[jj] = missing_;
-  }
+  assert(mask.values_.size() == values_.size());
+  missingAwareMask<double>(gsl::make_span(values_), gsl::make_span(mask.values_), missing_);
 }
 // -----------------------------------------------------------------------------
 unsigned int ObsVector::nobs() const {
@@ -192,27 +192,43 @@ std::vector<util::DateTime> convertDtStringsToDtime(const std::vector<std::strin
 //------------------------------------------------------------------------------------
 std::vector<util::DateTime> convertEpochDtToDtime(const util::DateTime epochDtime,
                                                   const std::vector<int64_t> & timeOffsets) {
+  std::vector<util::DateTime> dateTimes(timeOffsets.size(), epochDtime);
+  convertEpochDtToDtime(epochDtime, gsl::make_span(timeOffsets), gsl::make_span(dateTimes));
+  return dateTimes;
+}
+
+//------------------------------------------------------------------------------------
+void convertEpochDtToDtime(const util::DateTime epochDtime,
+                           gsl::span<const int64_t> timeOffsets,
+                           gsl::span<util::DateTime> dtimes) {
+  ASSERT(dtimes.size() >= timeOffsets.size());
   const util::DateTime missingDateTime = util::missingValue(missingDateTime);
   const int64_t missingInt64 = util::missingValue(missingInt64);
-  std::vector<util::DateTime> dateTimes;
-  dateTimes.reserve(timeOffsets.size());
   for (std::size_t i = 0; i < timeOffsets.size(); ++i) {
     if (timeOffsets[i] == missingInt64) {
-      dateTimes.emplace_back(missingDateTime);
+      dtimes[i] = missingDateTime;
     } else {
       const util::Duration timeDiff(timeOffsets[i]);
-      dateTimes.emplace_back(epochDtime + timeDiff);
+      dtimes[i] = epochDtime + timeDiff;
     }
   }
-  return dateTimes;
 }
 
 //------------------------------------------------------------------------------------
 std::vector<int64_t> convertDtimeToTimeOffsets(const util::DateTime epochDtime,
                                                const std::vector<util::DateTime> & dtimes) {
+  std::vector<int64_t> timeOffsets(dtimes.size());
+  convertDtimeToTimeOffsets(epochDtime, gsl::make_span(dtimes), gsl::make_span(timeOffsets));
+  return timeOffsets;
+}
+
+//------------------------------------------------------------------------------------
+void convertDtimeToTimeOffsets(const util::DateTime epochDtime,
+                               gsl::span<const util::DateTime> dtimes,
+                               gsl::span<int64_t> timeOffsets) {
+  ASSERT(timeOffsets.size() >= dtimes.size());
   const util::DateTime missingDateTime = util::missingValue(missingDateTime);
   const int64_t missingInt64 = util::missingValue(missingInt64);
-  std::vector<int64_t> timeOffsets(dtimes.size());
   for (std::size_t i = 0; i < dtimes.size(); ++i) {
     if (dtimes[i] == missingDateTime) {
       timeOffsets[i] = missingInt64;
@@ -221,7 +237,6 @@ std::vector<int64_t> convertDtimeToTimeOffsets(const util::DateTime epochDtime,
       timeOffsets[i] = timeDiff.toSeconds();
     }
   }
-  return timeOffsets;
 }
 
 //------------------------------------------------------------------------------------
@@ -14,7 +14,10 @@
 #include <utility>
 #include <vector>
 
+#include <gsl/gsl-lite.hpp>
+
 #include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
 
 #include "ioda/Exception.h"
 #include "ioda/Misc/Dimensions.h"
@@ -81,12 +84,28 @@ namespace ioda {
   std::vector<util::DateTime> convertEpochDtToDtime(const util::DateTime epochDtime,
                                                     const std::vector<int64_t> & timeOffsets);
 
+  /// \brief convert epoch time offsets to DateTime objects, writing into caller memory
+  /// \param epochDtime datetime object holding the epoch datetime value
+  /// \param timeOffsets time offsets (seconds) relative to epochDtime
+  /// \param dtimes DateTime objects, must be at least as long as timeOffsets
+  void convertEpochDtToDtime(const util::DateTime epochDtime,
+                             gsl::span<const int64_t> timeOffsets,
+                             gsl::span<util::DateTime> dtimes);
+
   /// \brief convert DateTime objects to epoch time offsets
   /// \param epochDtime datetime object holding the epoch datetime value
   /// \param dtimes vector of DateTime objects
   std::vector<int64_t> convertDtimeToTimeOffsets(const util::DateTime epochDtime,
                                                  const std::vector<util::DateTime> & dtimes);
 
+  /// \brief convert DateTime objects to epoch time offsets, writing into caller memory
+  /// \param epochDtime datetime object holding the epoch datetime value
+  /// \param dtimes DateTime objects
+  /// \param timeOffsets time offsets (seconds), must be at least as long as dtimes
+  void convertDtimeToTimeOffsets(const util::DateTime epochDtime,
+                                 gsl::span<const util::DateTime> dtimes,
+                                 gsl::span<int64_t> timeOffsets);
+
   /// \brief convert datetime strings to epoch time offsets
   /// \param epochDtime datetime object holding the epoch datetime value
   /// \param dtStrings vector of datetime strings
@@ -128,9 +147,7 @@ namespace ioda {
    * \param[in]  VarSize Total number of elements in FromVar and ToVar.
    */
   template<typename FromType, typename ToType>
-  void ConvertVarType(const std::vector<FromType> & FromVar, std::vector<ToType> & ToVar) {
-    ToVar.resize(FromVar.size());
-
+  void ConvertVarType(gsl::span<const FromType> FromVar, gsl::span<ToType> ToVar) {
     std::string FromTypeName = TypeIdName(typeid(FromType));
     std::string ToTypeName = TypeIdName(typeid(ToType));
     const FromType FromMiss = util::missingValue(FromMiss);
@@ -149,6 +166,7 @@ namespace ioda {
                        (typeid(ToType) == typeid(double)));
 
     if (FromTypeOkay && ToTypeOkay) {
+      ASSERT(ToVar.size() >= FromVar.size());
       for (std::size_t i = 0; i < FromVar.size(); i++) {
         if (FromVar[i] == FromMiss) {
           ToVar[i] = ToMiss;
@@ -163,6 +181,12 @@ namespace ioda {
     }
   }
 
+  template<typename FromType, typename ToType>
+  void ConvertVarType(const std::vector<FromType> & FromVar, std::vector<ToType> & ToVar) {
+    ToVar.resize(FromVar.size());
+    ConvertVarType<FromType, ToType>(gsl::make_span(FromVar), gsl::make_span(ToVar));
+  }
+
 }  // namespace ioda
 
 #endif  // CORE_IODAUTILS_H_
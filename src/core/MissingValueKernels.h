@@ -0,0 +1,159 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef CORE_MISSINGVALUEKERNELS_H_
+#define CORE_MISSINGVALUEKERNELS_H_
+
+#include <cstddef>
+
+#include <gsl/gsl-lite.hpp>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace ioda {
+
+// Element-wise vector operations that propagate missing values: a result element is missing
+// whenever any of its input elements is missing, and is otherwise the plain arithmetic result.
+//
+// The loops are written without branches. Each element computes the arithmetic result on
+// operands in which missing values have been replaced by a harmless value (so that no
+// overflow or division by zero is raised), and then selects between that result and the
+// missing value. Compilers turn the selects into masked blends, so the loops vectorise for
+// whatever instruction set the build targets (SSE, AVX2, AVX-512, ...).
+
+/// \brief x = x + y
+template <typename T>
+void missingAwareAdd(gsl::span<T> x, gsl::span<const T> y, const T missing) {
+  ASSERT(x.size() == y.size());
+  T * const px = x.data();
+  const T * const py = y.data();
+  const std::size_t n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool isMissing = (px[i] == missing) | (py[i] == missing);
+    const T sum = px[i] + (isMissing ? T(0) : py[i]);
+    px[i] = isMissing ? missing : sum;
+  }
+}
+
+/// \brief x = x - y
+template <typename T>
+void missingAwareSubtract(gsl::span<T> x, gsl::span<const T> y, const T missing) {
+  ASSERT(x.size() == y.size());
+  T * const px = x.data();
+  const T * const py = y.data();
+  const std::size_t n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool isMissing = (px[i] == missing) | (py[i] == missing);
+    const T difference = px[i] - (isMissing ? T(0) : py[i]);
+    px[i] = isMissing ? missing : difference;
+  }
+}
+
+/// \brief x = x * y
+template <typename T>
+void missingAwareMultiply(gsl::span<T> x, gsl::span<const T> y, const T missing) {
+  ASSERT(x.size() == y.size());
+  T * const px = x.data();
+  const T * const py = y.data();
+  const std::size_t n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool isMissing = (px[i] == missing) | (py[i] == missing);
+    const T product = (isMissing ? T(0) : px[i]) * (isMissing ? T(0) : py[i]);
+    px[i] = isMissing ? missing : product;
+  }
+}
+
+/// \brief x = x / y
+template <typename T>
+void missingAwareDivide(gsl::span<T> x, gsl::span<const T> y, const T missing) {
+  ASSERT(x.size() == y.size());
+  T * const px = x.data();
+  const T * const py = y.data();
+  const std::size_t n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool isMissing = (px[i] == missing) | (py[i] == missing);
+    const T quotient = (isMissing ? T(0) : px[i]) / (isMissing ? T(1) : py[i]);
+    px[i] = isMissing ? missing : quotient;
+  }
+}
+
+/// \brief x = a * x
+template <typename T>
+void missingAwareScale(gsl::span<T> x, const T a, const T missing) {
+  T * const px = x.data();
+  const std::size_t n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool isMissing = (px[i] == missing);
+    const T product = a * (isMissing ? T(0) : px[i]);
+    px[i] = isMissing ? missing : product;
+  }
+}
+
+/// \brief x = x + a * y
+template <typename T>
+void missingAwareAxpy(gsl::span<T> x, const T a, gsl::span<const T> y, const T missing) {
+  ASSERT(x.size() == y.size());
+  T * const px = x.data();
+  const T * const py = y.data();
+  const std::size_t n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool isMissing = (px[i] == missing) | (py[i] == missing);
+    const T result = px[i] + a * (isMissing ? T(0) : py[i]);
+    px[i] = isMissing ? missing : result;
+  }
+}
+
+/// \brief x = x + a * y for vectors holding a.size() interleaved variables, where each
+///        variable has its own coefficient
+template <typename T>
+void missingAwareAxpy(gsl::span<T> x, gsl::span<const T> a, gsl::span<const T> y,
+                      const T missing) {
+  ASSERT(x.size() == y.size());
+  const std::size_t nvars = a.size();
+  if (nvars == 0) return;
+  ASSERT(x.size() % nvars == 0);
+  T * const px = x.data();
+  const T * const py = y.data();
+  const T * const pa = a.data();
+  const std::size_t nlocs = x.size() / nvars;
+  for (std::size_t jloc = 0; jloc < nlocs; ++jloc) {
+    for (std::size_t jvar = 0; jvar < nvars; ++jvar) {
+      const std::size_t i = jloc * nvars + jvar;
+      const bool isMissing = (px[i] == missing) | (py[i] == missing);
+      const T result = px[i] + pa[jvar] * (isMissing ? T(0) : py[i]);
+      px[i] = isMissing ? missing : result;
+    }
+  }
+}
+
+/// \brief x = 1 / x
+template <typename T>
+void missingAwareInvert(gsl::span<T> x, const T missing) {
+  T * const px = x.data();
+  const std::size_t n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool isMissing = (px[i] == missing);
+    const T inverse = T(1) / (isMissing ? T(1) : px[i]);
+    px[i] = isMissing ? missing : inverse;
+  }
+}
+
+/// \brief set x to missing wherever mask is missing
+template <typename T>
+void missingAwareMask(gsl::span<T> x, gsl::span<const T> mask, const T missing) {
+  ASSERT(x.size() == mask.size());
+  T * const px = x.data();
+  const T * const pm = mask.data();
+  const std::size_t n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    px[i] = (pm[i] == missing) ? missing : px[i];
+  }
+}
+
+}  // namespace ioda
+
+#endif  // CORE_MISSINGVALUEKERNELS_H_
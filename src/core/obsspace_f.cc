@@ -121,9 +121,7 @@ void obsspace_get_int32_f(const ObsSpace & obss, const char * group, const char
   ASSERT(len_cs <= obss.nchans());
   std::vector<int> chanSelect(len_cs);
   chanSelect.assign(chan_select, chan_select + len_cs);
-  std::vector<int32_t> vdata(length);
-  obss.get_db(std::string(group), std::string(vname), vdata, chanSelect);
-  std::copy(vdata.begin(), vdata.end(), vec);
+  obss.get_db(std::string(group), std::string(vname), gsl::make_span(vec, length), chanSelect);
 }
 // -----------------------------------------------------------------------------
 void obsspace_get_int64_f(const ObsSpace & obss, const char * group, const char * vname,
@@ -143,9 +141,7 @@ void obsspace_get_real32_f(const ObsSpace & obss, const char * group, const char
   ASSERT(len_cs <= obss.nchans());
   std::vector<int> chanSelect(len_cs);
   chanSelect.assign(chan_select, chan_select + len_cs);
-  std::vector<float> vdata(length);
-  obss.get_db(std::string(group), std::string(vname), vdata, chanSelect);
-  std::copy(vdata.begin(), vdata.end(), vec);
+  obss.get_db(std::string(group), std::string(vname), gsl::make_span(vec, length), chanSelect);
 }
 // -----------------------------------------------------------------------------
 void obsspace_get_real64_f(const ObsSpace & obss, const char * group, const char * vname,
@@ -154,9 +150,7 @@ void obsspace_get_real64_f(const ObsSpace & obss, const char * group, const char
   ASSERT(len_cs <= obss.nchans());
   std::vector<int> chanSelect(len_cs);
   chanSelect.assign(chan_select, chan_select + len_cs);
-  std::vector<double> vdata(length);
-  obss.get_db(std::string(group), std::string(vname), vdata, chanSelect);
-  std::copy(vdata.begin(), vdata.end(), vec);
+  obss.get_db(std::string(group), std::string(vname), gsl::make_span(vec, length), chanSelect);
 }
 // -----------------------------------------------------------------------------
 void obsspace_get_datetime_f(const ObsSpace & obss, const char * group, const char * vname,
@@ -170,7 +164,7 @@ void obsspace_get_datetime_f(const ObsSpace & obss, const char * group, const ch
   // vector which are then returned.
   util::DateTime temp_dt("0000-01-01T00:00:00Z");
   std::vector<util::DateTime> dt_vect(length, temp_dt);
-  obss.get_db(std::string(group), std::string(vname), dt_vect, chanSelect);
+  obss.get_db(std::string(group), std::string(vname), gsl::make_span(dt_vect), chanSelect);
 
   // Convert to date and time values. The DateTime utilities can return year, month,
   // day, hour, minute second.
@@ -199,9 +193,7 @@ void obsspace_get_bool_f(const ObsSpace & obss, const char * group, const char *
   ASSERT(len_cs <= obss.nchans());
   std::vector<int> chanSelect(len_cs);
   chanSelect.assign(chan_select, chan_select + len_cs);
-  std::vector<bool> vdata(length);
-  obss.get_db(std::string(group), std::string(vname), vdata, chanSelect);
-  std::copy(vdata.begin(), vdata.end(), vec);
+  obss.get_db(std::string(group), std::string(vname), gsl::make_span(vec, length), chanSelect);
 }
 // -----------------------------------------------------------------------------
 void obsspace_put_int32_f(ObsSpace & obss, const char * group, const char * vname,
@@ -218,10 +210,8 @@ void obsspace_put_int32_f(ObsSpace & obss, const char * group, const char * vnam
       numElements *= obss.get_dim_size(dimId);
   }
 
-  std::vector<int32_t> vdata;
-  vdata.assign(vec, vec + length);
-
-  obss.put_db(std::string(group), std::string(vname), vdata, dimList);
+  obss.put_db(std::string(group), std::string(vname),
+              gsl::span<const int32_t>(vec, length), dimList);
 }
 // -----------------------------------------------------------------------------
 void obsspace_put_int64_f(ObsSpace & obss, const char * group, const char * vname,
@@ -258,10 +248,8 @@ void obsspace_put_real32_f(ObsSpace & obss, const char * group, const char * vna
       numElements *= obss.get_dim_size(dimId);
   }
 
-  std::vector<float> vdata;
-  vdata.assign(vec, vec + length);
-
-  obss.put_db(std::string(group), std::string(vname), vdata, dimList);
+  obss.put_db(std::string(group), std::string(vname),
+              gsl::span<const float>(vec, length), dimList);
 }
 // -----------------------------------------------------------------------------
 void obsspace_put_real64_f(ObsSpace & obss, const char * group, const char * vname,
@@ -278,10 +266,8 @@ void obsspace_put_real64_f(ObsSpace & obss, const char * group, const char * vna
       numElements *= obss.get_dim_size(dimId);
   }
 
-  std::vector<double> vdata;
-  vdata.assign(vec, vec + length);
-
-  obss.put_db(std::string(group), std::string(vname), vdata, dimList);
+  obss.put_db(std::string(group), std::string(vname),
+              gsl::span<const double>(vec, length), dimList);
 }
 // -----------------------------------------------------------------------------
 void obsspace_put_bool_f(ObsSpace & obss, const char * group, const char * vname,
@@ -298,10 +284,8 @@ void obsspace_put_bool_f(ObsSpace & obss, const char * group, const char * vname
       numElements *= obss.get_dim_size(dimId);
   }
 
-  std::vector<bool> vdata;
-  vdata.assign(vec, vec + length);
-
-  obss.put_db(std::string(group), std::string(vname), vdata, dimList);
+  obss.put_db(std::string(group), std::string(vname),
+              gsl::span<const bool>(vec, length), dimList);
 }
 // -----------------------------------------------------------------------------
 int obsspace_get_location_dim_id_f() {
@@ -26,4 +26,23 @@ Distribution::~Distribution() {
   oops::Log::trace() << "Distribtion destructed" << std::endl;
 }
 
+// -----------------------------------------------------------------------------
+
+void Distribution::patchObsRuns(std::size_t nlocs,
+                                std::vector<std::pair<std::size_t, std::size_t>> & runs) const {
+  std::vector<bool> isPatchObs(nlocs);
+  patchObs(isPatchObs);
+  runs.clear();
+  std::size_t loc = 0;
+  while (loc < nlocs) {
+    if (!isPatchObs[loc]) {
+      ++loc;
+      continue;
+    }
+    const std::size_t start = loc;
+    while (loc < nlocs && isPatchObs[loc]) ++loc;
+    runs.emplace_back(start, loc - start);
+  }
+}
+
 }  // namespace ioda
@@ -9,6 +9,7 @@
 #define DISTRIBUTION_DISTRIBUTION_H_
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "eckit/config/Configuration.h"
@@ -107,6 +108,21 @@ class Distribution {
      */
     virtual void patchObs(std::vector<bool> & isPatchObs) const = 0;
 
+    /*!
+     * \brief Lists the "patch obs" as runs of consecutive locations.
+     *
+     * \param nlocs Number of locations on this PE.
+     * \param[out] patchObsRuns (start, count) pairs in increasing order of start, covering the
+     * patch obs and nothing else.
+     *
+     * The default implementation derives the runs from patchObs(). Distributions that know the
+     * runs without building the vector of flags (e.g. because all locations are patch obs)
+     * override it.
+     */
+    virtual void patchObsRuns(std::size_t nlocs,
+                              std::vector<std::pair<std::size_t, std::size_t>> & patchObsRuns)
+                              const;
+
     /*!
      * \brief Calculates the global minimum (over all locations on all PEs) of a
      * location-dependent quantity.
@@ -227,6 +243,9 @@ class Distribution {
     /// Accessor to MPI rank
     size_t rank() const {return comm_.rank();}
 
+    /// Accessor to the MPI communicator
+    const eckit::mpi::Comm & comm() const {return comm_;}
+
  private:
   /*!
    * \brief Create an object that can be used to calculate the sum of a location-dependent
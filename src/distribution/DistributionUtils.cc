@@ -12,6 +12,7 @@
 #include "ioda/distribution/InefficientDistribution.h"
 #include "ioda/distribution/ReplicaOfNonoverlappingDistribution.h"
 #include "ioda/distribution/ReplicaOfGeneralDistribution.h"
+#include "ioda/distribution/ReproducibleSum.h"
 
 #include "oops/util/DateTime.h"
 #include "oops/util/missingValues.h"
@@ -39,24 +40,47 @@ std::size_t globalNumNonMissingObsImpl(const Distribution &dist,
   return accumulator->computeResult();
 }
 
+/// Contribution of the location whose first element is `element` to the dot product.
+template <typename T>
+double dotProductTerm(std::size_t numVariables, const std::vector<T> &v1,
+                      const std::vector<T> &v2, std::size_t element, const T missingValue) {
+  double term = 0;
+  // Branch-free so that the loop vectorises; see core/MissingValueKernels.h.
+  for (size_t var = 0; var < numVariables; ++var, ++element) {
+    const bool isMissing = (v1[element] == missingValue) | (v2[element] == missingValue);
+    term += (isMissing ? T(0) : v1[element]) * (isMissing ? T(0) : v2[element]);
+  }
+  return term;
+}
+
 template <typename T>
 double dotProductImpl(const Distribution &dist,
                       std::size_t numVariables,
                       const std::vector<T> &v1,
-                      const std::vector<T> &v2) {
+                      const std::vector<T> &v2,
+                      bool reproducible) {
   ASSERT(v1.size() == v2.size());
   const T missingValue = util::missingValue(missingValue);
   const std::size_t numLocations = v1.size() / numVariables;
 
+  if (reproducible) {
+    // The terms of each location are computed in the same order whatever the distribution,
+    // and ReproducibleSum makes the sum over locations independent of the order of addition.
+    std::vector<bool> isPatchObs(numLocations);
+    dist.patchObs(isPatchObs);
+    ReproducibleSum sum;
+    for (size_t loc = 0; loc < numLocations; ++loc)
+      if (isPatchObs[loc])
+        sum.add(dotProductTerm(numVariables, v1, v2, loc * numVariables, missingValue));
+    sum.allReduceInPlace(dist.comm());
+    return sum.value();
+  }
+
   // Local reduction
   std::unique_ptr<Accumulator<double>> accumulator = dist.createAccumulator<double>();
-  for (size_t loc = 0, element = 0; loc < numLocations; ++loc) {
-    double term = 0;
-    for (size_t var = 0; var < numVariables; ++var, ++element)
-      if (v1[element] != missingValue && v2[element] != missingValue)
-        term += v1[element] * v2[element];
-    accumulator->addTerm(loc, term);
-  }
+  for (size_t loc = 0; loc < numLocations; ++loc)
+    accumulator->addTerm(loc, dotProductTerm(numVariables, v1, v2, loc * numVariables,
+                                             missingValue));
   // Global reduction
   return accumulator->computeResult();
 }
@@ -67,29 +91,33 @@ double dotProductImpl(const Distribution &dist,
 double dotProduct(const Distribution &dist,
                   std::size_t numVariables,
                   const std::vector<double> &v1,
-                  const std::vector<double> &v2) {
-  return dotProductImpl(dist, numVariables, v1, v2);
+                  const std::vector<double> &v2,
+                  bool reproducible) {
+  return dotProductImpl(dist, numVariables, v1, v2, reproducible);
 }
 
 double dotProduct(const Distribution &dist,
                   std::size_t numVariables,
                   const std::vector<float> &v1,
-                  const std::vector<float> &v2) {
-  return dotProductImpl(dist, numVariables, v1, v2);
+                  const std::vector<float> &v2,
+                  bool reproducible) {
+  return dotProductImpl(dist, numVariables, v1, v2, reproducible);
 }
 
 double dotProduct(const Distribution &dist,
                   std::size_t numVariables,
                   const std::vector<int> &v1,
-                  const std::vector<int> &v2) {
-  return dotProductImpl(dist, numVariables, v1, v2);
+                  const std::vector<int> &v2,
+                  bool reproducible) {
+  return dotProductImpl(dist, numVariables, v1, v2, reproducible);
 }
 
 double dotProduct(const Distribution &dist,
                   std::size_t numVariables,
                   const std::vector<int64_t> &v1,
-                  const std::vector<int64_t> &v2) {
-  return dotProductImpl(dist, numVariables, v1, v2);
+                  const std::vector<int64_t> &v2,
+                  bool reproducible) {
+  return dotProductImpl(dist, numVariables, v1, v2, reproducible);
 }
 
 // -----------------------------------------------------------------------------
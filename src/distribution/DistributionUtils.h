@@ -37,19 +37,29 @@ class Distribution;
 ///   i.e. the observation of variable `ivar` at location `iloc` in the halo of the calling MPI
 ///   rank should be stored in element `(iloc * numVariables + ivar)` of each vector.
 ///
+/// \param reproducible
+///   If true, the contributions of the locations are summed exactly (see ReproducibleSum), so
+///   that the result is bitwise identical whatever the number of MPI ranks and the distribution.
+///   This is somewhat slower than the default summation, whose result depends on the order in
+///   which the contributions are added.
+///
 /// \return The dot product of the two vectors, with observations taken at locations belonging to
 /// the halos of multiple MPI ranks counted only once and any missing values treated as if they
 /// were zeros.
 ///
 /// \relates Distribution
 double dotProduct(const Distribution &dist, std::size_t numVariables,
-                  const std::vector<double> &v1, const std::vector<double> &v2);
+                  const std::vector<double> &v1, const std::vector<double> &v2,
+                  bool reproducible = false);
 double dotProduct(const Distribution &dist, std::size_t numVariables,
-                  const std::vector<float> &v1, const std::vector<float> &v2);
+                  const std::vector<float> &v1, const std::vector<float> &v2,
+                  bool reproducible = false);
 double dotProduct(const Distribution &dist, std::size_t numVariables,
-                  const std::vector<int> &v1, const std::vector<int> &v2);
+                  const std::vector<int> &v1, const std::vector<int> &v2,
+                  bool reproducible = false);
 double dotProduct(const Distribution &dist, std::size_t numVariables,
-                  const std::vector<int64_t> &v1, const std::vector<int64_t> &v2);
+                  const std::vector<int64_t> &v1, const std::vector<int64_t> &v2,
+                  bool reproducible = false);
 
 /// \brief Counts unique non-missing observations in a vector.
 ///
@@ -112,8 +112,8 @@ bool Halo::isMyRecord(std::size_t RecNum) const {
 // -----------------------------------------------------------------------------
 void Halo::computePatchLocs() {
   // define some constants for this PE
-  double inf = std::numeric_limits<double>::infinity();
-  size_t myRank = comm_.rank();
+  const size_t myRank = comm_.rank();
+  const size_t nranks = comm_.size();
 
   // All records have now been assigned, so this container is no longer needed.
   recordsOutsideHalo_.clear();
@@ -125,55 +125,59 @@ void Halo::computePatchLocs() {
   comm_.allReduceInPlace(nglocs, eckit::mpi::max());
 
   if ( nglocs > 0 ) {
-    // make structures holding pairs of {distance,rank} for reduce operation later
-    // initialize the local array to dist == inf
-    std::vector<std::pair<double, int>> dist_and_lidx_loc(nglocs);
-    std::vector<std::pair<double, int>> dist_and_lidx_glb(nglocs);
-    for ( size_t jj = 0; jj < nglocs; ++jj ) {
-      dist_and_lidx_loc[jj] = std::make_pair(inf, myRank);
-    }
-
-    // assign actual distances to local obs (stored in haloLocVector_)
+    // The PE owning a location as a patch obs is the one holding it at the minimum
+    // distance from its center. This is resolved on a "directory" PE for each location,
+    // so that no PE needs storage proportional to the global number of locations.
+    // The global location indices are split into contiguous blocks, one per directory PE,
+    // which lets the directory PEs number the patch obs in increasing location order.
+    const size_t blockSize = (nglocs + nranks - 1) / nranks;
+
+    // send {location, distance} pairs of the locations held on this PE to their directory PEs
+    std::vector<std::vector<size_t>> sendLocs(nranks);
+    std::vector<std::vector<double>> sendDists(nranks);
     for (size_t loc = 0; loc < haloLocVector_.size(); ++loc) {
       const size_t gloc = haloLocVector_[loc];
       const size_t recNum = haloLocRecords_[loc];
-      const double dist = recordDistancesFromCenter_.at(recNum);
-      dist_and_lidx_loc[gloc] = std::make_pair(dist, myRank);
-    }
-
-    // use reduce operation to find PE rank with minimal distance
-    comm_.allReduce(dist_and_lidx_loc, dist_and_lidx_glb, eckit::mpi::minloc());
-
-    // ids of patch observations owned by this PE
-    std::unordered_set<std::size_t> patchObsLoc;
-
-    // if this PE has the minimum distance then this PE owns this ob. as patch
-    for (auto i : haloLocVector_) {
-      if ( dist_and_lidx_glb[i].second == myRank ) {
-        patchObsLoc.insert(i);
-      }
+      const size_t dirRank = gloc / blockSize;
+      sendLocs[dirRank].push_back(gloc);
+      sendDists[dirRank].push_back(recordDistancesFromCenter_.at(recNum));
     }
+    std::vector<std::vector<size_t>> dirLocs;
+    std::vector<std::vector<double>> dirDists;
+    comm_.allToAll(sendLocs, dirLocs);
+    comm_.allToAll(sendDists, dirDists);
+    recordDistancesFromCenter_.clear();
+    haloLocRecords_.clear();
+    haloLocRecords_.shrink_to_fit();
 
-    // convert storage from unodered sets to a bool vector
-    for (size_t jj = 0; jj < haloLocVector_.size(); ++jj) {
-      if ( patchObsLoc.count(haloLocVector_[jj]) ) {
-        patchObsBool_.push_back(true);
-      } else {
-        patchObsBool_.push_back(false);
-      }
+    // resolve the owners and the global unique consecutive indices of the locations
+    // in this PE's block, and send them back to the PEs holding those locations
+    std::vector<std::vector<size_t>> dirOwners;
+    std::vector<std::vector<size_t>> dirIndices;
+    resolvePatchOwners(dirLocs, dirDists, dirOwners, dirIndices);
+    dirLocs.clear();
+    dirDists.clear();
+
+    std::vector<std::vector<size_t>> recvOwners;
+    std::vector<std::vector<size_t>> recvIndices;
+    comm_.allToAll(dirOwners, recvOwners);
+    comm_.allToAll(dirIndices, recvIndices);
+
+    // the replies from each directory PE come back in the order the locations were sent
+    patchObsBool_.reserve(haloLocVector_.size());
+    globalUniqueConsecutiveLocIndices_.reserve(haloLocVector_.size());
+    std::vector<size_t> replyPos(nranks, 0);
+    for (auto gloc : haloLocVector_) {
+      const size_t dirRank = gloc / blockSize;
+      const size_t pos = replyPos[dirRank]++;
+      patchObsBool_.push_back(recvOwners[dirRank][pos] == myRank);
+      globalUniqueConsecutiveLocIndices_.push_back(recvIndices[dirRank][pos]);
     }
 
     size_t npatchobs = std::count(patchObsBool_.begin(), patchObsBool_.end(), true);
     oops::Log::debug() << "npatchobs: " << npatchobs << std::endl;
     oops::Log::debug() << "patchObsBool_.size(): " << patchObsBool_.size() << std::endl;
 
-    // now that we have patchObsBool_ computed we can free memory occupied by some temp objects
-    recordDistancesFromCenter_.clear();
-    haloLocRecords_.clear();
-    haloLocRecords_.shrink_to_fit();
-
-    computeGlobalUniqueConsecutiveLocIndices(dist_and_lidx_glb);
-
     // and now the remaining temp object
     haloLocVector_.clear();
     haloLocVector_.shrink_to_fit();
@@ -181,48 +185,91 @@ void Halo::computePatchLocs() {
 }
 
 // -----------------------------------------------------------------------------
-void Halo::computeGlobalUniqueConsecutiveLocIndices(
-    const std::vector<std::pair<double, int>> &dist_and_lidx_glb) {
-  const double inf = std::numeric_limits<double>::infinity();
-
-  globalUniqueConsecutiveLocIndices_.reserve(haloLocVector_.size());
-
-  // Step 0: enable quick checks of whether a location belongs to this rank's halo.
-  std::unordered_set<size_t> haloLocSet(haloLocVector_.begin(), haloLocVector_.end());
-
-  // Step 1: index patch observations owned by each rank consecutively (starting from 0 on each
-  // rank). For each observation i held on this rank, set globalConsecutiveLocIndices_[i] to
-  // the index of the corresponding patch observation on the rank that owns it.
-  std::vector<size_t> patchObsCountOnRank(comm_.size(), 0);
-  for (size_t gloc = 0, nglocs = dist_and_lidx_glb.size(); gloc < nglocs; ++gloc) {
-    if (dist_and_lidx_glb[gloc].first < inf) {
-      // This obs is held on at least one rank (this won't be the case e.g. for observations
-      // outside the assimilation window)
-      const size_t rankOwningPatchObs = dist_and_lidx_glb[gloc].second;
-      if (haloLocSet.find(gloc) != haloLocSet.end()) {
-        // This obs is held on the current PE (but not necessarily as a patch obs)
-        globalUniqueConsecutiveLocIndices_.push_back(patchObsCountOnRank[rankOwningPatchObs]);
-      }
-      ++patchObsCountOnRank[rankOwningPatchObs];
+void Halo::resolvePatchOwners(const std::vector<std::vector<size_t>> & dirLocs,
+                              const std::vector<std::vector<double>> & dirDists,
+                              std::vector<std::vector<size_t>> & dirOwners,
+                              std::vector<std::vector<size_t>> & dirIndices) const {
+  const size_t nranks = comm_.size();
+
+  // Step 1: sort the {location, distance, rank} entries received by this directory PE.
+  // The first entry of each location then identifies the owning PE: the one with the minimum
+  // distance, with ties going to the lowest rank (matching the MPI MINLOC reduction).
+  struct LocEntry {
+    size_t gloc;
+    double dist;
+    size_t rank;
+    size_t pos;
+  };
+  std::vector<LocEntry> entries;
+  size_t nentries = 0;
+  for (size_t rank = 0; rank < nranks; ++rank) nentries += dirLocs[rank].size();
+  entries.reserve(nentries);
+  for (size_t rank = 0; rank < nranks; ++rank) {
+    for (size_t pos = 0; pos < dirLocs[rank].size(); ++pos) {
+      entries.push_back({dirLocs[rank][pos], dirDists[rank][pos], rank, pos});
     }
   }
+  std::sort(entries.begin(), entries.end(), [](const LocEntry & a, const LocEntry & b) {
+    if (a.gloc != b.gloc) return a.gloc < b.gloc;
+    if (a.dist != b.dist) return a.dist < b.dist;
+    return a.rank < b.rank;
+  });
+
+  // Step 2: index the patch observations owned by each PE consecutively within the block
+  // of this directory PE (in increasing location order).
+  dirOwners.assign(nranks, std::vector<size_t>());
+  dirIndices.assign(nranks, std::vector<size_t>());
+  for (size_t rank = 0; rank < nranks; ++rank) {
+    dirOwners[rank].resize(dirLocs[rank].size());
+    dirIndices[rank].resize(dirLocs[rank].size());
+  }
+  std::vector<size_t> patchObsCountInBlock(nranks, 0);
+  for (size_t first = 0; first < entries.size(); ) {
+    const size_t owner = entries[first].rank;
+    const size_t index = patchObsCountInBlock[owner]++;
+    size_t last = first;
+    for (; last < entries.size() && entries[last].gloc == entries[first].gloc; ++last) {
+      dirOwners[entries[last].rank][entries[last].pos] = owner;
+      dirIndices[entries[last].rank][entries[last].pos] = index;
+    }
+    first = last;
+  }
 
-  // Step 2: make indices of patch observations globally unique by incrementing the index
-  // of each patch observation held by rank r by the total number of patch observations owned
-  // by ranks r' < r.
-
-  // Perform an exclusive scan
-  std::vector<size_t> patchObsCountOnPreviousRanks(patchObsCountOnRank.size(), 0);
-  for (size_t rank = 1; rank < patchObsCountOnRank.size(); ++rank) {
+  // Step 3: make the indices globally unique. The patch obs owned by rank r in this block
+  // are preceded by those owned by ranks r' < r, and by those owned by rank r in the blocks
+  // of directory PEs d' < d. Each owner receives its per-block counts, scans them and sends
+  // back the offset of each block.
+  std::vector<std::vector<size_t>> sendCounts(nranks);
+  for (size_t rank = 0; rank < nranks; ++rank) {
+    sendCounts[rank].assign(1, patchObsCountInBlock[rank]);
+  }
+  std::vector<std::vector<size_t>> ownerCounts;
+  comm_.allToAll(sendCounts, ownerCounts);
+
+  size_t patchObsCountOnRank = 0;
+  std::vector<std::vector<size_t>> sendBlockOffsets(nranks);
+  for (size_t dirRank = 0; dirRank < nranks; ++dirRank) {
+    sendBlockOffsets[dirRank].assign(1, patchObsCountOnRank);
+    patchObsCountOnRank += ownerCounts[dirRank][0];
+  }
+  std::vector<std::vector<size_t>> blockOffsets;
+  comm_.allToAll(sendBlockOffsets, blockOffsets);
+
+  // Perform an exclusive scan of the patch obs counts of all ranks
+  std::vector<size_t> allPatchObsCounts(nranks);
+  comm_.allGather(patchObsCountOnRank, allPatchObsCounts.begin(), allPatchObsCounts.end());
+  std::vector<size_t> patchObsCountOnPreviousRanks(nranks, 0);
+  for (size_t rank = 1; rank < nranks; ++rank) {
     patchObsCountOnPreviousRanks[rank] =
-        patchObsCountOnPreviousRanks[rank - 1] + patchObsCountOnRank[rank - 1];
+        patchObsCountOnPreviousRanks[rank - 1] + allPatchObsCounts[rank - 1];
   }
 
   // Increment patch observation indices
-  for (size_t loc = 0; loc < globalUniqueConsecutiveLocIndices_.size(); ++loc) {
-    const size_t gloc = haloLocVector_[loc];
-    const size_t rankOwningPatchObs = dist_and_lidx_glb[gloc].second;
-    globalUniqueConsecutiveLocIndices_[loc] += patchObsCountOnPreviousRanks[rankOwningPatchObs];
+  for (size_t rank = 0; rank < nranks; ++rank) {
+    for (size_t pos = 0; pos < dirIndices[rank].size(); ++pos) {
+      const size_t owner = dirOwners[rank][pos];
+      dirIndices[rank][pos] += patchObsCountOnPreviousRanks[owner] + blockOffsets[owner][0];
+    }
   }
 }
 
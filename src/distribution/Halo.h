@@ -122,8 +122,13 @@ class Halo: public Distribution {
      template <typename T>
      void allGathervImpl(std::vector<T> &x) const;
 
-     void computeGlobalUniqueConsecutiveLocIndices(
-         const std::vector<std::pair<double, int>> &dist_and_lidx_glb);
+     // Called on each directory PE with the locations (and their distances) sent by each PE.
+     // Returns, in the same layout, the owning PE and the global unique consecutive index
+     // of each of these locations.
+     void resolvePatchOwners(const std::vector<std::vector<size_t>> &dirLocs,
+                             const std::vector<std::vector<double>> &dirDists,
+                             std::vector<std::vector<size_t>> &dirOwners,
+                             std::vector<std::vector<size_t>> &dirIndices) const;
 
      double radius_;
      eckit::geometry::Point2 center_;
@@ -48,6 +48,14 @@ void InefficientDistribution::patchObs(std::vector<bool> & patchObsVec) const {
   }
 }
 
+// -----------------------------------------------------------------------------
+void InefficientDistribution::patchObsRuns(
+    std::size_t nlocs, std::vector<std::pair<std::size_t, std::size_t>> & runs) const {
+  // only rank 0 owns the obs
+  runs.clear();
+  if (comm_.rank() == 0 && nlocs > 0) runs.emplace_back(0, nlocs);
+}
+
 // -----------------------------------------------------------------------------
 std::unique_ptr<Accumulator<int>>
 InefficientDistribution::createAccumulatorImpl(int init) const {
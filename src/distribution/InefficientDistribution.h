@@ -8,6 +8,7 @@
 #ifndef DISTRIBUTION_INEFFICIENTDISTRIBUTION_H_
 #define DISTRIBUTION_INEFFICIENTDISTRIBUTION_H_
 
+#include <utility>
 #include <vector>
 
 #include "eckit/mpi/Comm.h"
@@ -40,6 +41,8 @@ class InefficientDistribution: public Distribution {
      bool isMyRecord(std::size_t RecNum) const override {return true;};
 
      void patchObs(std::vector<bool> &) const override;
+     void patchObsRuns(std::size_t nlocs,
+                       std::vector<std::pair<std::size_t, std::size_t>> & runs) const override;
 
      // The min and max reductions do nothing for the inefficient distribution. Each processor has
      // all observations, so the local reduction is equal to the global reduction.
@@ -52,6 +52,14 @@ void NonoverlappingDistribution::patchObs(std::vector<bool> & patchObsVec) const
   std::fill(patchObsVec.begin(), patchObsVec.end(), true);
 }
 
+// -----------------------------------------------------------------------------
+void NonoverlappingDistribution::patchObsRuns(
+    std::size_t nlocs, std::vector<std::pair<std::size_t, std::size_t>> & runs) const {
+  // all locations are patch obs
+  runs.clear();
+  if (nlocs > 0) runs.emplace_back(0, nlocs);
+}
+
 // -----------------------------------------------------------------------------
 void NonoverlappingDistribution::min(int & x) const {
   minImpl(x);
@@ -8,6 +8,7 @@
 #ifndef DISTRIBUTION_NONOVERLAPPINGDISTRIBUTION_H_
 #define DISTRIBUTION_NONOVERLAPPINGDISTRIBUTION_H_
 
+#include <utility>
 #include <vector>
 
 #include "eckit/mpi/Comm.h"
@@ -32,6 +33,8 @@ class NonoverlappingDistribution : public Distribution {
     void assignRecord(const std::size_t RecNum, const std::size_t LocNum,
                       const eckit::geometry::Point2 & point) override;
     void patchObs(std::vector<bool> & patchObsVec) const override;
+    void patchObsRuns(std::size_t nlocs,
+                      std::vector<std::pair<std::size_t, std::size_t>> & runs) const override;
     void computePatchLocs() override;
 
     void min(int & x) const override;
@@ -0,0 +1,122 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ioda/distribution/ReproducibleSum.h"
+
+#include <cmath>
+#include <cstdlib>
+
+#include "eckit/mpi/Comm.h"
+
+namespace ioda {
+
+namespace {
+
+/// Exponent of the least significant bit of the fixed-point representation: the smallest
+/// subnormal double is 2^-1074.
+constexpr int lsbExponent = -1074;
+constexpr int digitBits = 32;
+constexpr std::uint64_t digitMask = (std::uint64_t(1) << digitBits) - 1;
+constexpr std::int64_t digitBase = std::int64_t(1) << digitBits;
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+ReproducibleSum::ReproducibleSum() : nonFinite_(0.0), pendingAdds_(0) {
+  digits_.fill(0);
+}
+
+// -----------------------------------------------------------------------------
+void ReproducibleSum::add(const double x) {
+  if (x == 0.0) return;
+  if (!std::isfinite(x)) {
+    nonFinite_ += x;
+    return;
+  }
+
+  // x = mantissa * 2^(exponent - 53) with mantissa a 53-bit integer, both exactly.
+  int exponent;
+  const double fraction = std::frexp(x, &exponent);
+  const std::int64_t mantissa = static_cast<std::int64_t>(std::ldexp(fraction, 53));
+  std::uint64_t magnitude = static_cast<std::uint64_t>(std::llabs(mantissa));
+  int bitPos = exponent - 53 - lsbExponent;
+  if (bitPos < 0) {
+    // Subnormal: the bits shifted out are zero.
+    magnitude >>= -bitPos;
+    bitPos = 0;
+  }
+
+  // Spread the (at most 53-bit) magnitude, shifted left by bitPos, over three digits.
+  const int digit = bitPos / digitBits;
+  const int shift = bitPos % digitBits;
+  const std::uint64_t low = (magnitude & digitMask) << shift;
+  const std::uint64_t high = (magnitude >> digitBits) << shift;
+  const std::int64_t d0 = static_cast<std::int64_t>(low & digitMask);
+  const std::int64_t d1 = static_cast<std::int64_t>((low >> digitBits) + (high & digitMask));
+  const std::int64_t d2 = static_cast<std::int64_t>(high >> digitBits);
+  if (mantissa < 0) {
+    digits_[digit] -= d0;
+    digits_[digit + 1] -= d1;
+    digits_[digit + 2] -= d2;
+  } else {
+    digits_[digit] += d0;
+    digits_[digit + 1] += d1;
+    digits_[digit + 2] += d2;
+  }
+
+  if (++pendingAdds_ == maxPendingAdds_) {
+    normalize(digits_);
+    pendingAdds_ = 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+void ReproducibleSum::allReduceInPlace(const eckit::mpi::Comm & comm) {
+  // Normalized digits are below 2^32, so the sum over tasks cannot overflow.
+  normalize(digits_);
+  comm.allReduceInPlace(digits_.begin(), digits_.end(), eckit::mpi::sum());
+  normalize(digits_);
+  pendingAdds_ = 0;
+  comm.allReduceInPlace(nonFinite_, eckit::mpi::sum());
+}
+
+// -----------------------------------------------------------------------------
+double ReproducibleSum::value() const {
+  if (nonFinite_ != 0.0 || std::isnan(nonFinite_)) return nonFinite_;
+
+  std::array<std::int64_t, numDigits_> digits = digits_;
+  normalize(digits);
+  const bool negative = digits[numDigits_ - 1] < 0;
+  if (negative) {
+    for (std::int64_t & d : digits) d = -d;
+    normalize(digits);
+  }
+
+  // All digits are now non-negative. Adding them from the most significant one down makes
+  // the rounding depend only on the (unique) normalized digits.
+  double result = 0.0;
+  for (int i = numDigits_ - 1; i >= 0; --i) {
+    if (digits[i] != 0)
+      result += std::ldexp(static_cast<double>(digits[i]), i * digitBits + lsbExponent);
+  }
+  return negative ? -result : result;
+}
+
+// -----------------------------------------------------------------------------
+void ReproducibleSum::normalize(std::array<std::int64_t, numDigits_> & digits) {
+  for (int i = 0; i < numDigits_ - 1; ++i) {
+    // Floor division by 2^32, so that the remainder is non-negative.
+    std::int64_t carry = digits[i] / digitBase;
+    if (digits[i] - carry * digitBase < 0) --carry;
+    digits[i] -= carry * digitBase;
+    digits[i + 1] += carry;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+}  // namespace ioda
@@ -0,0 +1,63 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef DISTRIBUTION_REPRODUCIBLESUM_H_
+#define DISTRIBUTION_REPRODUCIBLESUM_H_
+
+#include <array>
+#include <cstdint>
+
+namespace eckit {
+namespace mpi {
+class Comm;
+}
+}
+
+namespace ioda {
+
+/// \brief Sum of doubles that does not depend on the order in which the terms are added.
+///
+/// Each term is converted exactly to a wide fixed-point number covering the whole range of
+/// finite doubles, and the fixed-point numbers are added with integer arithmetic. Integer
+/// addition is associative, so the sum is the same whichever order the terms are added in
+/// and however they are spread over MPI tasks. The result is rounded to a double once, in
+/// value(). Infinite and NaN terms are carried separately and dominate the result.
+///
+/// The fixed-point number is held as 32-bit digits stored in 64-bit integers, which leaves
+/// room to add many terms before the carries need to be propagated.
+class ReproducibleSum {
+ public:
+  ReproducibleSum();
+
+  /// \brief Add the term x to the sum.
+  void add(double x);
+
+  /// \brief Add the sums held on all tasks of comm. On return every task holds the global sum.
+  void allReduceInPlace(const eckit::mpi::Comm & comm);
+
+  /// \brief Return the sum rounded to a double.
+  double value() const;
+
+ private:
+  /// Number of 32-bit digits. Enough to hold any finite double (2098 bits including
+  /// subnormals) with headroom for the carries of a sum of very many terms.
+  static constexpr int numDigits_ = 70;
+  /// Number of additions after which the carries are propagated.
+  static constexpr std::int64_t maxPendingAdds_ = std::int64_t(1) << 29;
+
+  /// \brief Propagate the carries so that all digits except the most significant one lie in
+  ///        [0, 2^32). The most significant digit holds the sign of the sum.
+  static void normalize(std::array<std::int64_t, numDigits_> & digits);
+
+  std::array<std::int64_t, numDigits_> digits_;
+  double nonFinite_;
+  std::int64_t pendingAdds_;
+};
+
+}  // namespace ioda
+
+#endif  // DISTRIBUTION_REPRODUCIBLESUM_H_
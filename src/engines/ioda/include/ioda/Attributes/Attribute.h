@@ -256,7 +256,7 @@ public:
 
       detail::PointerOwner pointerOwner = getTypeProvider()->getReturnedPointerOwner();
       Marshaller m(pointerOwner);
-      auto p = m.prep_deserialize(numObjects);
+      auto p = detail::prep_deserialize(m, data);
       read(gsl::make_span<char>(reinterpret_cast<char*>(p->DataPointers.data()),
                                 p->DataPointers.size() * Marshaller::bytesPerElement_),
            TypeWrapper::GetType(getTypeProvider()));
@@ -65,6 +65,30 @@ enum class BackendOpenModes {
   Read_Write  ///< Open the file in read-write mode.
 };
 
+/// \brief HDF5 cache and file space settings applied when a file is opened or created.
+/// \ingroup ioda_cxx_engines_pub
+/// \details A value of zero (or a negative w0) keeps the HDF5 library default.
+struct Hdf5FileTuning {
+  /// Size in bytes of the raw data chunk cache of each variable. When zero and the file
+  /// is opened read-only, each chunked variable gets a cache sized to hold its chunks
+  /// covering one range of locations, within a limit per variable and per file.
+  std::size_t chunkCacheBytes = 0;
+  /// Number of hash slots in the raw data chunk cache
+  std::size_t chunkCacheSlots = 0;
+  /// Chunk preemption policy, between 0 and 1 (1 evicts fully read chunks first)
+  double chunkCacheW0 = -1.0;
+  /// Page size in bytes for paged file space aggregation (new files only)
+  std::size_t fileSpacePageSize = 0;
+  /// Size in bytes of the page buffer (files with paged file space, serial access only).
+  /// It must hold at least one page.
+  std::size_t pageBufferBytes = 0;
+  /// Minimum size in bytes of the blocks allocated for metadata
+  std::size_t metaBlockSize = 0;
+  /// Evict the metadata of an object from the cache when the object is closed
+  /// (serial access only)
+  bool evictOnClose = false;
+};
+
 /// \brief Used to specify backend creation-time properties
 /// \ingroup ioda_cxx_engines_pub
 struct BackendCreationParameters {
@@ -81,6 +105,7 @@ public:
   MPI_Comm comm;
   std::size_t allocBytes;
   bool flush;
+  Hdf5FileTuning hdf5Tuning;
   /// @}
 
   BackendCreationParameters() { }
@@ -0,0 +1,67 @@
+#pragma once
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <cstddef>
+
+#include "ioda/Engines/EngineUtils.h"
+
+#include "oops/util/parameters/OptionalParameter.h"
+#include "oops/util/parameters/Parameter.h"
+#include "oops/util/parameters/Parameters.h"
+
+namespace ioda {
+namespace Engines {
+
+//----------------------------------------------------------------------------------------
+// HDF5 cache settings shared by the H5File reader and writer
+//----------------------------------------------------------------------------------------
+
+class H5FileTuningParameters : public oops::Parameters {
+    OOPS_CONCRETE_PARAMETERS(H5FileTuningParameters, Parameters)
+
+  public:
+    /// \brief Size in bytes of the raw data chunk cache of each variable
+    /// \details When not set, the reader sizes the cache of each chunked variable from
+    /// its chunks, starting from the HDF5 default (1 MiB) and within a limit per
+    /// variable and per file. A size given here is used for every variable as is.
+    oops::Parameter<std::size_t> chunkCacheSize{"chunk cache size", 0, this};
+
+    /// \brief Number of hash slots in the raw data chunk cache
+    oops::Parameter<std::size_t> chunkCacheSlots{"chunk cache slots", 0, this};
+
+    /// \brief Chunk preemption policy, between 0 and 1 (1 evicts fully read chunks first)
+    oops::OptionalParameter<double> chunkCacheW0{"chunk cache w0", this};
+
+    /// \brief Size in bytes of the page buffer
+    /// \details Only used for files with paged file space: the reader checks the file
+    /// space of the input file, and the writer uses it when "file space page size" is set.
+    /// It must hold at least one page. Ignored when the writer creates one file in parallel.
+    oops::Parameter<std::size_t> pageBufferSize{"page buffer size", 0, this};
+
+    /// \brief Minimum size in bytes of the blocks allocated for metadata
+    oops::Parameter<std::size_t> metaBlockSize{"metadata block size", 0, this};
+
+    /// \brief Evict the metadata of a variable from the cache when it is closed
+    /// \details Ignored when the writer creates one file in parallel.
+    oops::Parameter<bool> evictOnClose{"evict on close", false, this};
+
+    /// \brief Copy the settings into the backend creation parameters
+    void setTuning(Hdf5FileTuning & tuning) const {
+        tuning.chunkCacheBytes = chunkCacheSize;
+        tuning.chunkCacheSlots = chunkCacheSlots;
+        if (chunkCacheW0.value() != boost::none) {
+            tuning.chunkCacheW0 = *chunkCacheW0.value();
+        }
+        tuning.pageBufferBytes = pageBufferSize;
+        tuning.metaBlockSize = metaBlockSize;
+        tuning.evictOnClose = evictOnClose;
+    }
+};
+
+}  // namespace Engines
+}  // namespace ioda
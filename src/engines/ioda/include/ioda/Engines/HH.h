@@ -18,6 +18,7 @@
 #include <mpi.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "../defs.h"
 #include "Capabilities.h"
@@ -44,6 +45,11 @@ typedef std::pair<HDF5_Version, HDF5_Version> HDF5_Version_Range;
 /// \ingroup ioda_cxx_engines_pub_HH
 IODA_DL HDF5_Version_Range defaultVersionRange();
 
+/// \brief True if the HDF5 library can write filtered (eg compressed) variables in
+///   parallel. This needs collective writes and HDF5 1.10.2 or later.
+/// \ingroup ioda_cxx_engines_pub_HH
+IODA_DL bool haveParallelFilteredWrites();
+
 /// \brief Convenience function to generate a random file name.
 /// \see createMemoryFile
 /// \ingroup ioda_cxx_engines_pub_HH
@@ -69,8 +75,10 @@ IODA_DL Group createFile(const std::string& filename, BackendCreateModes mode,
 /// \param mode is the creation mode.
 /// \param compat is the range of HDF5 versions that should be able to access this file.
 /// \param comm is the MPI communicator group
+/// \param tuning holds the HDF5 cache and file space settings.
 IODA_DL Group createParallelFile(const std::string& filename, BackendCreateModes mode,
-              const MPI_Comm mpiComm, HDF5_Version_Range compat = defaultVersionRange());
+              const MPI_Comm mpiComm, HDF5_Version_Range compat = defaultVersionRange(),
+              const Hdf5FileTuning& tuning = Hdf5FileTuning());
 
 /// \brief Create a ioda::Group backed by an HDF5 file (with either serial or parallel access).
 /// \ingroup ioda_cxx_engines_pub_HH
@@ -79,8 +87,10 @@ IODA_DL Group createParallelFile(const std::string& filename, BackendCreateModes
 /// \param compat is the range of HDF5 versions that should be able to access this file.
 /// \param mpiComm is the MPI communicator group (for parallel access)
 /// \param isParallelIo when true create the file for parallel access (by all ranks in comm)
+/// \param tuning holds the HDF5 cache and file space settings.
 IODA_DL Group createFileImpl(const std::string& filename, BackendCreateModes mode,
-              HDF5_Version_Range compat, const MPI_Comm mpiComm, const bool isParallelIo);
+              HDF5_Version_Range compat, const MPI_Comm mpiComm, const bool isParallelIo,
+              const Hdf5FileTuning& tuning = Hdf5FileTuning());
 
 /// \brief Open a ioda::Group backed by an HDF5 file.
 /// \ingroup ioda_cxx_engines_pub_HH
@@ -90,6 +100,15 @@ IODA_DL Group createFileImpl(const std::string& filename, BackendCreateModes mod
 IODA_DL Group openFile(const std::string& filename, BackendOpenModes mode,
                        HDF5_Version_Range compat = defaultVersionRange());
 
+/// \brief Open a ioda::Group backed by an HDF5 file, with HDF5 cache settings.
+/// \ingroup ioda_cxx_engines_pub_HH
+/// \param filename is the file name.
+/// \param mode is the access mode.
+/// \param compat is the range of HDF5 versions that should be able to access this file.
+/// \param tuning holds the HDF5 cache settings.
+IODA_DL Group openFileImpl(const std::string& filename, BackendOpenModes mode,
+                           HDF5_Version_Range compat, const Hdf5FileTuning& tuning);
+
 /// \brief Create a ioda::Group backed by the HDF5 in-memory-store.
 /// \ingroup ioda_cxx_engines_pub_HH
 /// \param filename is the name of the file if it gets flushed
@@ -134,6 +153,25 @@ IODA_DL Group openMemoryFile(const std::string& filename,
                              bool flush_on_close = false, size_t increment_len_bytes = 1000000,
                              HDF5_Version_Range compat = defaultVersionRange());
 
+/// \brief Open a ioda::Group backed by the HDF5 in-memory-store, initialized from a file image.
+/// \ingroup ioda_cxx_engines_pub_HH
+/// \param filename is a unique identifier for the in-memory store.
+/// \param image is the file image, typically obtained from getFileImage on another process.
+/// \param increment_len_bytes is the length (in bytes) of additional memory
+///   allocations if the image grows.
+/// \param compat is the range of HDF5 versions that should be able to access this file.
+/// \details The image is copied, so the caller may release it once this function returns.
+IODA_DL Group openMemoryFileImage(const std::string& filename, const std::vector<char>& image,
+                                  size_t increment_len_bytes = 1000000,
+                                  HDF5_Version_Range compat = defaultVersionRange());
+
+/// \brief Retrieve the file image of a ioda::Group backed by HDF5.
+/// \ingroup ioda_cxx_engines_pub_HH
+/// \param grp is any group in the file (typically the root group of an in-memory file).
+/// \details The image holds the entire file, and can be shipped to another process
+///   (eg, via MPI) and reopened there with openMemoryFileImage.
+IODA_DL std::vector<char> getFileImage(const Group& grp);
+
 /// \brief Get capabilities of the HDF5 file-backed engine
 /// \ingroup ioda_cxx_engines_pub_HH
 IODA_DL Capabilities getCapabilitiesFileEngine();
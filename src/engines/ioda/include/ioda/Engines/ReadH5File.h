@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "ioda/Engines/H5FileTuningParameters.h"
 #include "ioda/Engines/ReaderBase.h"
 
 namespace ioda {
@@ -26,6 +27,9 @@ class ReadH5FileParameters : public ReaderParametersBase {
   public:
     /// \brief Path to input file
     oops::RequiredParameter<std::string> fileName{"obsfile", this};
+
+    /// \brief HDF5 cache settings
+    H5FileTuningParameters tuning{this};
 };
 
 // Classes
@@ -6,9 +6,10 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <cstddef>
 #include <string>
 
-#include "ioda/Engines/ReaderBase.h"  // For the flen string to vlen string workaround
+#include "ioda/Engines/H5FileTuningParameters.h"
 #include "ioda/Engines/WriterBase.h"
 #include "ioda/Engines/WriterFactory.h"
 
@@ -25,7 +26,13 @@ class WriteH5FileParameters : public WriterParametersBase {
     OOPS_CONCRETE_PARAMETERS(WriteH5FileParameters, WriterParametersBase)
 
   public:
-    /// Empty for now, but still serves as a concretization of the abstract base class
+    /// \brief Page size in bytes for paged file space aggregation
+    /// \details With paging, the metadata and raw data are laid out in pages that can be
+    /// held in the page buffer when the file is read. The default is no paging.
+    oops::Parameter<std::size_t> fileSpacePageSize{"file space page size", 0, this};
+
+    /// \brief HDF5 cache settings
+    H5FileTuningParameters tuning{this};
 };
 
 // Classes
@@ -67,37 +74,18 @@ class WriteH5Proc : public WriterProcBase {
   /// \brief engine parameters
   Parameters_ params_;
 
-  /// \brief generate the names of the files for the post-processor workaround
-  /// \param finalFileName is the name for the file that is written by the
-  /// post-processor workaround
-  /// \param tempFileName is the name for the file (written by the ioda writer) that
-  /// is being read by the post-processor workaround
-  void workaroundGenFileNames(std::string & finalFileName, std::string & tempFileName);
+  /// \brief generate the name of the file (written by the ioda writer) that is updated
+  /// by the post-processor workaround
+  /// \param fileName is the name of the output file, uniquified in the same manner as
+  /// the writer backend
+  void workaroundGenFileName(std::string & fileName);
 
   /// \brief run the post-processor workaround (change fixed length strings to
   /// variable length strings)
-  /// \param finalFileName is the name for the file that is written by the
-  /// post-processor workaround
-  /// \param tempFileName is the name for the file (written by the ioda writer) that
-  /// is being read by the post-processor workaround
-  void workaroundFixToVarLenStrings(const std::string & finalFileName,
-                                    const std::string & tempFileName);
-
-};
-
-/// \brief parameters for opening the file (written by the idoa writer) for reading
-/// in the post-processor
-class WorkaroundReaderParameters : public oops::Parameters {
-  OOPS_CONCRETE_PARAMETERS(WorkaroundReaderParameters, Parameters)
- public:
-  oops::RequiredParameter<Engines::ReaderParametersWrapper> engine{"engine", this};
-};
-
-/// \brief parameters for opening the new output file created in the post-processor
-class WorkaroundWriterParameters : public oops::Parameters {
-  OOPS_CONCRETE_PARAMETERS(WorkaroundWriterParameters, Parameters)
- public:
-  oops::RequiredParameter<Engines::WriterParametersWrapper> engine{"engine", this};
+  /// \details The file is updated in place. Only the fixed length string variables are
+  /// rewritten, the other variables are not touched.
+  /// \param fileName is the name of the file (written by the ioda writer) being updated
+  void workaroundFixToVarLenStrings(const std::string & fileName);
 };
 
 }  // namespace Engines
@@ -54,7 +54,7 @@ public:
   IoPoolBase(const oops::Parameter<IoPoolParameters> & ioPoolParams,
              const eckit::mpi::Comm & commAll, const eckit::mpi::Comm & commTime,
              const util::DateTime & winStart, const util::DateTime & winEnd);
-  ~IoPoolBase();
+  virtual ~IoPoolBase();
 
   /// \brief return nlocs for this object
   int nlocs() const { return nlocs_; }
@@ -172,6 +172,9 @@ protected:
   /// commands.
   std::vector<std::pair<int, int>> rank_assignment_;
 
+  /// \brief true when this object holds the split communicator groups made by createIoPool
+  bool owns_pool_comms_;
+
   /// \brief set the pool size (number of MPI processes) for this instance
   /// \detail This function sets the data member target_pool_size_ to the minumum of
   /// the specified maximum pool size or the size of the comm_all_ communicator group.
@@ -182,7 +185,7 @@ protected:
   /// shows how to form the io pool and how to assign the non io pool ranks to each
   /// of the ranks in the io pool.
   /// \param rankGrouping structure that maps ranks outside the pool to ranks in the pool
-  virtual void groupRanks(IoPoolGroupMap & rankGrouping) = 0;
+  void groupRanks(IoPoolGroupMap & rankGrouping);
 
   /// \brief assign ranks in the comm_all_ comm group to each of the ranks in the io pool
   /// \detail This function will dole out the ranks within the comm_all_ group, that are
@@ -191,8 +194,7 @@ protected:
   /// comm_all_ group will have a list of all the ranks that the send to or receive from.
   /// \param nlocs number of locations on this MPI rank
   /// \param rankGrouping structure that maps ranks outside the pool to ranks in the pool
-  virtual void assignRanksToIoPool(const std::size_t nlocs,
-                                   const IoPoolGroupMap & rankGrouping) = 0;
+  void assignRanksToIoPool(const std::size_t nlocs, const IoPoolGroupMap & rankGrouping);
 
   /// \brief create the io pool communicator group
   /// \detail This function will create the io pool communicator group using the eckit
@@ -202,6 +204,12 @@ protected:
   /// \param rankGrouping structure that maps ranks outside the pool to ranks in the pool
   void createIoPool(IoPoolGroupMap & rankGrouping);
 
+  /// \brief delete the io pool communicator groups
+  /// \detail This function deletes the eckit split communicator groups made by createIoPool.
+  /// It does nothing if this object did not create them or has already deleted them, so
+  /// it is safe to call from both finalize and the destructor.
+  void deleteIoPool();
+
   /// \brief collect nlocs from assigned ranks and compute total for this rank
   /// \detail For each of the ranks in the io pool, this function collects nlocs from
   /// all of the assigned ranks and sums up them up to get the total nlocs for each
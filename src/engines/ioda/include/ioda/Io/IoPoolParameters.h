@@ -40,6 +40,8 @@ class IoPoolParameters : public oops::Parameters {
     oops::Parameter<int> maxPoolSize{"max pool size", -1, this};
 
     /// chunk size in bytes
+    /// For compressed output, this is the target size of the chunks of the variables
+    /// dimensioned by Location. The default is 1 MiB.
     oops::OptionalParameter<std::size_t> chunkSize{"chunk size", this};
 
     /// chunk cache size in bytes
@@ -51,6 +53,25 @@ class IoPoolParameters : public oops::Parameters {
     /// write multiple files (write one file per io pool task)
     /// default is false meaning a single output file will be written
     oops::Parameter<bool> writeMultipleFiles{"write multiple files", false, this};
+
+    /// gzip compression level (1 fastest to 9 smallest) for the output variables
+    /// dimensioned by Location. The default, 0, writes uncompressed output.
+    oops::Parameter<int> compressionLevel{"compression level", 0, this};
+
+    /// byte-shuffle compressed variables before compressing them
+    oops::Parameter<bool> shuffle{"shuffle", true, this};
+
+    /// use collective MPI-IO when writing a single file in parallel. Collective writes are
+    /// always used for compressed output.
+    oops::Parameter<bool> collectiveWrite{"collective write", false, this};
+
+    /// send the numeric Location variables to the io pool ranks in batches, one message
+    /// per batch, instead of one set of messages per variable
+    oops::Parameter<bool> batchTransfers{"batch variable transfers", false, this};
+
+    /// upper limit in bytes on the memory an io pool rank uses for the batch receive
+    /// buffers. Two batches are in flight at a time, each holding up to half of the limit.
+    oops::Parameter<std::size_t> batchMemoryLimit{"batch memory limit", 268435456, this};
 };
 
 }  // namespace ioda
@@ -10,11 +10,12 @@
  * \ingroup ioda_cxx_api
  *
  * @{
- * \file IoPoolBase.h
+ * \file ReaderPool.h
  * \brief Interfaces for ioda::ReaderPool and related classes.
  */
 
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -38,8 +39,8 @@ namespace ioda {
 /// \brief Reader pool subclass
 /// \details This class holds a single io pool which consists of a small number of MPI tasks.
 /// The tasks assigned to an io pool object are selected from the total MPI tasks working on
-/// the DA run. The tasks in the pool are used to transfer data from memory to a
-/// ioda file. Only the tasks in the pool interact with the file and the remaining tasks outside
+/// the DA run. The tasks in the pool are used to transfer data from a ioda file to
+/// memory. Only the tasks in the pool interact with the file and the remaining tasks outside
 /// the pool interact with the pool tasks to get their individual pieces of the data being
 /// transferred.
 /// \ingroup ioda_cxx_io
@@ -60,6 +61,16 @@ public:
              const std::vector<std::string> & obsVarNames);
   ~ReaderPool();
 
+  /// \brief return the ranks (in the comm_all_ group) that make up the io pool
+  /// \details The ranks are listed in the order of their rank number in the pool
+  /// communicator group. This list is available on all ranks, not just the pool ranks.
+  const std::vector<int> & pool_ranks() const { return pool_ranks_; }
+
+  /// \brief create the backend reader engine
+  /// \details This function is to be called by all ranks. Only the ranks in the io pool
+  /// open the input obs source and the remaining ranks get a nullptr.
+  std::unique_ptr<Engines::ReaderBase> createReaderEngine();
+
   /// \brief save obs data to output file
   /// \param destGroup destination ioda group to be loaded from the input file
   void load(Group & destGroup);
@@ -67,7 +78,8 @@ public:
   /// \brief finalize the io pool before destruction
   /// \detail This routine is here to do specialized clean up after the load function has been
   /// called and before the destructor is called. The primary task is to clean up the eckit
-  /// split communicator groups.
+  /// split communicator groups. The destructor also cleans them up if finalize has not
+  /// been called, eg when the owner of the pool throws during its construction.
   void finalize() override;
 
   /// \brief fill in print routine for the util::Printable base class
@@ -84,22 +96,8 @@ private:
   /// \brief list of variable to be simulated (for the generator backends)
   const std::vector<std::string> & obs_var_names_;
 
-  /// \brief group ranks into sets for the io pool assignments
-  /// \detail This function will create a vector of vector of ints structure which
-  /// shows how to form the io pool and how to assign the non io pool ranks to each
-  /// of the ranks in the io pool.
-  /// \param rankGrouping structure that maps ranks outside the pool to ranks in the pool
-  void groupRanks(IoPoolGroupMap & rankGrouping) override;
-
-  /// \brief assign ranks in the comm_all_ comm group to each of the ranks in the io pool
-  /// \detail This function will dole out the ranks within the comm_all_ group, that are
-  /// not in the io pool, to the ranks that are in the io pool. This sets up the send/recv
-  /// communication for collecting the variable data. When finished, all ranks in the
-  /// comm_all_ group will have a list of all the ranks that the send to or receive from.
-  /// \param nlocs number of locations on this MPI rank
-  /// \param rankGrouping structure that maps ranks outside the pool to ranks in the pool
-  void assignRanksToIoPool(const std::size_t nlocs,
-                           const IoPoolGroupMap & rankGrouping) override;
+  /// \brief ranks (in the comm_all_ group) that make up the io pool
+  std::vector<int> pool_ranks_;
 };
 
 }  // namespace ioda
@@ -8,6 +8,11 @@
 /// \file ReaderUtils.h
 /// \brief Utilities for a ioda io reader backend
 
+#include <string>
+#include <vector>
+
+#include "eckit/mpi/Comm.h"
+
 #include "ioda/defs.h"
 
 namespace ioda {
@@ -22,4 +27,27 @@ namespace ioda {
 IODA_DL void ioReadGroup(const ioda::ReaderPool & ioPool, const ioda::Group& fileGroup,
                          ioda::Group& memGroup, const bool isParallelIo);
 
+/// @brief Pack a vector of strings into a lengths vector and a single character buffer
+/// @details This is the form used to transfer strings with MPI since it only takes
+/// two messages regardless of the number of strings.
+/// @param strings is the source vector of strings
+/// @param lengths is the length of each string
+/// @param chars is the concatenation of all of the strings
+IODA_DL void packStrings(const std::vector<std::string> & strings, std::vector<int> & lengths,
+                         std::vector<char> & chars);
+
+/// @brief Unpack a lengths vector and a character buffer into a vector of strings
+/// @param lengths is the length of each string
+/// @param chars is the concatenation of all of the strings
+/// @param strings is the destination vector of strings
+IODA_DL void unpackStrings(const std::vector<int> & lengths, const std::vector<char> & chars,
+                           std::vector<std::string> & strings);
+
+/// @brief Broadcast a vector of strings from the root rank
+/// @param comm is the MPI communicator group
+/// @param strings is the vector of strings, filled in on the non root ranks
+/// @param root is the rank doing the broadcast
+IODA_DL void broadcastStrings(const eckit::mpi::Comm & comm, std::vector<std::string> & strings,
+                              const int root);
+
 }  // namespace ioda
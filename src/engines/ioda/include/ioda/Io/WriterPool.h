@@ -53,21 +53,52 @@ public:
   /// \param commTime MPI "time" communicator group (tasks in current time bin for 4DEnVar)
   /// \param winStart DA timing window start
   /// \param winEnd DA timing window end
-  /// \param patchObsVec Boolean vector showing which locations belong to this MPI task
+  /// \param nlocs Number of locations held by this MPI task
+  /// \param patchObsRuns (start, count) runs of consecutive locations belonging to this
+  /// MPI task, in increasing order of start
   WriterPool(const oops::Parameter<IoPoolParameters> & ioPoolParams,
              const oops::RequiredPolymorphicParameter
                  <Engines::WriterParametersBase, Engines::WriterFactory> & writerParams,
              const eckit::mpi::Comm & commAll, const eckit::mpi::Comm & commTime,
              const util::DateTime & winStart, const util::DateTime & winEnd,
-             const std::vector<bool> & patchObsVec);
+             const std::size_t nlocs,
+             const std::vector<std::pair<std::size_t, std::size_t>> & patchObsRuns);
   ~WriterPool();
 
-  /// \brief return reference to the patch obs vector
-  const std::vector<bool> & patchObsVec() const { return patch_obs_vec_; }
+  /// \brief return reference to the runs of patch locations
+  const std::vector<std::pair<std::size_t, std::size_t>> & patchObsRuns() const {
+      return patch_obs_runs_;
+  }
+
+  /// \brief return true if all the locations held by this rank are patch locations
+  bool all_patch() const { return patch_nlocs_ == nlocs_; }
 
   /// \brief return the number of locations in the patch (ie owned) by this object
   int patch_nlocs() const { return patch_nlocs_; }
 
+  /// \brief return the gzip compression level for variables dimensioned by Location,
+  /// 0 meaning no compression
+  int compression_level() const { return compression_level_; }
+
+  /// \brief return true if compressed variables are byte-shuffled before compression
+  bool shuffle() const { return params_.value().shuffle; }
+
+  /// \brief return true if the Location variables are written with collective MPI-IO
+  bool collective_write() const { return collective_write_; }
+
+  /// \brief return true if the numeric Location variables are transferred in batches
+  bool batch_transfers() const { return params_.value().batchTransfers; }
+
+  /// \brief return the limit in bytes on the memory used for the batch receive buffers
+  std::size_t batch_memory_limit() const { return params_.value().batchMemoryLimit; }
+
+  /// \brief return the number of locations in a chunk of a Location variable whose
+  /// elements (locations times the sizes of the other dimensions) take elementBytes bytes
+  /// \details When writing a single file in parallel, the chunk length divides the
+  /// starting location of every pool rank where possible, so that the chunks do not
+  /// straddle two ranks' blocks of locations.
+  Dimensions_t locationChunkSize(const std::size_t elementBytes) const;
+
   /// \brief save obs data to output file
   /// \param srcGroup source ioda group to be saved into the output file
   void save(const Group & srcGroup);
@@ -89,11 +120,22 @@ private:
   /// \brief mulitiple files flag, true -> will be creating a set of output files
   bool create_multiple_files_;
 
-  /// \brief patch vector for this rank
-  /// \details The patch vector shows which locations are owned by this rank
+  /// \brief gzip compression level for the Location variables (0 -> no compression)
+  int compression_level_;
+
+  /// \brief collective write flag, true -> use collective MPI-IO for Location variables
+  bool collective_write_;
+
+  /// \brief greatest common divisor of the starting locations of the pool ranks
+  /// \details Chunk lengths that divide this value keep the chunks aligned to the
+  /// block of locations each pool rank writes.
+  std::size_t chunk_alignment_;
+
+  /// \brief runs of patch locations for this rank
+  /// \details The runs show which locations are owned by this rank
   /// as opposed to locations that are duplicates of a neighboring rank. This is relavent
   /// for distributions like Halo where the halo regions can overlap.
-  const std::vector<bool> & patch_obs_vec_;
+  const std::vector<std::pair<std::size_t, std::size_t>> & patch_obs_runs_;
 
   /// \brief writer engine destination for printing (eg, output file name)
   std::string writerDest_;
@@ -101,22 +143,9 @@ private:
   /// \brief pre-/post-processor object associated with the writer engine.
   std::shared_ptr<Engines::WriterProcBase> writer_proc_;
 
-  /// \brief group ranks into sets for the io pool assignments
-  /// \detail This function will create a vector of vector of ints structure which
-  /// shows how to form the io pool and how to assign the non io pool ranks to each
-  /// of the ranks in the io pool.
-  /// \param rankGrouping structure that maps ranks outside the pool to ranks in the pool
-  void groupRanks(IoPoolGroupMap & rankGrouping) override;
-
-  /// \brief assign ranks in the comm_all_ comm group to each of the ranks in the io pool
-  /// \detail This function will dole out the ranks within the comm_all_ group, that are
-  /// not in the io pool, to the ranks that are in the io pool. This sets up the send/recv
-  /// communication for collecting the variable data. When finished, all ranks in the
-  /// comm_all_ group will have a list of all the ranks that the send to or receive from.
-  /// \param nlocs number of locations on this MPI rank
-  /// \param rankGrouping structure that maps ranks outside the pool to ranks in the pool
-  void assignRanksToIoPool(const std::size_t nlocs,
-                           const IoPoolGroupMap & rankGrouping) override;
+  /// \brief set the compression and collective write settings and the chunk alignment
+  /// \detail Only the ranks in the io pool need these settings.
+  void setCompressionInfo();
 };
 
 }  // namespace ioda
@@ -50,15 +50,14 @@ public:
   /// @brief Convert data to the specified units.
   /// @param to represents the desired units. Must be compatible with the current units (e.g. you can convert kilograms to grams, but not to meters).
   /// @throws ioda::Exception if the units are nonconvertible.
-  /// @note This function triggers an expression evaluation. It limits performance somewhat, but it is okay for now.
-  ///       In the future, we could visit the Galilean transformation in udunits and
-  ///       extract the scaling factors ourselves.
+  /// @note This function triggers an expression evaluation. Affine conversions (the common case)
+  ///       are applied directly on the evaluated data. Others go through udunits.
   auto asUnits(const udunits::Units &to) const {
     auto converter = units.getConverterTo(to);
     Eigen::Array<ScalarType, Eigen::Dynamic, Eigen::Dynamic> to_vals;
     to_vals.resizeLike(data);
-    converter->template tconvert<ScalarType>(data.data(), (size_t)data.size(), to_vals.data());
-    to_vals = (data != missingValue).select(to_vals, missingValue);
+    converter->template tconvert<ScalarType>(data.data(), (size_t)data.size(), to_vals.data(),
+                                             missingValue);
 
     return EigenMath<decltype(to_vals)>(std::move(to_vals), to, missingValue);
   }
@@ -10,7 +10,6 @@
 
 #include "ioda/defs.h"
 
-#include <functional>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -18,38 +17,20 @@
 namespace ioda {
 namespace detail {
 
-inline double celsiusToKelvin(double temp) {
-  return temp + 273.15;
-}
-
-inline double knotsToMetersPerSecond(double knots) {
-  return knots * 0.514444;
-}
-
-inline double percentageToFraction(double percentage) {
-  return percentage * 0.01;
-}
-
-inline double hectopascalToPascal(double hPa) {
-  return hPa * 100;
-}
-
-inline double degreesToRadians(double deg) {
-  return deg * .0174533;
-}
-
-inline double oktaToFraction(double okta) {
-  return okta * .125;
-}
+/// All of the conversions to SI are affine: SI value = scale * value + offset.
+struct AffineUnitConversion {
+  double scale;
+  double offset;
+};
 
 /// @todo Move to source file.
-const std::unordered_map<std::string, std::function<double(double)>> unitConversionEquations {
-  {"celsius", celsiusToKelvin},
-  {"knot", knotsToMetersPerSecond},
-  {"percentage", percentageToFraction},
-  {"hectopascal", hectopascalToPascal},
-  {"degree", degreesToRadians},
-  {"okta", oktaToFraction}
+const std::unordered_map<std::string, AffineUnitConversion> unitConversionEquations {
+  {"celsius", {1.0, 273.15}},
+  {"knot", {0.514444, 0.0}},
+  {"percentage", {0.01, 0.0}},
+  {"hectopascal", {100.0, 0.0}},
+  {"degree", {.0174533, 0.0}},
+  {"okta", {.125, 0.0}}
 };
 
 /// @todo Move to source file.
@@ -65,5 +46,13 @@ const std::unordered_map<std::string, std::string> equivalentSIUnit {
 } // namespace detail
 
 IODA_DL void convertColumn(const std::string &unit, std::vector<double> &dataToConvert);
+/// Converts the values in place, leaving the missing values untouched.
+IODA_DL void convertColumn(const std::string &unit, std::vector<double> &dataToConvert,
+                           double missingValue);
+IODA_DL void convertColumn(const std::string &unit, std::vector<float> &dataToConvert,
+                           float missingValue);
+/// Integer values are rounded to the nearest integer after conversion.
+IODA_DL void convertColumn(const std::string &unit, std::vector<int> &dataToConvert,
+                           int missingValue);
 IODA_DL std::string getSIUnit(const std::string &unit);
 } // namespace ioda
@@ -12,6 +12,7 @@
  * \brief Interfaces for ioda::ObsGroup and related classes.
  */
 
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -68,6 +69,20 @@ public:
   ///
   void resize(const std::vector<std::pair<Variable, ioda::Dimensions_t>>& newDims);
 
+  /// \brief Reserve storage for a Dimension and every Variable that
+  ///   depends on it to grow to the given size.
+  /// \details This is a hint for backends that hold the data in memory, so that
+  ///   a Dimension grown in many steps (e.g. one frame at a time) is not
+  ///   reallocated at every step. The dimension sizes do not change.
+  /// \param capacityDims is a vector of pairs of the Dimension and the size
+  ///   to reserve storage for.
+  void reserve(const std::vector<std::pair<Variable, ioda::Dimensions_t>>& capacityDims);
+
+  /// \brief Release the storage reserved beyond the current dimensions of every Variable.
+  /// \details Call once the Dimensions have stopped growing, to give back what reserve
+  ///   and the growth of the storage allocated ahead.
+  void shrinkToFit();
+
 private:
   /// \brief recusively visit all groups and resize variables according
   /// to newDims.
@@ -76,6 +91,15 @@ private:
   static void resizeVars(Group& g,
                          const std::vector<std::pair<Variable, ioda::Dimensions_t>>& newDims);
 
+  /// \brief recusively visit all groups and call varFunc on each variable (except
+  /// dimension scales) with its dimensions updated according to newDims.
+  /// \param group Current group in traversal
+  /// \param newDims Vector of pairs of Dimension and new size
+  /// \param varFunc Function called with the variable and its updated dimensions
+  static void visitDependentVars(
+    Group& g, const std::vector<std::pair<Variable, ioda::Dimensions_t>>& newDims,
+    const std::function<void(Variable&, const std::vector<Dimensions_t>&)>& varFunc);
+
   /// Create ObsGroup objects
   void setup(const NewDimensionScales_t& fundamentalDims,
              std::shared_ptr<const detail::DataLayoutPolicy> layout);
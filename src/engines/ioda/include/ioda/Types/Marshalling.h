@@ -59,6 +59,17 @@ struct Marshalled_Data {
   }
 };
 
+/// \brief Structure used to pass the caller's own buffer between the frontend and the
+///   backend engine, without copying.
+/// \details Presents the same DataPointers interface as Marshalled_Data, so the
+///   Variable and Attribute read / write functions treat both alike.
+/// \ingroup ioda_internals_engines_types
+template <class value_type>
+struct Marshalled_Data_View {
+  gsl::span<value_type> DataPointers;
+  explicit Marshalled_Data_View(gsl::span<value_type> data) : DataPointers(data) {}
+};
+
 namespace detail {
 /// \note We want character streams, and these void* types are horribly hacked :-(
 ///   Using void* because we want to preserve a semantic difference between
@@ -114,6 +125,62 @@ public:
   }
 };
 
+/// \brief Zero-copy accessor for fundamental types.
+/// \details The in-memory representation of these types is exactly what the backend
+///   reads and writes, so the caller's buffer is handed straight to the backend instead
+///   of being copied into (or out of) a temporary vector.
+/// \note long double is excluded because its padding bytes must be zeroed before
+///   being handed to HDF5 (see Object_Accessor_Regular::serialize).
+/// \ingroup ioda_internals_engines_types
+template <class DataType>
+struct Object_Accessor_Trivial {
+  static_assert(std::is_trivially_copyable<DataType>::value,
+                "Object_Accessor_Trivial requires a trivially copyable type.");
+  typedef typename std::remove_const<DataType>::type mutable_DataType;
+  static constexpr size_t bytesPerElement_ = sizeof(mutable_DataType);
+
+  typedef std::shared_ptr<Marshalled_Data_View<mutable_DataType>> serialized_type;
+  typedef std::shared_ptr<const Marshalled_Data_View<const mutable_DataType>>
+    const_serialized_type;
+
+public:
+  Object_Accessor_Trivial(detail::PointerOwner = detail::PointerOwner::Caller) {}
+  /// \brief Wraps the caller's data. Nothing is copied.
+  const_serialized_type serialize(::gsl::span<const DataType> d, const Has_Attributes* = nullptr) {
+    return std::make_shared<Marshalled_Data_View<const mutable_DataType>>(d);
+  }
+  /// \brief Wraps the caller's buffer so that the backend reads directly into it.
+  serialized_type prep_deserialize(gsl::span<DataType> data) {
+    return std::make_shared<Marshalled_Data_View<mutable_DataType>>(data);
+  }
+  /// \brief The data are already in place. Only check that the sizes agree.
+  void deserialize(serialized_type p, gsl::span<DataType> data, const Has_Attributes * = nullptr) {
+    const size_t ds = data.size(), dp = p->DataPointers.size();
+    if (ds != dp) throw Exception("ds != dp", ioda_Here());
+  }
+};
+
+/// \brief Prepare the buffer that the backend reads into.
+/// \details Accessors that can read directly into the caller's memory provide
+///   prep_deserialize(gsl::span<DataType>). All others allocate a buffer that
+///   holds numObjects objects.
+/// \ingroup ioda_internals_engines_types
+template <class Marshaller, class DataType>
+auto prep_deserialize(Marshaller& m, gsl::span<DataType> data, int)
+  -> decltype(m.prep_deserialize(data)) {
+  return m.prep_deserialize(data);
+}
+template <class Marshaller, class DataType>
+auto prep_deserialize(Marshaller& m, gsl::span<DataType> data, long)
+  -> decltype(m.prep_deserialize(static_cast<size_t>(data.size()))) {
+  return m.prep_deserialize(static_cast<size_t>(data.size()));
+}
+template <class Marshaller, class DataType>
+auto prep_deserialize(Marshaller& m, gsl::span<DataType> data)
+  -> decltype(prep_deserialize(m, data, 0)) {
+  return prep_deserialize(m, data, 0);
+}
+
 /// \ingroup ioda_internals_engines_types
 template <class DataType, class value_type = std::remove_pointer<std::decay<DataType>>>
 struct Object_Accessor_Fixed_Array {
@@ -305,9 +372,14 @@ struct Object_Accessor_Chrono_Time_Point_t {
 
 
 /// \ingroup ioda_cxx_types
+/// \details Fundamental types are passed to the backend without copying. Everything
+///   else goes through Object_Accessor_Regular.
 template <typename T>
 struct Object_AccessorTypedef {
-  typedef Object_Accessor_Regular<T> type;
+  typedef typename std::conditional<
+    std::is_arithmetic<T>::value
+      && !std::is_same<typename std::remove_cv<T>::type, long double>::value,
+    Object_Accessor_Trivial<T>, Object_Accessor_Regular<T>>::type type;
 };
 /// \ingroup ioda_cxx_types
 template <>
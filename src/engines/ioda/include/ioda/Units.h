@@ -8,8 +8,10 @@
 /*! @file Units.h
 * @brief UDUNITS-2 bindings and wrappers
 */
+#include <cmath>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace ioda {
@@ -21,20 +23,98 @@ struct udunits_interface_impl;
 struct udunits_units_impl;
 }  // end namespace detail
 
+namespace detail {
+/// @brief Casts a converted value back to T, rounding to the nearest integer for integral T.
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, T>::type castConverted(double val) {
+  return static_cast<T>(std::round(val));
+}
+template <class T>
+typename std::enable_if<!std::is_integral<T>::value, T>::type castConverted(double val) {
+  return static_cast<T>(val);
+}
+
+/// @brief Applies out = scale * in + offset. in and out may alias.
+/// @details Written as a simple loop over contiguous data so that the compiler can vectorize it.
+template <class T>
+void affineConvert(const T* in, size_t N, T* out, double scale, double offset) {
+  for (size_t i = 0; i < N; ++i)
+    out[i] = castConverted<T>(scale * static_cast<double>(in[i]) + offset);
+}
+
+/// @brief Applies out = scale * in + offset, passing missing values through unchanged.
+///   in and out may alias.
+template <class T>
+void affineConvert(const T* in, size_t N, T* out, double scale, double offset,
+                   const T missingValue) {
+  for (size_t i = 0; i < N; ++i) {
+    const T val = in[i];
+    const T cnv = castConverted<T>(scale * static_cast<double>(val) + offset);
+    out[i]      = (val == missingValue) ? val : cnv;
+  }
+}
+}  // end namespace detail
+
 class Converter {
 public:
   virtual ~Converter();
   virtual float* convert(const float* in, size_t N, float* out) const    = 0;
   virtual double* convert(const double* in, size_t N, double* out) const = 0;
 
+  /// @brief Is this an affine (scale + offset) conversion?
+  /// @details Nearly all of the conversions that we encounter (K <-> degC, Pa <-> hPa,
+  ///   knots <-> m/s, ...) are affine. These are applied directly, without going through udunits.
+  bool isAffine() const { return affine_; }
+  /// @brief The scale factor of an affine conversion.
+  double scale() const { return scale_; }
+  /// @brief The offset of an affine conversion.
+  double offset() const { return offset_; }
+
+  /// @brief Convert an array of any arithmetic type. val and out may alias.
   template <class T>
   T* tconvert(const T* val, size_t N, T* out) const {
+    if (affine_) {
+      detail::affineConvert(val, N, out, scale_, offset_);
+      return out;
+    }
+    std::vector<double> val_d(N), out_d(N);
+    for (size_t i = 0; i < N; ++i) val_d[i] = static_cast<double>(val[i]);
+    convert(val_d.data(), N, out_d.data());
+    for (size_t i = 0; i < N; ++i) out[i] = detail::castConverted<T>(out_d[i]);
+    return out;
+  }
+
+  /// @brief Convert an array of any arithmetic type, preserving missing values.
+  ///   val and out may alias.
+  template <class T>
+  T* tconvert(const T* val, size_t N, T* out, const T missingValue) const {
+    if (affine_) {
+      detail::affineConvert(val, N, out, scale_, offset_, missingValue);
+      return out;
+    }
     std::vector<double> val_d(N), out_d(N);
     for (size_t i = 0; i < N; ++i) val_d[i] = static_cast<double>(val[i]);
     convert(val_d.data(), N, out_d.data());
-    for (size_t i = 0; i < N; ++i) out[i] = static_cast<T>(out_d[i]);
+    for (size_t i = 0; i < N; ++i)
+      out[i] = (val[i] == missingValue) ? val[i] : detail::castConverted<T>(out_d[i]);
     return out;
   }
+
+  /// @brief Convert an array in place, preserving missing values.
+  template <class T>
+  T* convertInPlace(T* data, size_t N, const T missingValue) const {
+    return tconvert(data, N, data, missingValue);
+  }
+
+protected:
+  /// @brief Probes the conversion and records whether it is affine.
+  /// @details Must be called by derived classes once convert() is usable.
+  void detectAffine();
+
+private:
+  bool affine_   = false;
+  double scale_  = 1;
+  double offset_ = 0;
 };
 
 class UnitsInterface;
@@ -99,6 +99,7 @@ public:
 
   bool gzip_                        = false;
   bool szip_                        = false;
+  bool shuffle_                     = false;
   int gzip_level_                   = 6;  // 1 (fastest) - 9 (most compression)
   unsigned int szip_PixelsPerBlock_ = 16;
   unsigned int szip_options_        = 4;  // Defined as H5_SZIP_EC_OPTION_MASK in hdf5.h;
@@ -106,6 +107,8 @@ public:
   void noCompress();
   void compressWithGZIP(int level = 6);
   void compressWithSZIP(unsigned PixelsPerBlock = 16, unsigned options = 4);
+  /// Byte-shuffle the data before compressing it. Ignored when not compressing.
+  void setShuffle(bool shuffle = true);
 
   /// @}
   /// @name General Functions
@@ -264,6 +267,14 @@ public:
   ///   if you need recursion.
   inline std::vector<std::string> operator()() const { return list(); }
 
+  /// \brief A counter that changes whenever a Variable is removed or renamed anywhere in
+  ///   the tree of Groups that this container belongs to.
+  /// \details Callers that cache Variable handles can compare it with the value seen
+  ///   when the handles were cached, and drop them when it differs. Backends that do not
+  ///   track these changes return a new value on every call, so nothing cached against
+  ///   them is ever reused.
+  virtual std::size_t structureVersion() const;
+
   /// \brief Combines all complementary variables as specified in the mapping file, opens them,
   /// and optionally removes the originals from the ObsGroup.
   ///
@@ -196,6 +196,18 @@ public:
   /// \param newDims are the new dimensions.
   virtual Variable resize(const std::vector<Dimensions_t>& newDims);
 
+  /// \brief Reserve storage for the variable to grow to the given dimensions.
+  /// \details This is a hint that avoids repeated reallocation when a variable
+  ///   is grown in many steps. It does not change the dimensions. Backends that
+  ///   do not hold the data in memory ignore it.
+  /// \param capacityDims are the dimensions to reserve storage for.
+  virtual void reserve(const std::vector<Dimensions_t>& capacityDims);
+
+  /// \brief Release storage reserved beyond the current dimensions.
+  /// \details The counterpart of reserve, for when a variable has stopped growing.
+  ///   Backends that do not hold the data in memory ignore it.
+  virtual void shrinkToFit();
+
   /// Attach a dimension scale to this Variable.
   virtual Variable attachDimensionScale(unsigned int DimensionNumber, const Variable& scale);
   /// Detach a dimension scale
@@ -268,6 +280,13 @@ public:
   virtual Variable parallelWrite(gsl::span<const char> data, const Type& in_memory_dataType,
                                  const Selection& mem_selection  = Selection::all,
                                  const Selection& file_selection = Selection::all);
+  /// \brief Parallel write in which all tasks of the file's communicator take part.
+  /// \details Every task must call this for the variable, with an empty selection if it
+  ///   has nothing to write. Required for writing filtered (eg compressed) variables in
+  ///   parallel.
+  virtual Variable collectiveWrite(gsl::span<const char> data, const Type& in_memory_dataType,
+                                   const Selection& mem_selection  = Selection::all,
+                                   const Selection& file_selection = Selection::all);
 
   /// \brief Write the Variable
   /// \note Ensure that the correct dimension ordering is preserved.
@@ -397,6 +416,22 @@ public:
       std::throw_with_nested(Exception(ioda_Here()));
     }
   }
+  template <class DataType, class Marshaller = Object_Accessor<DataType>,
+            class TypeWrapper = Types::GetType_Wrapper<DataType>>
+  Variable_Implementation collectiveWrite(const std::vector<DataType>& data,
+                                          const Selection& mem_selection  = Selection::all,
+                                          const Selection& file_selection = Selection::all) {
+    try {
+      Marshaller m;
+      auto d = m.serialize(gsl::make_span(data), &atts);
+      return collectiveWrite(gsl::make_span<const char>(
+                      reinterpret_cast<const char*>(d->DataPointers.data()),
+                     d->DataPointers.size() * Marshaller::bytesPerElement_),
+                   TypeWrapper::GetType(getTypeProvider()), mem_selection, file_selection);
+    } catch (...) {
+      std::throw_with_nested(Exception(ioda_Here()));
+    }
+  }
 
   /// \brief Write an Eigen object (a Matrix, an Array, a Block, a Map).
   /// \tparam EigenClass is the type of the Eigen object being written.
@@ -520,11 +555,9 @@ public:
                                const Selection& mem_selection  = Selection::all,
                                const Selection& file_selection = Selection::all) const {
     try {
-      const size_t numObjects = data.size();
-
       detail::PointerOwner pointerOwner = getTypeProvider()->getReturnedPointerOwner();
       Marshaller m(pointerOwner);
-      auto p = m.prep_deserialize(numObjects);
+      auto p = detail::prep_deserialize(m, data);
       read(gsl::make_span<char>(
              reinterpret_cast<char*>(p->DataPointers.data()),
              // Logic note: sizeof mutable data type. If we are
@@ -237,15 +237,20 @@ Group constructBackend(BackendNames name, BackendCreationParameters& params) {
   Group backend;
   if (name == BackendNames::Hdf5File) {
     if (params.action == BackendFileActions::Open) {
-      return HH::openFile(params.fileName, params.openMode);
+      return HH::openFileImpl(params.fileName, params.openMode, HH::defaultVersionRange(),
+                              params.hdf5Tuning);
     }
     if (params.action == BackendFileActions::Create) {
-      return HH::createFile(params.fileName, params.createMode,
-                 HH::HDF5_Version_Range(HH::HDF5_Version::V18, HH::HDF5_Version::V110));
+      // The comm and isParallelIo arguments of createFileImpl select single process access
+      MPI_Comm dummyComm;
+      return HH::createFileImpl(params.fileName, params.createMode,
+                 HH::HDF5_Version_Range(HH::HDF5_Version::V18, HH::HDF5_Version::V110),
+                 dummyComm, false, params.hdf5Tuning);
     }
     if (params.action == BackendFileActions::CreateParallel) {
       return HH::createParallelFile(params.fileName, params.createMode, params.comm,
-                 HH::HDF5_Version_Range(HH::HDF5_Version::V18, HH::HDF5_Version::V110));
+                 HH::HDF5_Version_Range(HH::HDF5_Version::V18, HH::HDF5_Version::V110),
+                 params.hdf5Tuning);
     }
     throw Exception("Unknown BackendFileActions value", ioda_Here());
   }
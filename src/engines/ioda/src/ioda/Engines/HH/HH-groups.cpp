@@ -31,11 +31,12 @@ namespace ioda {
 namespace detail {
 namespace Engines {
 namespace HH {
-HH_Group::HH_Group(HH_hid_t grp, ::ioda::Engines::Capabilities caps, HH_hid_t fileroot)
-    : backend_(grp), fileroot_(fileroot), caps_(caps) {
+HH_Group::HH_Group(HH_hid_t grp, ::ioda::Engines::Capabilities caps, HH_hid_t fileroot,
+                   std::shared_ptr<DerivedChunkCaches> chunkCaches)
+    : backend_(grp), fileroot_(fileroot), caps_(caps), chunkCaches_(chunkCaches) {
   atts = Has_Attributes(std::make_shared<HH_HasAttributes>(grp));
   types = Has_Types(std::make_shared<HH_HasTypes>(grp));
-  vars = Has_Variables(std::make_shared<HH_HasVariables>(grp, fileroot));
+  vars = Has_Variables(std::make_shared<HH_HasVariables>(grp, fileroot, chunkCaches));
 }
 
 Group HH_Group::create(const std::string& name) {
@@ -63,7 +64,7 @@ Group HH_Group::create(const std::string& name) {
   if (res < 0) throw Exception("H5Gcreate failed.", ioda_Here());
   HH_hid_t hnd(res, Handles::Closers::CloseHDF5Group::CloseP);
 
-  auto backend = std::make_shared<HH_Group>(hnd, caps_, fileroot_);
+  auto backend = std::make_shared<HH_Group>(hnd, caps_, fileroot_, chunkCaches_);
   return ::ioda::Group{backend};
 }
 
@@ -72,7 +73,7 @@ Group HH_Group::open(const std::string& name) const {
   if (g < 0) throw Exception("H5Gopen failed.", ioda_Here());
   HH_hid_t grp_handle(g, Handles::Closers::CloseHDF5Group::CloseP);
 
-  auto res = std::make_shared<HH_Group>(grp_handle, caps_, fileroot_);
+  auto res = std::make_shared<HH_Group>(grp_handle, caps_, fileroot_, chunkCaches_);
   return ::ioda::Group{res};
 }
 
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <numeric>
 #include <set>
+#include <vector>
 
 #include "./HH/HH-Filters.h"
 #include "./HH/HH-attributes.h"
@@ -38,12 +39,95 @@ namespace detail {
 namespace Engines {
 namespace HH {
 
+namespace {
+
+/// Chunk caches derived from the chunk sizes of a variable are capped at this size.
+const size_t maxDerivedChunkCacheBytes = 64 * 1024 * 1024;
+
+/// Compute the size in bytes, and the number, of the chunks of dataset \p dset that cover
+/// one range along its first (Location) dimension, ie one chunk along the first dimension
+/// and all of the chunks along the other dimensions. Reading a frame of locations touches
+/// these chunks, so the chunk cache needs to hold them to avoid reading and decompressing
+/// the chunks again for the next frame. Returns zero for datasets that are not chunked.
+size_t chunkRowBytes(hid_t dset, size_t& numChunks) {
+  numChunks = 0;
+  HH_hid_t dcpl(H5Dget_create_plist(dset), Handles::Closers::CloseHDF5PropertyList::CloseP);
+  if (dcpl() < 0) throw Exception("H5Dget_create_plist failed.", ioda_Here());
+  if (H5Pget_layout(dcpl()) != H5D_CHUNKED) return 0;
+  const int rank = H5Pget_chunk(dcpl(), 0, nullptr);
+  if (rank <= 0) return 0;
+  std::vector<hsize_t> chunkDims(rank);
+  if (H5Pget_chunk(dcpl(), rank, chunkDims.data()) < 0)
+    throw Exception("H5Pget_chunk failed.", ioda_Here());
+
+  HH_hid_t space(H5Dget_space(dset), Handles::Closers::CloseHDF5Dataspace::CloseP);
+  if (space() < 0) throw Exception("H5Dget_space failed.", ioda_Here());
+  std::vector<hsize_t> dims(rank);
+  if (H5Sget_simple_extent_dims(space(), dims.data(), nullptr) < 0)
+    throw Exception("H5Sget_simple_extent_dims failed.", ioda_Here());
+  HH_hid_t type(H5Dget_type(dset), Handles::Closers::CloseHDF5Datatype::CloseP);
+  if (type() < 0) throw Exception("H5Dget_type failed.", ioda_Here());
+
+  size_t chunkBytes = H5Tget_size(type());
+  numChunks = 1;
+  for (int i = 0; i < rank; ++i) {
+    chunkBytes *= chunkDims[i];
+    if ((i > 0) && (chunkDims[i] > 0)) numChunks *= (dims[i] + chunkDims[i] - 1) / chunkDims[i];
+  }
+  return chunkBytes * numChunks;
+}
+
+/// Smallest prime number not less than \p n. The chunk cache hash table works best with
+/// a prime number of slots.
+size_t nextPrime(size_t n) {
+  if (n <= 2) return 2;
+  for (n |= 1; ; n += 2) {
+    bool isPrime = true;
+    for (size_t d = 3; d * d <= n; d += 2) {
+      if (n % d == 0) {
+        isPrime = false;
+        break;
+      }
+    }
+    if (isPrime) return n;
+  }
+}
+
+/// Decide the chunk cache of the open dataset \p dset from its chunk layout, within the
+/// limits of \p caches. Memory given to the cache is taken from the file budget.
+DerivedChunkCaches::CacheSize deriveChunkCache(hid_t dset, DerivedChunkCaches& caches) {
+  DerivedChunkCaches::CacheSize size{0, 0};
+  size_t numChunks;
+  const size_t rowBytes = chunkRowBytes(dset, numChunks);
+  const size_t cacheBytes = std::min({rowBytes, maxDerivedChunkCacheBytes,
+                                      caches.defaultBytes + caches.remainingBytes});
+  if (cacheBytes > caches.defaultBytes) {
+    caches.remainingBytes -= cacheBytes - caches.defaultBytes;
+    // HDF5 recommends about 100 hash slots per chunk held in the cache.
+    const size_t cachedChunks = std::max<size_t>(numChunks * cacheBytes / rowBytes, 1);
+    size.nslots = std::max(caches.defaultSlots, nextPrime(100 * cachedChunks));
+    size.nbytes = cacheBytes;
+  }
+  return size;
+}
+
+/// Dataset access property list holding the chunk cache \p size.
+HH_hid_t chunkCacheAccessPlist(const DerivedChunkCaches::CacheSize& size, double w0) {
+  HH_hid_t dapl(H5Pcreate(H5P_DATASET_ACCESS), Handles::Closers::CloseHDF5PropertyList::CloseP);
+  if (dapl() < 0) throw Exception("H5Pcreate failed.", ioda_Here());
+  if (H5Pset_chunk_cache(dapl(), size.nslots, size.nbytes, w0) < 0)
+    throw Exception("H5Pset_chunk_cache failed.", ioda_Here());
+  return dapl;
+}
+
+}  // namespace
 
 HH_HasVariables::~HH_HasVariables() = default;
 HH_HasVariables::HH_HasVariables() : base_(Handles::HH_hid_t::dummy()) {}
 
-HH_HasVariables::HH_HasVariables(HH_hid_t grp, HH_hid_t fileroot)
-    : base_(grp), fileroot_(fileroot) {}
+HH_HasVariables::HH_HasVariables(HH_hid_t grp, HH_hid_t fileroot,
+                                 std::shared_ptr<DerivedChunkCaches> chunkCaches)
+    : base_(grp), fileroot_(fileroot), chunkCaches_(chunkCaches) {}
 
 detail::Type_Provider* HH_HasVariables::getTypeProvider() const {
   return HH_Type_Provider::instance();
@@ -105,12 +189,46 @@ void HH_HasVariables::remove(const std::string& name) {
 }
 
 Variable HH_HasVariables::open(const std::string& name) const {
-  hid_t dsetid = H5Dopen(base_(), name.c_str(), H5P_DEFAULT);
+  // Datasets of files with derived chunk caches are opened with the cache decided when
+  // they were first opened.
+  std::map<std::string, DerivedChunkCaches::CacheSize>::const_iterator cached;
+  std::string path;
+  HH_hid_t dapl;
+  hid_t daplId = H5P_DEFAULT;
+  if (chunkCaches_) {
+    path = getNameFromIdentifier(base_());
+    if (path.empty() || (path.back() != '/')) path += '/';
+    path += name;
+    cached = chunkCaches_->datasets.find(path);
+    if ((cached != chunkCaches_->datasets.end()) && (cached->second.nbytes > 0)) {
+      dapl = chunkCacheAccessPlist(cached->second, chunkCaches_->w0);
+      daplId = dapl();
+    }
+  }
+
+  hid_t dsetid = H5Dopen(base_(), name.c_str(), daplId);
   if (dsetid < 0)
     throw Exception("Cannot open dataset", ioda_Here()).add("name", name);
+  HH_hid_t dset(dsetid, Handles::Closers::CloseHDF5Dataset::CloseP);
+
+  // On the first open, size the cache from the chunk layout. The HDF5 default of 1 MiB
+  // can be too small for variables with large chunks.
+  if (chunkCaches_ && (cached == chunkCaches_->datasets.end())) {
+    const DerivedChunkCaches::CacheSize size = deriveChunkCache(dsetid, *chunkCaches_);
+    chunkCaches_->datasets.emplace(path, size);
+    if (size.nbytes > 0) {
+      dapl = chunkCacheAccessPlist(size, chunkCaches_->w0);
+      // Close the dataset first: HDF5 ignores the access properties when reopening a
+      // dataset that is still open.
+      dset = HH_hid_t();
+      dsetid = H5Dopen(base_(), name.c_str(), dapl());
+      if (dsetid < 0)
+        throw Exception("Cannot open dataset", ioda_Here()).add("name", name);
+      dset = HH_hid_t(dsetid, Handles::Closers::CloseHDF5Dataset::CloseP);
+    }
+  }
 
-  auto b = std::make_shared<HH_Variable>(
-    HH_hid_t(dsetid, Handles::Closers::CloseHDF5Dataset::CloseP), shared_from_this());
+  auto b = std::make_shared<HH_Variable>(dset, shared_from_this());
   Variable var{b};
   return var;
 }
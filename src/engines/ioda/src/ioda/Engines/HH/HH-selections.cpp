@@ -0,0 +1,132 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+/*! \addtogroup ioda_internals_engines_hh
+ *
+ * @{
+ * \file HH-selections.cpp
+ * \brief Cache of concretized HDF5 dataspace selections.
+ */
+
+#include "./HH/HH-selections.h"
+
+#include <hdf5.h>
+
+#include <functional>
+#include <utility>
+
+#include "ioda/Exception.h"
+
+namespace ioda {
+namespace detail {
+namespace Engines {
+namespace HH {
+
+namespace {
+void appendDims(std::vector<Dimensions_t>& key, const std::vector<Dimensions_t>& dims) {
+  key.push_back(static_cast<Dimensions_t>(dims.size()));
+  key.insert(key.end(), dims.begin(), dims.end());
+}
+
+/// Serialize everything that determines the concretized selection. Returns false
+/// if the key would exceed maxKeyLength.
+bool makeKey(const HH_hid_t& baseSpace, const Selection& sel, std::size_t maxKeyLength,
+             std::vector<Dimensions_t>& key) {
+  key.clear();
+
+  const int rank = H5Sget_simple_extent_ndims(baseSpace());
+  if (rank < 0) throw Exception("H5Sget_simple_extent_ndims failed.", ioda_Here());
+  std::vector<hsize_t> dims(rank);
+  if (H5Sget_simple_extent_dims(baseSpace(), dims.data(), nullptr) < 0)
+    throw Exception("H5Sget_simple_extent_dims failed.", ioda_Here());
+  key.push_back(rank);
+  for (const hsize_t d : dims) key.push_back(static_cast<Dimensions_t>(d));
+
+  key.push_back(static_cast<Dimensions_t>(sel.getDefault()));
+  appendDims(key, sel.extent());
+  appendDims(key, sel.getOffset());
+  for (const auto& s : sel.getActions()) {
+    key.push_back(static_cast<Dimensions_t>(s.op_));
+    appendDims(key, s.start_);
+    appendDims(key, s.count_);
+    appendDims(key, s.stride_);
+    appendDims(key, s.block_);
+    key.push_back(static_cast<Dimensions_t>(s.points_.size()));
+    for (const auto& p : s.points_) appendDims(key, p);
+    key.push_back(static_cast<Dimensions_t>(s.dimension_));
+    appendDims(key, s.dimension_indices_starts_);
+    appendDims(key, s.dimension_indices_counts_);
+    if (key.size() > maxKeyLength) return false;
+  }
+  return (key.size() <= maxKeyLength);
+}
+
+std::size_t hashKey(const std::vector<Dimensions_t>& key) {
+  std::size_t seed = key.size();
+  const std::hash<Dimensions_t> hasher;
+  for (const Dimensions_t k : key)
+    seed ^= hasher(k) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+}  // namespace
+
+HH_SelectionCache& HH_SelectionCache::instance() {
+  // Intentionally never destroyed: the cached dataspaces must not be closed after
+  // the HDF5 library has shut down at exit.
+  static HH_SelectionCache* cache = new HH_SelectionCache;
+  return *cache;
+}
+
+HH_SelectionCache::HH_SelectionCache(std::size_t maxEntries) : maxEntries_(maxEntries) {}
+
+bool HH_SelectionCache::find(const HH_hid_t& baseSpace, const Selection& sel,
+                             std::vector<Dimensions_t>& key, HH_hid_t& space) {
+  if (!makeKey(baseSpace, sel, maxKeyLength, key)) {
+    key.clear();
+    return false;
+  }
+  const std::size_t hash = hashKey(key);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(hash);
+  if (it == index_.end() || it->second->key != key) return false;
+  // Move to the front of the list
+  entries_.splice(entries_.begin(), entries_, it->second);
+  space = it->second->space;
+  return true;
+}
+
+void HH_SelectionCache::insert(std::vector<Dimensions_t>&& key, const HH_hid_t& space) {
+  if (key.empty() || maxEntries_ == 0) return;
+  const std::size_t hash = hashKey(key);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = index_.find(hash);
+  if (it != index_.end()) {
+    // Replace an entry for the same key, or one whose key collides with this one.
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  entries_.push_front(Entry{hash, std::move(key), space});
+  index_[hash] = entries_.begin();
+  while (entries_.size() > maxEntries_) {
+    index_.erase(entries_.back().hash);
+    entries_.pop_back();
+  }
+}
+
+void HH_SelectionCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
+}  // namespace HH
+}  // namespace Engines
+}  // namespace detail
+}  // namespace ioda
+
+/// @}
@@ -109,6 +109,7 @@ VariableCreation::VariableCreation(const VariableCreationParameters& p, const Ve
       throw;  // Compression filters are only allowed when chunking is used.
 
     Filters filt(dcp_.get());
+    if (p.shuffle_ && (p.gzip_ || p.szip_)) filt.setShuffle();
     if (p.gzip_) filt.setGZIP(p.gzip_level_);
     if (p.szip_) filt.setSZIP(p.szip_options_, p.szip_PixelsPerBlock_);
   }
@@ -20,11 +20,14 @@
 #include <exception>
 #include <numeric>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "./HH/HH-Filters.h"
 #include "./HH/HH-attributes.h"
 #include "./HH/HH-hasattributes.h"
 #include "./HH/HH-hasvariables.h"
+#include "./HH/HH-selections.h"
 #include "./HH/HH-types.h"
 #include "./HH/HH-util.h"
 #include "./HH/Handles.h"
@@ -440,19 +443,27 @@ Selections::SelectionBackend_t HH_Variable::instantiateSelection(const Selection
 HH_hid_t HH_Variable::getSpaceWithSelection(const Selection& sel) const {
   if (sel.isConcretized()) {
     auto concretized = sel.concretize();
-    try {
-      // Only return the concretized selection if this is the correct backend.
-      auto csel = std::dynamic_pointer_cast<HH_Selection>(concretized);
-      return csel->sel;
-    } catch (std::bad_cast) {
-      sel.invalidate();
-    }
+    // Only return the concretized selection if this is the correct backend.
+    auto csel = std::dynamic_pointer_cast<HH_Selection>(concretized);
+    if (csel) return csel->sel;
+    sel.invalidate();
   }
   
   if (sel.getDefault() == SelectionState::ALL)
     if (sel.getActions().empty()) return HH_hid_t(H5S_ALL);
+
+  // Reuse a selection with the same shape that was concretized for any variable.
+  HH_hid_t baseSpace = space();
+  std::vector<Dimensions_t> cacheKey;
+  HH_hid_t cachedSpace;
+  if (HH_SelectionCache::instance().find(baseSpace, sel, cacheKey, cachedSpace)) {
+    auto res = std::make_shared<HH_Selection>();
+    res->sel = cachedSpace;
+    sel.concretize(res);
+    return cachedSpace;
+  }
   
-  HH_hid_t spc(H5Scopy(space()()), Handles::Closers::CloseHDF5Dataspace::CloseP);
+  HH_hid_t spc(H5Scopy(baseSpace()), Handles::Closers::CloseHDF5Dataspace::CloseP);
   if (spc() < 0) throw Exception("Cannot copy dataspace.", ioda_Here());
 
   if (!sel.extent().empty()) {
@@ -583,6 +594,8 @@ HH_hid_t HH_Variable::getSpaceWithSelection(const Selection& sel) const {
       throw Exception("Problem applying offset to space.", ioda_Here());
   }
 
+  HH_SelectionCache::instance().insert(std::move(cacheKey), spc);
+
   auto res = std::make_shared<HH_Selection>();
   res->sel = spc;
   sel.concretize(res);
@@ -599,9 +612,13 @@ Variable HH_Variable::parallelWrite(gsl::span<const char> data, const Type& in_m
   // last arg set to true means we are using parallel IO
   return writeImpl(data, in_memory_dataType, mem_selection, file_selection, true);
 }
+Variable HH_Variable::collectiveWrite(gsl::span<const char> data, const Type& in_memory_dataType,
+                      const Selection& mem_selection, const Selection& file_selection) {
+  return writeImpl(data, in_memory_dataType, mem_selection, file_selection, true, true);
+}
 Variable HH_Variable::writeImpl(gsl::span<const char> data, const Type& in_memory_dataType,
                       const Selection& mem_selection, const Selection& file_selection,
-                      const bool isParallelIo) {
+                      const bool isParallelIo, const bool isCollective) {
   auto memTypeBackend = std::dynamic_pointer_cast<HH_Type>(in_memory_dataType.getBackend());
   auto memSpace    = getSpaceWithSelection(mem_selection);
   auto fileSpace   = getSpaceWithSelection(file_selection);
@@ -611,14 +628,16 @@ Variable HH_Variable::writeImpl(gsl::span<const char> data, const Type& in_memor
   H5T_class_t varTypeClass = H5Tget_class(varType());
 
   // Create a data transfer property list to be used in all of the following H5Dwrite
-  // commands. If running in parallel io mode, we will use the independent style of
-  // writing. We are using independent for now since we have discovered issues on
-  // some platforms with collective style.
+  // commands. If running in parallel io mode, we use the independent style of writing
+  // unless the caller asked for collective, since we have discovered issues on some
+  // platforms with collective style. Filtered (compressed) variables can only be written
+  // in parallel with collective style.
   hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
   if (plist_id < 0) throw Exception("H5Pcreate failed", ioda_Here());
   if (isParallelIo) {
-    herr_t rc = H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_INDEPENDENT);
-    if (rc < 0) throw Exception("H5Pset_fapl_mpio failed", ioda_Here());
+    herr_t rc = H5Pset_dxpl_mpio(plist_id,
+                                 isCollective ? H5FD_MPIO_COLLECTIVE : H5FD_MPIO_INDEPENDENT);
+    if (rc < 0) throw Exception("H5Pset_dxpl_mpio failed", ioda_Here());
   }
   HH_hid_t xfer_plist(plist_id, Handles::Closers::CloseHDF5PropertyList::CloseP);
 
@@ -83,6 +83,119 @@ HDF5_Version_Range defaultVersionRange() {
 #endif
 }
 
+/// Memory that the chunk caches derived from the chunk layouts of the datasets of one file
+/// may add, in total, over the chunk cache size of the file.
+static const size_t derivedChunkCacheBudgetBytes = 256 * 1024 * 1024;
+
+/// Apply the cache settings in \p tuning, except the page buffer, to the file access
+/// property list \p fapl. \p isParallelIo is set when createParallelFile creates the file.
+/// Evict on close is not supported with parallel access, and is skipped then.
+static void setFileAccessTuning(hid_t fapl, const Hdf5FileTuning& tuning,
+                                const bool isParallelIo, const Options& errOpts) {
+  if ((tuning.chunkCacheBytes > 0) || (tuning.chunkCacheSlots > 0) || (tuning.chunkCacheW0 >= 0)) {
+    int mdcNelmts;  // no longer used by HDF5, but passed back unchanged
+    size_t rdccNslots;
+    size_t rdccNbytes;
+    double rdccW0;
+    if (0 > H5Pget_cache(fapl, &mdcNelmts, &rdccNslots, &rdccNbytes, &rdccW0))
+      throw Exception("H5Pget_cache failed", ioda_Here(), errOpts);
+    if (tuning.chunkCacheBytes > 0) rdccNbytes = tuning.chunkCacheBytes;
+    if (tuning.chunkCacheSlots > 0) rdccNslots = tuning.chunkCacheSlots;
+    if (tuning.chunkCacheW0 >= 0) rdccW0 = tuning.chunkCacheW0;
+    if (0 > H5Pset_cache(fapl, mdcNelmts, rdccNslots, rdccNbytes, rdccW0))
+      throw Exception("H5Pset_cache failed", ioda_Here(), errOpts);
+  }
+  if (tuning.metaBlockSize > 0) {
+    if (0 > H5Pset_meta_block_size(fapl, tuning.metaBlockSize))
+      throw Exception("H5Pset_meta_block_size failed", ioda_Here(), errOpts);
+  }
+  if (isParallelIo) return;
+#if H5_VERSION_GE(1, 10, 1)
+  if (tuning.evictOnClose) {
+    if (0 > H5Pset_evict_on_close(fapl, true))
+      throw Exception("H5Pset_evict_on_close failed", ioda_Here(), errOpts);
+  }
+#else
+  if (tuning.evictOnClose)
+    throw Exception("Evict on close needs HDF5 1.10.1 or later", ioda_Here(), errOpts);
+#endif
+}
+
+/// Set a page buffer of \p pageBufferBytes on the file access property list \p fapl of a
+/// file with paged file space. H5Fopen and H5Fcreate fail when a page buffer is set for a
+/// file without paged file space, or when the buffer cannot hold one page of \p pageSize.
+static void setPageBuffer(hid_t fapl, const size_t pageBufferBytes, const size_t pageSize,
+                          const Options& errOpts) {
+  if (pageBufferBytes < pageSize)
+    throw Exception("The page buffer size is smaller than the file space page size",
+                    ioda_Here(), errOpts)
+      .add("page buffer size", pageBufferBytes)
+      .add("file space page size", pageSize);
+#if H5_VERSION_GE(1, 10, 1)
+  if (0 > H5Pset_page_buffer_size(fapl, pageBufferBytes, 0, 0))
+    throw Exception("H5Pset_page_buffer_size failed", ioda_Here(), errOpts);
+#else
+  throw Exception("The page buffer needs HDF5 1.10.1 or later", ioda_Here(), errOpts);
+#endif
+}
+
+/// Return the file space page size of the existing file \p filename, or zero when the file
+/// was not written with paged file space.
+static size_t getFileSpacePageSize(const std::string& filename, const Options& errOpts) {
+#if H5_VERSION_GE(1, 10, 1)
+  using namespace ioda::detail::Engines::HH;
+  HH_hid_t f(H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT),
+             Handles::Closers::CloseHDF5File::CloseP);
+  if (f() < 0) throw Exception("H5Fopen failed", ioda_Here(), errOpts);
+  HH_hid_t fcpl(H5Fget_create_plist(f()), Handles::Closers::CloseHDF5PropertyList::CloseP);
+  if (fcpl() < 0) throw Exception("H5Fget_create_plist failed", ioda_Here(), errOpts);
+
+  H5F_fspace_strategy_t strategy;
+  hbool_t persist;
+  hsize_t threshold;
+  if (0 > H5Pget_file_space_strategy(fcpl(), &strategy, &persist, &threshold))
+    throw Exception("H5Pget_file_space_strategy failed", ioda_Here(), errOpts);
+  if (strategy != H5F_FSPACE_STRATEGY_PAGE) return 0;
+
+  hsize_t pageSize;
+  if (0 > H5Pget_file_space_page_size(fcpl(), &pageSize))
+    throw Exception("H5Pget_file_space_page_size failed", ioda_Here(), errOpts);
+  return static_cast<size_t>(pageSize);
+#else
+  // Paged file space needs HDF5 1.10.1 or later
+  return 0;
+#endif
+}
+
+/// Create the file creation property list for a new file, applying the file space
+/// settings in \p tuning.
+static detail::Engines::HH::HH_hid_t createFileCreationList(const Hdf5FileTuning& tuning,
+                                                           const Options& errOpts) {
+  using namespace ioda::detail::Engines::HH;
+  hid_t plid = H5Pcreate(H5P_FILE_CREATE);
+  if (plid < 0) throw Exception("H5Pcreate failed", ioda_Here(), errOpts);
+  HH_hid_t pl(plid, Handles::Closers::CloseHDF5PropertyList::CloseP);
+  if (tuning.fileSpacePageSize > 0) {
+#if H5_VERSION_GE(1, 10, 1)
+    if (0 > H5Pset_file_space_strategy(pl.get(), H5F_FSPACE_STRATEGY_PAGE, false, 1))
+      throw Exception("H5Pset_file_space_strategy failed", ioda_Here(), errOpts);
+    if (0 > H5Pset_file_space_page_size(pl.get(), tuning.fileSpacePageSize))
+      throw Exception("H5Pset_file_space_page_size failed", ioda_Here(), errOpts);
+#else
+    throw Exception("Paged file space needs HDF5 1.10.1 or later", ioda_Here(), errOpts);
+#endif
+  }
+  return pl;
+}
+
+bool haveParallelFilteredWrites() {
+#if H5_VERSION_GE(1, 10, 2)
+  return true;
+#else
+  return false;
+#endif
+}
+
 Group createMemoryFile(const std::string& filename, BackendCreateModes mode, bool flush_on_close,
                        size_t increment_len, HDF5_Version_Range compat) {
   using namespace ioda::detail::Engines::HH;
@@ -125,13 +238,15 @@ Group createFile(const std::string& filename, BackendCreateModes mode, HDF5_Vers
 }
 
 Group createParallelFile(const std::string& filename, BackendCreateModes mode,
-                         const MPI_Comm mpiComm, HDF5_Version_Range compat) {
-  // last argument is true signifying to open in multi-process access
-  return createFileImpl(filename, mode, compat, mpiComm , true);
+                         const MPI_Comm mpiComm, HDF5_Version_Range compat,
+                         const Hdf5FileTuning& tuning) {
+  // isParallelIo argument is true signifying to open in multi-process access
+  return createFileImpl(filename, mode, compat, mpiComm , true, tuning);
 }
 
 Group createFileImpl(const std::string& filename, BackendCreateModes mode,
-      HDF5_Version_Range compat, const MPI_Comm mpiComm, const bool isParallelIo) {
+      HDF5_Version_Range compat, const MPI_Comm mpiComm, const bool isParallelIo,
+      const Hdf5FileTuning& tuning) {
   using namespace ioda::detail::Engines::HH;
 
   static const std::map<BackendCreateModes, unsigned int> m{
@@ -155,8 +270,13 @@ Group createFileImpl(const std::string& filename, BackendCreateModes mode,
   // Note: this propagates to any files flushed to disk.
   if (0 > H5Pset_libver_bounds(pl.get(), map_h5ver.at(compat.first), map_h5ver.at(compat.second)))
     throw Exception("H5Pset_libver_bounds failed", ioda_Here(), errOpts);
+  setFileAccessTuning(pl.get(), tuning, isParallelIo, errOpts);
+  // The page buffer only works with paged file space, and not with parallel access.
+  if ((tuning.pageBufferBytes > 0) && (tuning.fileSpacePageSize > 0) && !isParallelIo)
+    setPageBuffer(pl.get(), tuning.pageBufferBytes, tuning.fileSpacePageSize, errOpts);
+  HH_hid_t fcpl = createFileCreationList(tuning, errOpts);
 
-  HH_hid_t f(H5Fcreate(filename.c_str(), m.at(mode), H5P_DEFAULT, pl.get()),
+  HH_hid_t f(H5Fcreate(filename.c_str(), m.at(mode), fcpl.get(), pl.get()),
              Handles::Closers::CloseHDF5File::CloseP);
   if (f() < 0) throw Exception("H5Fcreate failed", ioda_Here(), errOpts);
 
@@ -165,6 +285,11 @@ Group createFileImpl(const std::string& filename, BackendCreateModes mode,
 }
 
 Group openFile(const std::string& filename, BackendOpenModes mode, HDF5_Version_Range compat) {
+  return openFileImpl(filename, mode, compat, Hdf5FileTuning());
+}
+
+Group openFileImpl(const std::string& filename, BackendOpenModes mode,
+                   HDF5_Version_Range compat, const Hdf5FileTuning& tuning) {
   using namespace ioda::detail::Engines::HH;
   static const std::map<BackendOpenModes, unsigned int> m{
     {BackendOpenModes::Read_Only, H5F_ACC_RDONLY}, {BackendOpenModes::Read_Write, H5F_ACC_RDWR}};
@@ -179,12 +304,35 @@ Group openFile(const std::string& filename, BackendOpenModes mode, HDF5_Version_
   HH_hid_t pl(plid, Handles::Closers::CloseHDF5PropertyList::CloseP);
   if (0 > H5Pset_libver_bounds(pl.get(), map_h5ver.at(compat.first), map_h5ver.at(compat.second)))
     throw Exception("H5Pset_libver_bounds failed", ioda_Here(), errOpts);
+  // Files are always opened for serial access.
+  setFileAccessTuning(pl.get(), tuning, false, errOpts);
+  // The page buffer only works with paged file space, so look at the file space of the
+  // file before setting it.
+  if (tuning.pageBufferBytes > 0) {
+    const size_t pageSize = getFileSpacePageSize(filename, errOpts);
+    if (pageSize > 0) setPageBuffer(pl.get(), tuning.pageBufferBytes, pageSize, errOpts);
+  }
+
+  // Unless a chunk cache size was given, size the chunk caches of the datasets of files
+  // opened for reading from their chunk layouts.
+  std::shared_ptr<DerivedChunkCaches> chunkCaches;
+  if ((mode == BackendOpenModes::Read_Only) && (tuning.chunkCacheBytes == 0)) {
+    int mdcNelmts;
+    size_t rdccNslots;
+    size_t rdccNbytes;
+    double rdccW0;
+    if (0 > H5Pget_cache(pl.get(), &mdcNelmts, &rdccNslots, &rdccNbytes, &rdccW0))
+      throw Exception("H5Pget_cache failed", ioda_Here(), errOpts);
+    chunkCaches = std::make_shared<DerivedChunkCaches>(rdccNslots, rdccNbytes, rdccW0,
+                                                       derivedChunkCacheBudgetBytes);
+  }
 
   HH_hid_t f(H5Fopen(filename.c_str(), m.at(mode), pl.get()),
              Handles::Closers::CloseHDF5File::CloseP);
   if (f() < 0) throw Exception("H5Fopen failed", ioda_Here(), errOpts);
 
-  auto backend = std::make_shared<detail::Engines::HH::HH_Group>(f, getCapabilitiesFileEngine(), f);
+  auto backend = std::make_shared<detail::Engines::HH::HH_Group>(f, getCapabilitiesFileEngine(), f,
+                                                                 chunkCaches);
 
   return ::ioda::Group{backend};
 }
@@ -221,6 +369,56 @@ Group openMemoryFile(const std::string& filename, BackendOpenModes mode, bool fl
   return ::ioda::Group{backend};
 }
 
+Group openMemoryFileImage(const std::string& filename, const std::vector<char>& image,
+                          size_t increment_len, HDF5_Version_Range compat) {
+  using namespace ioda::detail::Engines::HH;
+
+  Options errOpts;
+  errOpts.add("filename", filename);
+  errOpts.add("image_size", image.size());
+  errOpts.add("increment_len", increment_len);
+  errOpts.add("compat", compat);
+
+  hid_t plid = H5Pcreate(H5P_FILE_ACCESS);
+  Expects(plid >= 0);
+  HH_hid_t pl(plid, Handles::Closers::CloseHDF5PropertyList::CloseP);
+
+  if (0 > H5Pset_fapl_core(pl.get(), increment_len, false))
+    throw Exception("H5Pset_fapl_core failed", ioda_Here(), errOpts);
+  if (0 > H5Pset_libver_bounds(pl.get(), map_h5ver.at(compat.first), map_h5ver.at(compat.second)))
+    throw Exception("H5Pset_libver_bounds failed", ioda_Here(), errOpts);
+  // H5Pset_file_image makes its own copy of the buffer.
+  if (0 > H5Pset_file_image(pl.get(), const_cast<char*>(image.data()), image.size()))
+    throw Exception("H5Pset_file_image failed", ioda_Here(), errOpts);
+
+  HH_hid_t f(H5Fopen(filename.c_str(), H5F_ACC_RDWR, pl.get()),
+             Handles::Closers::CloseHDF5File::CloseP);
+  if (f() < 0) throw Exception("H5Fopen failed", ioda_Here(), errOpts);
+
+  auto backend
+    = std::make_shared<detail::Engines::HH::HH_Group>(f, getCapabilitiesInMemoryEngine(), f);
+  return ::ioda::Group{backend};
+}
+
+std::vector<char> getFileImage(const Group& grp) {
+  using namespace ioda::detail::Engines::HH;
+  auto backend = std::dynamic_pointer_cast<HH_Group>(grp.getBackend());
+  if (!backend) throw Exception("Group is not backed by the HDF5 engine", ioda_Here());
+
+  hid_t obj = backend->get()();
+  if (0 > H5Fflush(obj, H5F_SCOPE_GLOBAL)) throw Exception("H5Fflush failed", ioda_Here());
+  ssize_t imageSize = H5Fget_file_image(obj, nullptr, 0);
+  if (imageSize < 0) throw Exception("H5Fget_file_image failed", ioda_Here());
+
+  std::vector<char> image(static_cast<size_t>(imageSize));
+  if (imageSize > 0) {
+    if (0 > H5Fget_file_image(obj, image.data(), image.size()))
+      throw Exception("H5Fget_file_image failed", ioda_Here())
+        .add("image_size", image.size());
+  }
+  return image;
+}
+
 Capabilities getCapabilitiesFileEngine() {
   static Capabilities caps;
   static bool inited = false;
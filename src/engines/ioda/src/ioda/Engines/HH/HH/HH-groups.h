@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "./HH-attributes.h"
+#include "./HH-hasvariables.h"
 #include "./HH-variables.h"
 #include "ioda/Attributes/Has_Attributes.h"
 #include "ioda/Engines/Capabilities.h"
@@ -39,6 +40,7 @@ class IODA_HIDDEN HH_Group : public ioda::detail::Group_Backend {
   HH_hid_t backend_;
   HH_hid_t fileroot_;
   ::ioda::Engines::Capabilities caps_;
+  std::shared_ptr<DerivedChunkCaches> chunkCaches_;
 
 public:
   // ioda::Has_Attributes atts;
@@ -48,7 +50,9 @@ public:
   /// @param grp is the HDF5 handle
   /// @param caps are the engine capabilities
   /// @param fileroot is a handle to the root object.
-  HH_Group(HH_hid_t grp, ::ioda::Engines::Capabilities caps, HH_hid_t fileroot);
+  /// @param chunkCaches are the derived chunk caches of the file, if any.
+  HH_Group(HH_hid_t grp, ::ioda::Engines::Capabilities caps, HH_hid_t fileroot,
+           std::shared_ptr<DerivedChunkCaches> chunkCaches = nullptr);
 
   virtual ~HH_Group() {}
 
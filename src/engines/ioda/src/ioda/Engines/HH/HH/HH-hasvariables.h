@@ -14,6 +14,7 @@
  */
 
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -45,15 +46,46 @@ class IODA_HIDDEN DatasetParameterPack {
   static HH_hid_t linkCreationPlist();
 };
 
+/// \brief Chunk caches derived from the chunk layouts of the datasets of one file.
+/// \ingroup ioda_internals_engines_hh
+/// \details Shared by all the groups of a file opened read-only without an explicit
+///   chunk cache size. Each chunked dataset gets a cache large enough for the chunks
+///   covering one range of locations, within a limit per dataset and a limit on the
+///   memory added over the file default across all datasets of the file. The cache of
+///   each dataset is decided the first time it is opened and reused afterwards.
+struct IODA_HIDDEN DerivedChunkCaches {
+  /// Chunk cache size of one dataset
+  struct CacheSize {
+    size_t nslots;
+    size_t nbytes;  ///< zero keeps the file default
+  };
+
+  DerivedChunkCaches(size_t defaultSlots, size_t defaultBytes, double w0, size_t budgetBytes)
+      : defaultSlots(defaultSlots), defaultBytes(defaultBytes), w0(w0),
+        remainingBytes(budgetBytes) {}
+
+  /// Chunk cache settings of the file
+  size_t defaultSlots;
+  size_t defaultBytes;
+  double w0;
+  /// Memory that can still be added over the file default by derived caches
+  size_t remainingBytes;
+  /// Cache sizes decided so far, keyed by dataset path
+  std::map<std::string, CacheSize> datasets;
+};
+
 /// \brief This is the implementation of Has_Variables using HDF5.
 class IODA_HIDDEN HH_HasVariables : public ioda::detail::Has_Variables_Backend,
                                     public std::enable_shared_from_this<HH_HasVariables> {
   HH_hid_t base_;
   HH_hid_t fileroot_;
+  /// Derived chunk caches of the file, or null to use the file settings for every dataset
+  std::shared_ptr<DerivedChunkCaches> chunkCaches_;
 
 public:
   HH_HasVariables();
-  HH_HasVariables(HH_hid_t grp, HH_hid_t fileroot);
+  HH_HasVariables(HH_hid_t grp, HH_hid_t fileroot,
+                  std::shared_ptr<DerivedChunkCaches> chunkCaches = nullptr);
   virtual ~HH_HasVariables();
   detail::Type_Provider* getTypeProvider() const final;
   FillValuePolicy getFillValuePolicy() const final;
@@ -0,0 +1,86 @@
+#pragma once
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+/*! \addtogroup ioda_internals_engines_hh
+ *
+ * @{
+ * \file HH-selections.h
+ * \brief Cache of concretized HDF5 dataspace selections.
+ */
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "./Handles.h"
+#include "ioda/Variables/Selection.h"
+#include "ioda/defs.h"
+
+namespace ioda {
+namespace detail {
+namespace Engines {
+namespace HH {
+
+/// \brief A least-recently-used cache of concretized dataspace selections.
+/// \ingroup ioda_internals_engines_hh
+/// \details Building a dataspace selection can take many H5Sselect_hyperslab calls
+///   (one per index range for dimension-index selections). Selections are often rebuilt
+///   from scratch for every read or write, e.g. channel subsets of radiance variables, so
+///   the Selection object's own cache is rarely reused. This cache is keyed by the selection
+///   actions, default, offset and extent, together with the extent of the dataspace the
+///   selection is applied to. It is therefore shared by all variables with the same shape.
+///
+///   The cached dataspaces are shared with the callers, who must not modify them.
+class IODA_HIDDEN HH_SelectionCache {
+public:
+  /// Process-wide cache used by the HDF5 engine.
+  static HH_SelectionCache& instance();
+
+  explicit HH_SelectionCache(std::size_t maxEntries = defaultMaxEntries);
+
+  /// \brief Look up a selection.
+  /// \param baseSpace is the dataspace that the selection would be applied to.
+  /// \param sel is the selection.
+  /// \param key receives the cache key, to be passed to insert() on a miss. Left empty
+  ///   if the selection is too large to be worth caching.
+  /// \param space receives the cached dataspace on a hit.
+  /// \returns true on a hit.
+  bool find(const HH_hid_t& baseSpace, const Selection& sel, std::vector<Dimensions_t>& key,
+            HH_hid_t& space);
+
+  /// \brief Store a concretized selection under a key returned by find().
+  void insert(std::vector<Dimensions_t>&& key, const HH_hid_t& space);
+
+  void clear();
+
+  static const std::size_t defaultMaxEntries = 256;
+  /// Selections with longer keys (e.g. large point selections) are not cached.
+  static const std::size_t maxKeyLength = 65536;
+
+private:
+  struct Entry {
+    std::size_t hash;
+    std::vector<Dimensions_t> key;
+    HH_hid_t space;
+  };
+  typedef std::list<Entry> EntryList_t;
+
+  std::size_t maxEntries_;
+  /// Entries in order of use, most recent first.
+  EntryList_t entries_;
+  std::unordered_map<std::size_t, EntryList_t::iterator> index_;
+  std::mutex mutex_;
+};
+
+}  // namespace HH
+}  // namespace Engines
+}  // namespace detail
+}  // namespace ioda
+
+/// @}
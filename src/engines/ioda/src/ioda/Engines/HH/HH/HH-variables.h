@@ -137,9 +137,11 @@ public:
                  const Selection& mem_selection, const Selection& file_selection) final;
   Variable parallelWrite(gsl::span<const char> data, const Type& in_memory_dataType,
                  const Selection& mem_selection, const Selection& file_selection) final;
+  Variable collectiveWrite(gsl::span<const char> data, const Type& in_memory_dataType,
+                 const Selection& mem_selection, const Selection& file_selection) final;
   Variable writeImpl(gsl::span<const char> data, const Type& in_memory_dataType,
                  const Selection& mem_selection, const Selection& file_selection,
-                 const bool isParallelIo);
+                 const bool isParallelIo, const bool isCollective = false);
 
   Variable read(gsl::span<char> data, const Type& in_memory_dataType,
                 const Selection& mem_selection, const Selection& file_selection) const final;
@@ -10,6 +10,7 @@
 
 #include <fstream>
 #include <algorithm>
+#include <iterator>
 
 #include "./DataFromSQL.h"
 
@@ -49,15 +50,66 @@ int DataFromSQL::getColumnIndex(const std::string& col) const {
 }
 
 size_t DataFromSQL::numberOfRowsForVarno(const int varno) const {
-  int varno_index = getColumnIndex("varno");
-  size_t tot      = 0;
-  for (int i = 0; i < number_of_rows_; i++) {
-    size_t val = getData(i, varno_index);
-    if (val == varno) {
-      tot++;
+  return rowsForVarno(varno).size();
+}
+
+const std::vector<size_t>& DataFromSQL::rowsForVarno(const int varno) const {
+  static const std::vector<size_t> no_rows;
+  const auto it = varno_rows_.find(varno);
+  return (it == varno_rows_.end()) ? no_rows : it->second;
+}
+
+std::vector<size_t> DataFromSQL::rowsForVarnos(const std::vector<int>& varnos) const {
+  std::vector<size_t> rows;
+  const std::set<int> unique_varnos(varnos.begin(), varnos.end());
+  for (const int varno : unique_varnos) {
+    const std::vector<size_t>& varno_rows = rowsForVarno(varno);
+    std::vector<size_t> merged;
+    merged.reserve(rows.size() + varno_rows.size());
+    std::merge(rows.begin(), rows.end(), varno_rows.begin(), varno_rows.end(),
+               std::back_inserter(merged));
+    rows.swap(merged);
+  }
+  return rows;
+}
+
+void DataFromSQL::buildRowIndices() {
+  varno_rows_.clear();
+  metadata_row_ranges_.clear();
+  const int varno_index = getColumnIndex("varno");
+  const int seqno_index = getColumnIndex("seqno");
+  if (varno_index == -1 || number_of_rows_ == 0) return;
+
+  const std::vector<double>& varno_data = data_.at(varno_index);
+  for (size_t i = 0; i < number_of_rows_; i++) {
+    varno_rows_[static_cast<int>(varno_data[i])].push_back(i);
+  }
+
+  // The metadata rows are defined as in the original row-by-row scans: for profiles they are
+  // the rows holding the first varno; otherwise a new metadata row starts with each new seqno
+  // (or after max_number_channels_ rows, if set).
+  if (obsgroup_ == obsgroup_sonde || obsgroup_ == obsgroup_oceansound ||
+      obsgroup_ == obsgroup_geocloud ||
+      (obsgroup_ == obsgroup_gnssro && max_number_channels_ == 0)) {
+    for (const size_t i : rowsForVarno(varnos_[0])) {
+      metadata_row_ranges_.emplace_back(i, i + 1);
     }
+  } else if (seqno_index != -1) {
+    const std::vector<double>& seqno_data = data_.at(seqno_index);
+    size_t seqno    = -1;
+    size_t chan_num = 0;
+    for (size_t i = 0; i < number_of_rows_; i++) {
+      size_t seqno_new = seqno_data[i];
+      chan_num++;
+      if (seqno != seqno_new || (max_number_channels_ > 0 && chan_num > max_number_channels_)) {
+        if (!metadata_row_ranges_.empty()) metadata_row_ranges_.back().second = i;
+        metadata_row_ranges_.emplace_back(i, i);
+        seqno = seqno_new;
+        chan_num = 1;
+      }
+    }
+    if (!metadata_row_ranges_.empty()) metadata_row_ranges_.back().second = number_of_rows_;
   }
-  return tot;
 }
 
 bool DataFromSQL::hasVarno(const int varno) const {
@@ -198,37 +250,22 @@ Eigen::ArrayXi DataFromSQL::getMetadataColumnInt(std::string const& col) const {
 template <typename T>
 DataFromSQL::ArrayX<T> DataFromSQL::getNumericMetadataColumn(std::string const& col) const {
   int column_index = getColumnIndex(col);
-  int seqno_index  = getColumnIndex("seqno");
-  int varno_index  = getColumnIndex("varno");
   ArrayX<T> arr(number_of_metadata_rows_);
   arr = odb_missing<T>();
+  // If the first row of a metadata row holds a missing value, take the value from the
+  // following rows until a non-missing value is found.
   bool still_looking = false;
   if (column_index != -1) {
-    size_t seqno    = -1;
-    size_t j        = 0;
-    size_t chan_num = 0;
-    for (size_t i = 0; i < number_of_rows_; i++) {
-      size_t seqno_new = getData(i, seqno_index);
-      int varno        = getData(i, varno_index);
-      chan_num++;
-      if (obsgroup_ == obsgroup_sonde || obsgroup_ == obsgroup_oceansound || obsgroup_ == obsgroup_geocloud ||
-          (obsgroup_ == obsgroup_gnssro && max_number_channels_ == 0)) {
-        if (varnos_[0] == varno) {
-          arr[j] = getData(i, column_index);
-          j++;
-          seqno = seqno_new;
-        }
-      } else {
-        if (seqno != seqno_new || (max_number_channels_ > 0 && chan_num > max_number_channels_)) {
-          arr[j] = getData(i, column_index);
-          j++;
-          seqno = seqno_new;
-          chan_num = 1;
-          if (arr[j-1] == odb_missing<T>()) still_looking = true;
-        } else if (still_looking) {
-          arr[j-1] = getData(i, column_index);
-          if (arr[j-1] != odb_missing<T>()) still_looking = false;
-        }
+    const std::vector<double>& column_data = data_.at(column_index);
+    const size_t n = std::min<size_t>(metadata_row_ranges_.size(), arr.size());
+    for (size_t j = 0; j < n; j++) {
+      const size_t first = metadata_row_ranges_[j].first;
+      const size_t last  = metadata_row_ranges_[j].second;
+      arr[j] = column_data[first];
+      if (arr[j] == odb_missing<T>()) still_looking = true;
+      for (size_t i = first + 1; still_looking && i < last; i++) {
+        arr[j] = column_data[i];
+        if (arr[j] != odb_missing<T>()) still_looking = false;
       }
     }
   }
@@ -237,37 +274,20 @@ DataFromSQL::ArrayX<T> DataFromSQL::getNumericMetadataColumn(std::string const&
 
 std::vector<std::string> DataFromSQL::getMetadataStringColumn(std::string const& col) const {
   int column_index = getColumnIndex(col);
-  int seqno_index  = getColumnIndex("seqno");
-  int varno_index  = getColumnIndex("varno");
   std::vector<std::string> arr;
   arr.reserve(number_of_metadata_rows_);
   bool still_looking = false;
   if (column_index != -1) {
-    size_t seqno = -1;
-    size_t chan_num = 0;
-    for (size_t i = 0; i < number_of_rows_; i++) {
-      size_t seqno_new = getData(i, seqno_index);
-      int varno        = getData(i, varno_index);
-      chan_num++;
-      if (obsgroup_ == obsgroup_sonde || obsgroup_ == obsgroup_oceansound || obsgroup_ == obsgroup_geocloud ||
-          (obsgroup_ == obsgroup_gnssro && max_number_channels_ == 0)) {
-        if (varnos_[0] == varno) {
-          arr.push_back(reinterpretString(getData(i, column_index)));
-          seqno = seqno_new;
-        }
-      } else {
-        if (seqno != seqno_new || (max_number_channels_ > 0 && chan_num > max_number_channels_)) {
-          double ud = getData(i, column_index);
-          arr.push_back(reinterpretString(ud));
-          seqno = seqno_new;
-          chan_num = 1;
-          if (ud == odb_missing_float) still_looking = true;
-        } else if (still_looking) {
-          double ud = getData(i, column_index);
-          if (ud != odb_missing_float) {
-            still_looking = false;
-            arr.back() = reinterpretString(ud);
-          }
+    const std::vector<double>& column_data = data_.at(column_index);
+    for (const auto& range : metadata_row_ranges_) {
+      double ud = column_data[range.first];
+      arr.push_back(reinterpretString(ud));
+      if (ud == odb_missing_float) still_looking = true;
+      for (size_t i = range.first + 1; still_looking && i < range.second; i++) {
+        ud = column_data[i];
+        if (ud != odb_missing_float) {
+          still_looking = false;
+          arr.back() = reinterpretString(ud);
         }
       }
     }
@@ -326,26 +346,18 @@ Eigen::Array<T, Eigen::Dynamic, 1> DataFromSQL::getVarnoColumn(const std::vector
     }
   }
 
-  // Mapping between user-desired varno order and the order in the data set.
-  std::map <int, std::vector<int>> varno_order_map;
-  for (const int varno_requested_order : varnos) {
-    for (size_t irow = 0; irow < number_of_rows_; irow++) {
-      if (varno_requested_order == getData(irow, varno_index))
-        varno_order_map[varno_requested_order].push_back(irow);
-    }
-  }
-
-  // Current index for each vector associated with a varno.
+  // Current index into the rows of each varno.
   std::map <int, int> varno_current_index;
   for (const int varno : varnos)
     varno_current_index[varno] = 0;
 
   // Final ordering of indices to use when filling array of data.
-  std::vector <int> varno_index_order;
+  std::vector <size_t> varno_index_order;
   for (int i = 0; i < number_of_metadata_rows_; ++i) {
     for (const int varno : varnos) {
+      const std::vector<size_t>& varno_rows = rowsForVarno(varno);
       for (int j = 0; j < varno_size[varno]; ++j) {
-        varno_index_order.push_back(varno_order_map[varno][varno_current_index[varno]++]);
+        varno_index_order.push_back(varno_rows[varno_current_index[varno]++]);
       }
     }
   }
@@ -363,37 +375,37 @@ Eigen::Array<T, Eigen::Dynamic, 1> DataFromSQL::getVarnoColumn(const std::vector
   }
   if (nchans == 1) {
     if (column_index != -1 && varno_index != -1) {
+      const std::vector<double>& column_data = data_.at(column_index);
       if (obsgroup_ == obsgroup_surface || obsgroup_ == obsgroup_aircraft) {
         for (int j = 0; j < num_rows; ++j) {
-          arr[j] = getData(varno_index_order[j], column_index);
+          arr[j] = column_data[varno_index_order[j]];
         }
       } else {
         for (int j = 0; j < varno_index_order.size(); ++j) {
-          arr[j] = getData(varno_index_order[j], column_index);
+          arr[j] = column_data[varno_index_order[j]];
         }
       }
     }
   } else {
     if (column_index != -1 && varno_index != -1) {
+      const std::vector<double>& column_data = data_.at(column_index);
       size_t j = 0;
       int k_chan = 1;
       int seqno_index = getColumnIndex("seqno");
       size_t seqno = getData(0, seqno_index);
-      for (size_t i = 0; i < number_of_rows_; i++) {
-        if (std::find(varnos.begin(), varnos.end(), getData(i, varno_index)) != varnos.end()) {
-          k_chan++;
-          arr[j] = getData(i, column_index);
-          size_t seqno_new = getData(i, seqno_index);
-          j++;
-          if (k_chan > nchans_actual) {
-            j += (nchans - nchans_actual);  // skip unused channels
-            k_chan = 1;
-          }
-          if (seqno != seqno_new && max_number_channels_ > 0) {
-            j += (nchans - k_chan + 1);
-            seqno = seqno_new;
-            k_chan = 1;
-          }
+      for (const size_t i : rowsForVarnos(varnos)) {
+        k_chan++;
+        arr[j] = column_data[i];
+        size_t seqno_new = getData(i, seqno_index);
+        j++;
+        if (k_chan > nchans_actual) {
+          j += (nchans - nchans_actual);  // skip unused channels
+          k_chan = 1;
+        }
+        if (seqno != seqno_new && max_number_channels_ > 0) {
+          j += (nchans - k_chan + 1);
+          seqno = seqno_new;
+          k_chan = 1;
         }
       }
     }
@@ -561,6 +573,8 @@ void DataFromSQL::select(const std::vector<std::string>& columns, const std::str
     number_of_metadata_rows_ = number_of_rows_ / number_of_varnos_;
   }
 
+  buildRowIndices();
+
   // Check number of rows is consistent for each varno.
   for (const int varno : varnos_) {
     if (hasVarno(varno) && number_of_metadata_rows_ > 0) {
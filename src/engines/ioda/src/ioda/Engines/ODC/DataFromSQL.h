@@ -14,6 +14,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ioda/defs.h"
@@ -105,6 +106,25 @@ private:
   int obsgroup_                    = 0;
   std::map<int, size_t> varnos_and_levels_;
   std::map<int, size_t> varnos_and_levels_to_use_;
+  /// Indices of the rows holding each varno, in increasing order
+  std::map<int, std::vector<size_t>> varno_rows_;
+  /// Range [first, last) of the rows making up each metadata row (location)
+  std::vector<std::pair<size_t, size_t>> metadata_row_ranges_;
+
+  /// \brief Index the rows by varno and by metadata row
+  /// \details This is done once, after the data have been selected, so that the column
+  /// extraction functions do not need to scan the whole table. The extraction functions
+  /// only read the data and the indices, so they can be called concurrently.
+  void buildRowIndices();
+
+  /// \brief Returns the indices of the rows holding a particular varno, in increasing order
+  /// \param varno The varno to look up
+  const std::vector<size_t>& rowsForVarno(int varno) const;
+
+  /// \brief Returns the indices of the rows holding any of the specified varnos,
+  /// in increasing order
+  /// \param varnos The varnos to look up
+  std::vector<size_t> rowsForVarnos(const std::vector<int>& varnos) const;
 
   /// \brief Returns the value for a particular row/column
   /// \param row Get data for this row
@@ -84,6 +84,7 @@ std::shared_ptr<Group> Group::create(const std::string& name) {
   } else {
     childGroup = std::make_shared<Group>();
     childGroup->vars->setParentGroup(childGroup);
+    childGroup->vars->shareStructureVersion(*vars);
     child_groups_.insert(
       std::pair<std::string, std::shared_ptr<Group>>(pathSections[0], childGroup));
   }
@@ -100,6 +100,12 @@ Variable ObsStore_Variable_Backend::resize(const std::vector<Dimensions_t>& newD
   return Variable{shared_from_this()};
 }
 
+void ObsStore_Variable_Backend::reserve(const std::vector<Dimensions_t>& capacityDims) {
+  backend_->reserve(capacityDims);
+}
+
+void ObsStore_Variable_Backend::shrinkToFit() { backend_->shrinkToFit(); }
+
 Variable ObsStore_Variable_Backend::attachDimensionScale(unsigned int DimensionNumber,
                                                          const Variable& scale) {
   auto scaleBackendBase    = scale.get();
@@ -256,6 +262,10 @@ bool ObsStore_HasVariables_Backend::exists(const std::string& name) const {
 
 void ObsStore_HasVariables_Backend::remove(const std::string& name) { backend_->remove(name); }
 
+std::size_t ObsStore_HasVariables_Backend::structureVersion() const {
+  return backend_->structureVersion();
+}
+
 Variable ObsStore_HasVariables_Backend::open(const std::string& name) const {
   auto res = backend_->open(name);
   auto b   = std::make_shared<ObsStore_Variable_Backend>(res);
@@ -96,6 +96,13 @@ public:
   /// \param newDims new dimension sizes
   Variable resize(const std::vector<Dimensions_t>& newDims) final;
 
+  /// \brief reserve storage for growing the dimensions
+  /// \param capacityDims dimension sizes to reserve storage for
+  void reserve(const std::vector<Dimensions_t>& capacityDims) final;
+
+  /// \brief release storage reserved beyond the current dimensions
+  void shrinkToFit() final;
+
   /// \brief attach dimension to this variable
   /// \param DimensionNumber index of dimension (0, 1, ..., num_dims-1)
   /// \param scale existing variable holding dimension coordinate values
@@ -165,6 +172,9 @@ public:
   /// \brief return list of variables in this container
   std::vector<std::string> list() const final;
 
+  /// \brief return the structure version of the ObsStore group tree
+  std::size_t structureVersion() const final;
+
   /// \brief create a new variable
   /// \param attname name of variable
   /// \param in_memory_dataType fronted type marker
@@ -34,8 +34,8 @@ void SelectCounter::reset(const SelectionModes mode, const std::vector<std::size
 
 void SelectCounter::inc() {
   if (mode_ == SelectionModes::POINT) {
-    if (digits_[0] == ndigits_ - 1) {
-      // about to overflow the counter --> done
+    if (digits_[0] + 1 >= digit_sizes_[0]) {
+      // about to go past the last point --> done
       counter_end_ = true;
       return;
     }
@@ -105,6 +105,8 @@ Selection::Selection(const SelectionModes mode, const std::vector<SelectSpecs>&
   // be accessed by dimensions, so need to decrement by 1 for it to contain
   // the maximum allowed index.
   max_index_--;
+
+  if (mode_ == SelectionModes::INTERSECT) genDimRuns();
 }
 
 Selection::Selection() = default;
@@ -164,6 +166,116 @@ bool Selection::end_lin_indx() const {
   return finished;
 }
 
+// Following are a set of functions that walk through the selection as runs of
+// contiguous linear memory indices. This allows data to be transferred in blocks
+// rather than one point at a time. The runs are generated in the same order as
+// the linear memory indices from next_lin_indx.
+//
+// For INTERSECT mode, the trailing dimensions that are completely selected are
+// folded into one block, and consecutive indices in the dimension just before
+// them (run_dim_) are merged into runs. The counter then walks through the
+// dimensions in front of run_dim_ plus the list of runs. For POINT mode,
+// consecutive points that land on adjacent linear memory indices are merged.
+void Selection::init_lin_run() {
+  run_end_ = (npoints_ == 0);
+  if (mode_ == SelectionModes::INTERSECT) {
+    if (!run_end_) counter_->reset(mode_, run_digit_sizes_);
+  } else if (mode_ == SelectionModes::POINT) {
+    point_ = 0;
+  }
+}
+
+std::size_t Selection::next_lin_run(std::size_t & run_length) {
+  std::size_t lin_index = 0;
+  if (mode_ == SelectionModes::ALL) {
+    lin_index  = 0;
+    run_length = gsl::narrow<std::size_t>(end_ + 1);
+    run_end_   = true;
+  } else if (mode_ == SelectionModes::INTERSECT) {
+    // Calculate linear index from the outer dimensions and the current run
+    const std::vector<std::size_t>& curCount = counter_->count();
+    std::size_t outer_index = 0;
+    for (std::size_t i = 0; i < run_dim_; ++i) {
+      outer_index *= dim_sizes_[i];
+      outer_index += dim_selects_[i][curCount[i]];
+    }
+    const auto & run = dim_runs_[curCount[run_dim_]];
+    lin_index  = (outer_index * dim_sizes_[run_dim_] + run.first) * run_block_;
+    run_length = run.second * run_block_;
+
+    // increment counter for next time around
+    counter_->inc();
+  } else {
+    lin_index  = pointLinIndx(point_);
+    run_length = 1;
+    point_++;
+    while ((point_ < npoints_) && (pointLinIndx(point_) == lin_index + run_length)) {
+      run_length++;
+      point_++;
+    }
+    run_end_ = (point_ >= npoints_);
+  }
+
+  // Make sure the run is in bounds.
+  if ((run_length > 0) && (lin_index + run_length - 1 > max_index_))
+    throw Exception("Linear index run is out of bounds.", ioda_Here())
+      .add("  Run start: ", lin_index)
+      .add("  Run length: ", run_length)
+      .add("  Maximum allowed index: ", max_index_);
+
+  return lin_index;
+}
+
+bool Selection::end_lin_run() const {
+  if (mode_ == SelectionModes::INTERSECT) {
+    return run_end_ || counter_->finished();
+  }
+  return run_end_;
+}
+
+bool Selection::isFullDimSelect(const std::size_t idim) const {
+  const SelectSpecs & specs = dim_selects_[idim];
+  if (specs.size() != gsl::narrow<std::size_t>(dim_sizes_[idim])) return false;
+  for (std::size_t i = 0; i < specs.size(); ++i) {
+    if (specs[i] != i) return false;
+  }
+  return true;
+}
+
+std::size_t Selection::pointLinIndx(const std::size_t ipoint) const {
+  std::size_t lin_index = dim_selects_[0][ipoint];
+  for (std::size_t i = 1; i < dim_selects_.size(); ++i) {
+    lin_index *= dim_sizes_[i];
+    lin_index += dim_selects_[i][ipoint];
+  }
+  return lin_index;
+}
+
+void Selection::genDimRuns() {
+  if (dim_selects_.empty()) return;
+
+  // Fold the completely selected trailing dimensions into one block
+  run_dim_   = dim_selects_.size() - 1;
+  run_block_ = 1;
+  while ((run_dim_ > 0) && isFullDimSelect(run_dim_)) {
+    run_block_ *= dim_sizes_[run_dim_];
+    run_dim_--;
+  }
+
+  // Merge consecutive indices in run_dim_
+  dim_runs_.clear();
+  for (const auto idx : dim_selects_[run_dim_]) {
+    if (!dim_runs_.empty() && (dim_runs_.back().first + dim_runs_.back().second == idx)) {
+      dim_runs_.back().second++;
+    } else {
+      dim_runs_.emplace_back(idx, 1);
+    }
+  }
+
+  run_digit_sizes_.assign(dim_select_sizes_.begin(), dim_select_sizes_.begin() + run_dim_);
+  run_digit_sizes_.push_back(dim_runs_.size());
+}
+
 std::size_t Selection::npoints() const { return npoints_; }
 }  // namespace ObsStore
 }  // namespace ioda
@@ -11,12 +11,14 @@
  * \brief Functions for ObsStore Selection
  */
 #pragma once
+#include <algorithm>
 #include <cstring>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
+#include <utility>
 #include <vector>
 
 #include "ioda/defs.h"
@@ -114,6 +116,27 @@ private:
   /// \brief counter for generating linear memory indices
   std::unique_ptr<SelectCounter> counter_;
 
+  /// \brief dimension along which contiguous runs are formed (INTERSECT mode)
+  /// \details All dimensions after run_dim_ are completely selected, in order.
+  std::size_t run_dim_ = 0;
+  /// \brief number of linear memory elements spanned by one index of run_dim_
+  std::size_t run_block_ = 1;
+  /// \brief runs of consecutive indices in run_dim_ (first index, number of indices)
+  std::vector<std::pair<std::size_t, std::size_t>> dim_runs_;
+  /// \brief counter digit sizes for walking through the runs (INTERSECT mode)
+  std::vector<std::size_t> run_digit_sizes_;
+  /// \brief current point for POINT mode runs
+  std::size_t point_ = 0;
+  /// \brief true when no runs remain (ALL and POINT modes, or empty selection)
+  bool run_end_ = false;
+
+  /// \brief returns true if dimension idim is completely selected in order
+  bool isFullDimSelect(const std::size_t idim) const;
+  /// \brief returns linear memory index of point ipoint (POINT mode)
+  std::size_t pointLinIndx(const std::size_t ipoint) const;
+  /// \brief record contiguous runs of the selection (INTERSECT mode)
+  void genDimRuns();
+
 public:
   Selection(const std::size_t start, const std::size_t npoints);
   Selection(const SelectionModes mode, const std::vector<SelectSpecs>& dim_selects,
@@ -130,9 +153,54 @@ public:
   /// \brief returns true when at the end of the linear memory indices
   bool end_lin_indx() const;
 
+  /// \brief initializes iterator for walking through runs of contiguous linear memory indices
+  void init_lin_run();
+  /// \brief returns linear memory index at the start of the next run
+  /// \param run_length is set to the number of contiguous linear memory indices in the run
+  std::size_t next_lin_run(std::size_t & run_length);
+  /// \brief returns true when at the end of the runs
+  bool end_lin_run() const;
+
   /// \brief returns number of points in selection
   std::size_t npoints() const;
 };
+
+/// \brief walk through a pair of selections as runs of contiguous linear memory indices
+/// \ingroup ioda_internals_engines_obsstore
+/// \details Calls transfer(m_indx, f_indx, count) for each stretch of count points that
+///          is contiguous in both selections. Assumes m_select and f_select have the same
+///          number of points. Strided selections (such as a single channel) come out as
+///          runs of one point; there is no separate gather/scatter path for them.
+/// \param m_select Selection object for memory
+/// \param f_select Selection object for storage
+/// \param transfer function that moves count points starting at m_indx and f_indx
+template <typename TransferFunc>
+void forEachRunPair(Selection &m_select, Selection &f_select, TransferFunc &&transfer) {
+  std::size_t m_indx = 0;
+  std::size_t m_len  = 0;
+  std::size_t f_indx = 0;
+  std::size_t f_len  = 0;
+  m_select.init_lin_run();
+  f_select.init_lin_run();
+  while (true) {
+    if (m_len == 0) {
+      if (m_select.end_lin_run()) break;
+      m_indx = m_select.next_lin_run(m_len);
+      continue;
+    }
+    if (f_len == 0) {
+      if (f_select.end_lin_run()) break;
+      f_indx = f_select.next_lin_run(f_len);
+      continue;
+    }
+    std::size_t count = std::min(m_len, f_len);
+    transfer(m_indx, f_indx, count);
+    m_indx += count;
+    m_len -= count;
+    f_indx += count;
+    f_len -= count;
+  }
+}
 }  // namespace ObsStore
 }  // namespace ioda
 
@@ -12,6 +12,8 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -23,6 +25,17 @@
 
 namespace ioda {
 namespace ObsStore {
+/// \brief grows the capacity of a storage vector so that it holds at least newSize
+///   elements. The capacity at least doubles, so a series of small resizes (such as
+///   appending one frame at a time) costs amortised constant time per element.
+/// \ingroup ioda_internals_engines_obsstore
+template <typename T>
+void growStorage(std::vector<T> &storage, std::size_t newSize) {
+  if (newSize > storage.capacity()) {
+    storage.reserve(std::max(newSize, 2 * storage.capacity()));
+  }
+}
+
 /// \ingroup ioda_internals_engines_obsstore
 class VarAttrStore_Base {
 private:
@@ -37,6 +50,13 @@ public:
   /// \param newSize new size for allocated memory in number of vector elements
   /// \param fillvalue new elements get initialized to fillValue
   virtual void resize(std::size_t newSize, gsl::span<char> &fillValue) = 0;
+  /// \brief reserves memory for data storage (vector) without changing its size
+  /// \param newCapacity capacity in number of vector elements
+  virtual void reserve(std::size_t newCapacity) = 0;
+  /// \brief releases memory reserved beyond the current size of the data storage
+  virtual void shrinkToFit() = 0;
+  /// \brief returns the capacity of the data storage in number of vector elements
+  virtual std::size_t capacity() const = 0;
   /// \brief transfer data to data storage vector
   /// \param data contiguous block of data to transfer
   /// \param m_select Selection ojbect: how to select from data argument
@@ -67,16 +87,32 @@ public:
 
   /// \brief resizes memory allocated for data storage (vector)
   /// \param newSize new size for allocated memory in number of vector elements
-  void resize(std::size_t newSize) override { var_attr_data_.resize(newSize * num_elements_); }
+  void resize(std::size_t newSize) override {
+    growStorage(var_attr_data_, newSize * num_elements_);
+    var_attr_data_.resize(newSize * num_elements_);
+  }
 
   /// \brief resizes memory allocated for data storage (vector)
   /// \param newSize new size for allocated memory in number of vector elements
   /// \param fillvalue new elements get initialized to fillValue
   void resize(std::size_t newSize, gsl::span<char> &fillValue) override {
     gsl::span<DataType> fv_span(reinterpret_cast<DataType *>(fillValue.data()), 1);
+    growStorage(var_attr_data_, newSize * num_elements_);
     var_attr_data_.resize(newSize * num_elements_, fv_span[0]);
   }
 
+  /// \brief reserves memory for data storage (vector) without changing its size
+  /// \param newCapacity capacity in number of vector elements
+  void reserve(std::size_t newCapacity) override {
+    var_attr_data_.reserve(newCapacity * num_elements_);
+  }
+
+  /// \brief releases memory reserved beyond the current size of the data storage
+  void shrinkToFit() override { var_attr_data_.shrink_to_fit(); }
+
+  /// \brief returns the capacity of the data storage in number of vector elements
+  std::size_t capacity() const override { return var_attr_data_.capacity() / num_elements_; }
+
   /// \brief transfer data to data storage vector
   /// \param data contiguous block of data to transfer
   /// \param m_select Selection ojbect: how to select from data argument
@@ -86,15 +122,12 @@ public:
       std::size_t numObjects = data.size() / sizeof(DataType);
       gsl::span<const DataType> d_span(reinterpret_cast<const DataType *>(data.data()), numObjects);
       // assumes m_select and f_select have same number of points
-      m_select.init_lin_indx();
-      f_select.init_lin_indx();
-      while (!m_select.end_lin_indx()) {
-        std::size_t m_indx     = m_select.next_lin_indx() * num_elements_;
-        std::size_t f_indx     = f_select.next_lin_indx() * num_elements_;
-        for (std::size_t i = 0; i < num_elements_; ++i) {
-          var_attr_data_[f_indx + i] = d_span[m_indx + i];
-        }
-      }
+      // Each run of points that is contiguous in both selections is moved in one block.
+      forEachRunPair(m_select, f_select,
+                     [&](std::size_t m_indx, std::size_t f_indx, std::size_t count) {
+        std::copy_n(d_span.data() + m_indx * num_elements_, count * num_elements_,
+                    var_attr_data_.data() + f_indx * num_elements_);
+      });
     }
   }
 
@@ -104,20 +137,15 @@ public:
   /// \param f_select Selection ojbect: how to select from storage vector
   void read(gsl::span<char> data, Selection &m_select, Selection &f_select) const override {
     if (data.size() > 0) {
-      std::size_t numChars = var_attr_data_.size() * sizeof(DataType);
-      gsl::span<char> c_span(
-        const_cast<char *>(reinterpret_cast<const char *>(var_attr_data_.data())), numChars);
+      const char *c_data = reinterpret_cast<const char *>(var_attr_data_.data());
       // assumes m_select and f_select have same number of points
+      // Each run of points that is contiguous in both selections is moved in one block.
       std::size_t datumLen = num_elements_ * sizeof(DataType);
-      m_select.init_lin_indx();
-      f_select.init_lin_indx();
-      while (!m_select.end_lin_indx()) {
-        std::size_t m_indx = m_select.next_lin_indx() * datumLen;
-        std::size_t f_indx = f_select.next_lin_indx() * datumLen;
-        for (std::size_t i = 0; i < datumLen; ++i) {
-          data[m_indx + i] = c_span[f_indx + i];
-        }
-      }
+      forEachRunPair(m_select, f_select,
+                     [&](std::size_t m_indx, std::size_t f_indx, std::size_t count) {
+        std::memcpy(data.data() + m_indx * datumLen, c_data + f_indx * datumLen,
+                    count * datumLen);
+      });
     }
   }
 };
@@ -140,7 +168,10 @@ public:
 
   /// \brief resizes memory allocated for data storage (vector)
   /// \param newSize new size for allocated memory in number of vector elements
-  void resize(std::size_t newSize) override { var_attr_data_.resize(newSize * num_elements_); }
+  void resize(std::size_t newSize) override {
+    growStorage(var_attr_data_, newSize * num_elements_);
+    var_attr_data_.resize(newSize * num_elements_);
+  }
 
   /// \brief resizes memory allocated for data storage (vector)
   /// \param newSize new size for allocated memory in number of vector elements
@@ -149,9 +180,22 @@ public:
     // At this point, fillValue[0] is a char * pointing to the string
     // to be used for a fill value.
     gsl::span<char *> fv_span(reinterpret_cast<char **>(fillValue.data()), 1);
+    growStorage(var_attr_data_, newSize * num_elements_);
     var_attr_data_.resize(newSize * num_elements_, fv_span[0]);
   }
 
+  /// \brief reserves memory for data storage (vector) without changing its size
+  /// \param newCapacity capacity in number of vector elements
+  void reserve(std::size_t newCapacity) override {
+    var_attr_data_.reserve(newCapacity * num_elements_);
+  }
+
+  /// \brief releases memory reserved beyond the current size of the data storage
+  void shrinkToFit() override { var_attr_data_.shrink_to_fit(); }
+
+  /// \brief returns the capacity of the data storage in number of vector elements
+  std::size_t capacity() const override { return var_attr_data_.capacity() / num_elements_; }
+
   /// \brief transfer data to data storage vector
   /// \param data contiguous block of data to transfer
   /// \param m_select Selection object: how to select from data argument
@@ -168,15 +212,11 @@ public:
       }
 
       // assumes m_select and f_select have same number of points
-      m_select.init_lin_indx();
-      f_select.init_lin_indx();
-      while (!m_select.end_lin_indx()) {
-        std::size_t m_indx     = m_select.next_lin_indx() * num_elements_;
-        std::size_t f_indx     = f_select.next_lin_indx() * num_elements_;
-        for (std::size_t i = 0; i < num_elements_; ++i) {
-          var_attr_data_[f_indx + i] = inStrings[m_indx + i];
-        }
-      }
+      forEachRunPair(m_select, f_select,
+                     [&](std::size_t m_indx, std::size_t f_indx, std::size_t count) {
+        std::copy_n(inStrings.begin() + m_indx * num_elements_, count * num_elements_,
+                    var_attr_data_.begin() + f_indx * num_elements_);
+      });
     }
   }
 
@@ -197,15 +237,11 @@ public:
       gsl::span<char> c_span(reinterpret_cast<char *>(outStrings.data()), numChars);
       // assumes m_select and f_select have same number of points
       std::size_t datumLen = num_elements_ * sizeof(char *);
-      m_select.init_lin_indx();
-      f_select.init_lin_indx();
-      while (!m_select.end_lin_indx()) {
-        std::size_t m_indx = m_select.next_lin_indx() * datumLen;
-        std::size_t f_indx = f_select.next_lin_indx() * datumLen;
-        for (std::size_t i = 0; i < datumLen; ++i) {
-          data[m_indx + i] = c_span[f_indx + i];
-        }
-      }
+      forEachRunPair(m_select, f_select,
+                     [&](std::size_t m_indx, std::size_t f_indx, std::size_t count) {
+        std::memcpy(data.data() + m_indx * datumLen, c_span.data() + f_indx * datumLen,
+                    count * datumLen);
+      });
     }
   }
 };
@@ -13,6 +13,7 @@
 
 #include "./Variables.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <functional>
 #include <numeric>
@@ -93,6 +94,21 @@ void Variable::resize(const std::vector<Dimensions_t>& new_dim_sizes) {
   }
 }
 
+void Variable::reserve(const std::vector<Dimensions_t>& capacity_dim_sizes) {
+  // Storage beyond max_dimensions could never be used.
+  std::size_t numElements = 1;
+  for (std::size_t i = 0; i < capacity_dim_sizes.size(); ++i) {
+    Dimensions_t dimSize = capacity_dim_sizes[i];
+    if ((i < max_dimensions_.size()) && (max_dimensions_[i] >= 0)) {
+      dimSize = std::min(dimSize, max_dimensions_[i]);
+    }
+    numElements *= static_cast<std::size_t>(std::max<Dimensions_t>(dimSize, 0));
+  }
+  var_data_->reserve(numElements);
+}
+
+void Variable::shrinkToFit() { var_data_->shrinkToFit(); }
+
 bool Variable::isOfType(const Type & dtype) const {
   return (dtype == *dtype_);
 }
@@ -174,7 +190,9 @@ std::shared_ptr<Variable> Has_Variables::create(const std::string& name,
 }
 
 std::shared_ptr<Variable> Has_Variables::open(const std::string& name) const {
-  std::shared_ptr<Variable> var;
+  std::shared_ptr<Variable> var = findIndexed(name);
+  if (var) return var;
+
   std::vector<std::string> splitPaths = splitGroupVar(name);
   if (splitPaths.size() > 1) {
     std::shared_ptr<Group> parentGroup = parent_group_.lock();
@@ -186,10 +204,13 @@ std::shared_ptr<Variable> Has_Variables::open(const std::string& name) const {
       throw Exception("Variable not found.", ioda_Here()).add("name", name);
     var = ivar->second;
   }
+  addIndexed(name, var);
   return var;
 }
 
 bool Has_Variables::exists(const std::string& name) const {
+  if (findIndexed(name)) return true;
+
   bool varExists                      = false;
   std::vector<std::string> splitPaths = splitGroupVar(name);
   if (splitPaths.size() > 1) {
@@ -205,6 +226,7 @@ bool Has_Variables::exists(const std::string& name) const {
 }
 
 void Has_Variables::remove(const std::string& name) {
+  ++(*structure_version_);
   std::vector<std::string> splitPaths = splitGroupVar(name);
   if (splitPaths.size() > 1) {
     std::shared_ptr<Group> parentGroup = parent_group_.lock();
@@ -216,6 +238,7 @@ void Has_Variables::remove(const std::string& name) {
 }
 
 void Has_Variables::rename(const std::string& oldName, const std::string& newName) {
+  ++(*structure_version_);
   std::vector<std::string> splitPaths = splitGroupVar(oldName);
   if (splitPaths.size() > 1) {
     std::shared_ptr<Group> parentGroup = parent_group_.lock();
@@ -240,7 +263,36 @@ void Has_Variables::setParentGroup(const std::shared_ptr<Group>& parentGroup) {
   parent_group_ = parentGroup;
 }
 
+void Has_Variables::shareStructureVersion(const Has_Variables& treeVars) {
+  structure_version_ = treeVars.structure_version_;
+  path_index_.clear();
+  path_index_version_ = *structure_version_;
+}
+
 // private methods
+
+std::shared_ptr<Variable> Has_Variables::findIndexed(const std::string& name) const {
+  const std::size_t version = *structure_version_;
+  if (path_index_version_ != version) {
+    path_index_.clear();
+    path_index_version_ = version;
+    return nullptr;
+  }
+  auto ivar = path_index_.find(name);
+  if (ivar == path_index_.end()) return nullptr;
+  return ivar->second.lock();
+}
+
+void Has_Variables::addIndexed(const std::string& name,
+                               const std::shared_ptr<Variable>& var) const {
+  const std::size_t version = *structure_version_;
+  if (path_index_version_ != version) {
+    path_index_.clear();
+    path_index_version_ = version;
+  }
+  path_index_[name] = var;
+}
+
 std::vector<std::string> Has_Variables::splitGroupVar(const std::string& path) {
   std::vector<std::string> splitPath;
   auto pos = path.find_last_of('/');
@@ -12,9 +12,11 @@
  */
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -43,6 +45,11 @@ public:
 };
 
 /// \ingroup ioda_internals_engines_obsstore
+/// \details Each variable owns its storage, and write() and read() only touch the
+/// storage and dimensions of the variable they are called on. Different threads may
+/// therefore write or read different variables at the same time, as long as no
+/// thread creates, removes, renames or resizes variables meanwhile. Access to one
+/// variable from several threads at once needs external locking.
 class Variable : public std::enable_shared_from_this<Variable> {
 private:
   /// \brief dimension sizes (length is rank of dimensions)
@@ -89,6 +96,11 @@ public:
   /// \brief resizes dimensions (but cannot change dimensions themselves)
   /// \param new_dim_sizes new extents for each dimension
   void resize(const std::vector<Dimensions_t>& new_dim_sizes);
+  /// \brief reserves storage so the dimensions can grow without reallocating
+  /// \param capacity_dim_sizes extents for each dimension to reserve storage for
+  void reserve(const std::vector<Dimensions_t>& capacity_dim_sizes);
+  /// \brief releases storage reserved beyond the current dimension sizes
+  void shrinkToFit();
   /// \brief returns true if requested type matches stored type
   bool isOfType(const Type & dtype) const;
   /// \brief returns the ObsStore data type.
@@ -128,6 +140,7 @@ public:
                                 const std::shared_ptr<Variable> scale) const;
 
   /// \brief transfer data to variable storage
+  /// \details May run concurrently with writes to other variables, see the class notes.
   /// \param data contiguous block of data to transfer
   /// \param m_select Selection ojbect: how to select from data argument
   /// \param f_select Selection ojbect: how to select to variable storage
@@ -151,12 +164,41 @@ private:
   /// \brief pointer to parent group
   std::weak_ptr<Group> parent_group_;
 
+  /// \brief index of the variables opened or created through this container, keyed by
+  ///        their (possibly hierarchical) path relative to the parent group
+  /// \details Looking up a path here avoids splitting it and walking the intermediate
+  /// groups. The entries do not keep the variables alive: an entry whose variable has
+  /// been destroyed is simply a miss.
+  mutable std::unordered_map<std::string, std::weak_ptr<Variable>> path_index_;
+
+  /// \brief value of structure_version_ when path_index_ was last validated
+  mutable std::size_t path_index_version_;
+
+  /// \brief counter bumped whenever a variable is removed or renamed in any container
+  ///        of the group tree
+  /// \details The containers of all the groups in one tree share this counter.
+  /// Removing or renaming a variable in a subgroup can make the path index of an
+  /// ancestor container stale, so the path indices of the tree are dropped when it
+  /// changes. Other trees are not affected.
+  std::shared_ptr<std::atomic<std::size_t>> structure_version_;
+
   /// \brief split a path into groups and variable pieces
   /// \param path Hierarchical path
   static std::vector<std::string> splitGroupVar(const std::string& path);
 
+  /// \brief look up a variable in the path index
+  /// \param name path of the variable
+  /// \return the variable, or nullptr if the path is not in the index
+  std::shared_ptr<Variable> findIndexed(const std::string& name) const;
+
+  /// \brief add a variable to the path index
+  /// \param name path of the variable
+  /// \param var the variable
+  void addIndexed(const std::string& name, const std::shared_ptr<Variable>& var) const;
+
 public:
-  Has_Variables() {}
+  Has_Variables()
+      : path_index_version_(0), structure_version_(std::make_shared<std::atomic<std::size_t>>(0)) {}
   ~Has_Variables() {}
 
   /// \brief create a new variable
@@ -193,6 +235,13 @@ public:
   /// \brief set parent group pointer
   /// \param parentGroup pointer to group that owns this Has_Variables object
   void setParentGroup(const std::shared_ptr<Group>& parentGroup);
+
+  /// \brief join the group tree of another container by sharing its structure version
+  /// \param treeVars variable container of a group in the tree being joined
+  void shareStructureVersion(const Has_Variables& treeVars);
+
+  /// \brief returns the structure version of the group tree holding this container
+  std::size_t structureVersion() const { return *structure_version_; }
 };
 #if defined(__INTEL_COMPILER)
 #  pragma warning(pop)
@@ -32,6 +32,7 @@ ReadH5File::ReadH5File(const Parameters_ & params,
     backendParams.fileName = fileName_;
     backendParams.action = BackendFileActions::Open;
     backendParams.openMode = BackendOpenModes::Read_Only;
+    params.tuning.setTuning(backendParams.hdf5Tuning);
 
     Group backend = constructBackend(backendName, backendParams);
     obs_group_ = ObsGroup(backend);
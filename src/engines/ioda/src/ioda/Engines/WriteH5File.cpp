@@ -7,12 +7,17 @@
 
 #include "ioda/Engines/WriteH5File.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "eckit/mpi/Parallel.h"
 
 #include "ioda/Copying.h"   // for the post-processor workaround
 #include "ioda/Engines/EngineUtils.h"
+#include "ioda/Engines/ObsStore.h"  // for the post-processor workaround
+#include "ioda/Variables/VarUtils.h"  // for the post-processor workaround
 
-#include "oops/util/DateTime.h"  // for the post-processor workaround
 #include "oops/util/Logger.h"
 
 namespace ioda {
@@ -62,6 +67,8 @@ WriteH5File::WriteH5File(const Parameters_ & params,
     } else {
         backendParams.createMode = Engines::BackendCreateModes::Fail_If_Exists;
     }
+    params.tuning.setTuning(backendParams.hdf5Tuning);
+    backendParams.hdf5Tuning.fileSpacePageSize = params.fileSpacePageSize;
 
     Group backend = constructBackend(backendName, backendParams);
     obs_group_ = ObsGroup(backend);
@@ -92,27 +99,23 @@ WriteH5Proc::WriteH5Proc(const Parameters_ & params,
 void WriteH5Proc::post() {
     // TODO(srh) Workaround until we get fixed length string support in the netcdf-c
     // library. This is expected to be available in the 4.9.1 release of netcdf-c.
-    // For now move the file with fixed length strings to a temporary
-    // file (obsdataout.obsfile spec with "_flenstr" appended to the filename) and
-    // then copy that file to the intended output file while changing the fixed
-    // length strings to variable length strings.
+    // For now reopen the output file and replace each of the fixed length string
+    // variables written by the ioda writer with a variable length string variable.
+    // Only the string variables are rewritten, the remaining (numeric) variables
+    // are left in place.
     //
     // This function is only called by the io pool processes.
-    //
-    // Create the temp file name, move the output file to the temp file name,
-    // then copy the file to the intended file name.
-    std::string tempFileName;
-    std::string finalFileName;
-    workaroundGenFileNames(finalFileName, tempFileName);
+    std::string fileName;
+    workaroundGenFileName(fileName);
 
     // If the output file was created using parallel io, then we only need rank 0
-    // to do the rename, copy workaround.
+    // to do the workaround.
     if (createParams_.isParallelIo) {
         if (createParams_.comm.rank() == 0) {
-            workaroundFixToVarLenStrings(finalFileName, tempFileName);
+            workaroundFixToVarLenStrings(fileName);
         }
     } else {
-        workaroundFixToVarLenStrings(finalFileName, tempFileName);
+        workaroundFixToVarLenStrings(fileName);
     }
 }
 
@@ -122,91 +125,104 @@ void WriteH5Proc::print(std::ostream & os) const {
 }
 
 //--------------------------------------------------------------------------------------
-void WriteH5Proc::workaroundGenFileNames(std::string & finalFileName,
-                                         std::string & tempFileName) {
-    tempFileName = params_.fileName;
-    finalFileName = tempFileName;
-
-    // Append "_flenstr" (fixed length strings) to the temp file name, then uniquify
-    // in the same manner as the writer backend.
-    std::size_t found = tempFileName.find_last_of(".");
-    if (found == std::string::npos)
-        found = tempFileName.length();
-    tempFileName.insert(found, "_flenstr");
-
+void WriteH5Proc::workaroundGenFileName(std::string & fileName) {
     std::size_t mpiRank = createParams_.comm.rank();
     int mpiTimeRank = -1; // a value of -1 tells uniquifyFileName to skip this value
     if (createParams_.timeComm.size() > 1) {
         mpiTimeRank = createParams_.timeComm.rank();
     }
-    // Tag on the rank number to the output file name to avoid collisions.
-    // Don't use the time communicator rank number in the suffix if the size of
-    // the time communicator is 1.
-    tempFileName = uniquifyFileName(tempFileName, createParams_.createMultipleFiles,
-                                    mpiRank, mpiTimeRank);
-    finalFileName = uniquifyFileName(finalFileName, createParams_.createMultipleFiles,
-                                     mpiRank, mpiTimeRank);
+    // Tag on the rank number to the output file name in the same manner as the
+    // writer backend. Don't use the time communicator rank number in the suffix if
+    // the size of the time communicator is 1.
+    fileName = uniquifyFileName(params_.fileName, createParams_.createMultipleFiles,
+                                mpiRank, mpiTimeRank);
 }
 
-void WriteH5Proc::workaroundFixToVarLenStrings(const std::string & finalFileName,
-                                               const std::string & tempFileName) {
+void WriteH5Proc::workaroundFixToVarLenStrings(const std::string & fileName) {
     oops::Log::debug() << "WriterPool::finalize: applying flen to vlen strings workaround: "
-                       << tempFileName << " -> "
-                       << finalFileName << std::endl;
+                       << fileName << std::endl;
 
-    // Rename the output file, then copy back to the original name while changing the
-    // strings back to variable length strings.
-    if (std::rename(finalFileName.c_str(), tempFileName.c_str()) != 0) {
-        throw Exception("Unable to rename output file.", ioda_Here());
+    // Reopen the output file for update.
+    Engines::BackendCreationParameters backendParams;
+    backendParams.fileName = fileName;
+    backendParams.action = Engines::BackendFileActions::Open;
+    backendParams.openMode = Engines::BackendOpenModes::Read_Write;
+    params_.tuning.setTuning(backendParams.hdf5Tuning);
+    Group fileGroup = constructBackend(Engines::BackendNames::Hdf5File, backendParams);
+
+    VarUtils::Vec_Named_Variable varList, dimVarList;
+    VarUtils::VarDimMap dimsAttachedToVars;
+    Dimensions_t maxVarSize0;
+    VarUtils::collectVarDimInfo(fileGroup, varList, dimVarList, dimsAttachedToVars,
+                                maxVarSize0);
+
+    // The fixed length string variables are marked by the ioda writer with the
+    // "_orig_fill_value" attribute.
+    std::vector<std::string> stringVarNames;
+    for (const auto * namedVars : { &dimVarList, &varList }) {
+        for (const auto & namedVar : *namedVars) {
+            if (namedVar.var.isA<std::string>() &&
+                namedVar.var.atts.exists("_orig_fill_value")) {
+                stringVarNames.push_back(namedVar.name);
+            }
+        }
     }
 
-    // Create backends for reading the temp file and writing the final file.
-    // Reader backend
-    eckit::LocalConfiguration readerConfig;
-    eckit::LocalConfiguration readerSubConfig;
-    readerSubConfig.set("type", "H5File");
-    readerSubConfig.set("obsfile", tempFileName);
-    readerConfig.set("engine", readerSubConfig);
-
-    WorkaroundReaderParameters readerParams;
-    readerParams.validateAndDeserialize(readerConfig);
-    const bool isParallel = false;
-    const util::DateTime windowStart("1000-01-01T00:00:00Z");   // use a window that will
-    const util::DateTime windowEnd("3000-01-01T00:00:00Z");     // accept all of the obs
-    Engines::ReaderCreationParameters readerCreateParams(windowStart, windowEnd,
-        createParams_.comm, createParams_.timeComm, {}, isParallel);
-    std::unique_ptr<Engines::ReaderBase> readerEngine = Engines::ReaderFactory::create(
-          readerParams.engine.value().engineParameters, readerCreateParams);
-
-    // Writer backend
-    WorkaroundWriterParameters writerParams;
-    eckit::LocalConfiguration writerConfig;
-    eckit::LocalConfiguration writerSubConfig;
-    writerSubConfig.set("type", "H5File");
-    writerSubConfig.set("obsfile", finalFileName);
-    writerConfig.set("engine", writerSubConfig);
-    std::unique_ptr<Engines::WriterBase> workaroundWriter;
-
-    // We want each rank to write its own corresponding file, and that can be accomplished
-    // in telling the writer that we are to create multiple files and not use the parallel
-    // io mode.
-    writerParams.validateAndDeserialize(writerConfig);
-    const bool createMultipleFiles = false;
-    Engines::WriterCreationParameters writerCreateParams(
-        createParams_.comm, createParams_.timeComm, createMultipleFiles, isParallel);
-    std::unique_ptr<Engines::WriterBase> writerEngine = Engines::WriterFactory::create(
-          writerParams.engine.value().engineParameters, writerCreateParams);
-
-    // Copy the contents from the temp file to the final file.
-    Group readerTopGroup = readerEngine->getObsGroup();
-    Group writerTopGroup = writerEngine->getObsGroup();
-    copyGroup(readerTopGroup, writerTopGroup);
-
-    // If we made it to here, we successfully copied the file, so we can remove
-    // the temporary file.
-    if (std::remove(tempFileName.c_str()) != 0) {
-        oops::Log::info() << "WARNING: Unable to remove temporary output file: "
-                          << tempFileName << std::endl;
+    for (const auto & varName : stringVarNames) {
+        Variable oldVar = fileGroup.vars.open(varName);
+        std::vector<std::string> varData;
+        oldVar.read<std::string>(varData);
+        const Dimensions varDims = oldVar.getDimensions();
+        VariableCreationParameters params = oldVar.getCreationParameters(false, false);
+        params.noCompress();
+        std::string fillValue;
+        oldVar.atts.open("_orig_fill_value").read<std::string>(fillValue);
+        params.setFillValue<std::string>(fillValue);
+
+        // Hold on to the attributes while the variable is replaced.
+        Group attrHolder = ObsStore::createRootGroup();
+        copyAttributes(oldVar.atts, attrHolder.atts);
+
+        // If the variable is a dimension scale, detach it from the variables using it.
+        // Removing the variable takes care of detaching the scales attached to it.
+        const bool isDimScale = oldVar.isDimensionScale();
+        const std::string dimScaleName = isDimScale ? oldVar.getDimensionScaleName() : "";
+        std::vector<std::pair<std::string, unsigned int>> scaleUsers;
+        for (const auto & attached : dimsAttachedToVars) {
+            for (std::size_t i = 0; i < attached.second.size(); ++i) {
+                if (attached.second[i].name == varName) {
+                    scaleUsers.emplace_back(attached.first.name, i);
+                }
+            }
+        }
+        for (const auto & scaleUser : scaleUsers) {
+            fileGroup.vars.open(scaleUser.first).detachDimensionScale(scaleUser.second, oldVar);
+        }
+        fileGroup.vars.remove(varName);
+
+        // Recreate the variable with variable length strings and restore the attributes
+        // and the dimension scale associations.
+        Variable newVar = fileGroup.vars.create<std::string>(varName, varDims, params);
+        copyAttributes(attrHolder.atts, newVar.atts);
+        newVar.write<std::string>(varData);
+        if (isDimScale) {
+            newVar.setIsDimensionScale(dimScaleName);
+            for (const auto & scaleUser : scaleUsers) {
+                fileGroup.vars.open(scaleUser.first).attachDimensionScale(scaleUser.second,
+                                                                          newVar);
+            }
+        } else {
+            const auto attached = std::find_if(dimsAttachedToVars.begin(),
+                dimsAttachedToVars.end(), [&varName](const VarUtils::VarDimMap::value_type & v) {
+                    return v.first.name == varName;
+                });
+            if (attached != dimsAttachedToVars.end()) {
+                for (std::size_t i = 0; i < attached->second.size(); ++i) {
+                    newVar.attachDimensionScale(i,
+                        fileGroup.vars.open(attached->second[i].name));
+                }
+            }
+        }
     }
 }
 
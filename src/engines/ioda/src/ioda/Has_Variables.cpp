@@ -12,8 +12,12 @@
 #include "ioda/Misc/MergeMethods.h"
 #include "ioda/Misc/StringFuncs.h"
 #include "ioda/Misc/UnitConversions.h"
+#include "ioda/Variables/FillPolicy.h"
 
+#include <atomic>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace ioda {
 namespace detail {
@@ -203,6 +207,19 @@ void Has_Variables_Base::stitchComplementaryVariables(bool removeOriginals) {
   }
 }
 
+namespace {
+template <class T>
+void convertVariableColumn(const std::string &unit, Variable &var) {
+  std::vector<T> data = var.readAsVector<T>();
+  if (var.hasFillValue()) {
+    convertColumn(unit, data, detail::getFillValue<T>(var.getFillValue()));
+  } else {
+    convertColumn(unit, data, FillValuePolicies::netCDF4_default<T>());
+  }
+  var.write(data);
+}
+}  // namespace
+
 void Has_Variables_Base::convertVariableUnits(std::ostream& out) {
   try {
     if (layout_->name() != std::string("ObsGroup ODB v1")) return;
@@ -216,9 +233,15 @@ void Has_Variables_Base::convertVariableUnits(std::ostream& out) {
       if (unit.first == true) {
         Variable variableToConvert = this->open(destinationName);
         try {
-          std::vector<double> outputData = variableToConvert.readAsVector<double>();
-          convertColumn(unit.second, outputData);
-          variableToConvert.write(outputData);
+          // Convert in the variable's own type so that float and int columns are
+          // not round-tripped through double. Missing values are left as is.
+          if (variableToConvert.isA<float>()) {
+            convertVariableColumn<float>(unit.second, variableToConvert);
+          } else if (variableToConvert.isA<int>()) {
+            convertVariableColumn<int>(unit.second, variableToConvert);
+          } else {
+            convertVariableColumn<double>(unit.second, variableToConvert);
+          }
           variableToConvert.atts.add<std::string>("units", getSIUnit(unit.second));
         } catch (std::invalid_argument) {
           out << "The unit specified in ODB mapping file '" << unit.second
@@ -286,6 +309,14 @@ std::vector<std::string> Has_Variables_Base::list() const {
   }
 }
 
+std::size_t Has_Variables_Base::structureVersion() const {
+  if (backend_ == nullptr) {
+    static std::atomic<std::size_t> untrackedVersion{0};
+    return ++untrackedVersion;
+  }
+  return backend_->structureVersion();
+}
+
 /// @todo Extend collective variable creation interface to Python.
 Variable Has_Variables_Base::_create_py(const std::string& name, BasicTypes dataType,
                              const std::vector<Dimensions_t>& cur_dimensions,
@@ -488,6 +519,7 @@ VariableCreationParameters::VariableCreationParameters(const VariableCreationPar
       chunks{r.chunks},
       gzip_{r.gzip_},
       szip_{r.szip_},
+      shuffle_{r.shuffle_},
       gzip_level_{r.gzip_level_},
       szip_PixelsPerBlock_{r.szip_PixelsPerBlock_},
       szip_options_{r.szip_options_},
@@ -502,6 +534,7 @@ VariableCreationParameters& VariableCreationParameters::operator=(
   chunks               = r.chunks;
   gzip_                = r.gzip_;
   szip_                = r.szip_;
+  shuffle_             = r.shuffle_;
   gzip_level_          = r.gzip_level_;
   szip_PixelsPerBlock_ = r.szip_PixelsPerBlock_;
   szip_options_        = r.szip_options_;
@@ -520,6 +553,7 @@ void VariableCreationParameters::compressWithGZIP(int level) {
   gzip_       = true;
   gzip_level_ = level;
 }
+void VariableCreationParameters::setShuffle(bool shuffle) { shuffle_ = shuffle; }
 void VariableCreationParameters::compressWithSZIP(unsigned PixelsPerBlock, unsigned options) {
   gzip_                = false;
   szip_                = true;
@@ -66,6 +66,115 @@ void IoPoolBase::setTargetPoolSize() {
     }
 }
  
+//--------------------------------------------------------------------------------------
+void IoPoolBase::groupRanks(IoPoolGroupMap & rankGrouping) {
+    rankGrouping.clear();
+    if (rank_all_ == 0) {
+        // We want the order of the locations in the resulting single output file after
+        // concatenating the output files created by the io pool. To do this we need to
+        // assign the tiles (block of locations from a given rank in the all_comm_ group)
+        // in numeric order since this is how the concatenator puts together the files
+        // from the current code. Ie, we want the tiles from rank 0 first, rank 1 second,
+        // rank 2 third and so on.
+        //
+        // We also want to avoid transferring data between ranks selected for the io pool
+        // since this isn't necessary. Ie, each rank in the pool should own its own tile.
+        //
+        // To accomplish this, divide the total number of ranks into groupings of an even
+        // number of ranks under the assumption that the obs are fairly well load balanced.
+        // TODO(srh) This assumption likely falls apart with the halo distribution but that
+        // can be addressed later. If needed we can do the same type of grouping but base
+        // it on the number of locations instead of the ranks which will make the MPI
+        // transfers more complicated.
+        //
+        // This grouping always places rank 0 in the io pool, which the reader relies upon
+        // for sharing the input file structure with the ranks outside the pool.
+        int base_assign_size = size_all_ / target_pool_size_;
+        int rem_assign_size = size_all_ % target_pool_size_;
+        int start = 0;
+        for (int i = 0; i < target_pool_size_; ++i) {
+            int count = base_assign_size;
+            if (i < rem_assign_size) {
+                count += 1;
+            }
+            // start is the rank that goes into the pool, and the remaining sequence
+            // of count-1 numbers starting with start+1 are the non pool ranks that
+            // are associated with the pool rank (start).
+            std::vector<int> rankGroup(count - 1);
+            std::iota(rankGroup.begin(), rankGroup.end(), start + 1);
+            rankGrouping.insert(std::make_pair(start, rankGroup));
+            start += count;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------
+void IoPoolBase::assignRanksToIoPool(const std::size_t nlocs,
+                                     const IoPoolGroupMap & rankGrouping) {
+    constexpr int mpiTagBase = 10000;
+
+    // Collect the nlocs from all of the other ranks.
+    std::vector<std::size_t> allNlocs(size_all_);
+    comm_all_.allGather(nlocs, allNlocs.begin(), allNlocs.end());
+
+    if (rank_all_ == 0) {
+        // Follow the grouping that is contained in the rankGrouping structure to create
+        // the assignments for the MPI send/recv transfers. The rankAssignments structure
+        // contains the mapping that is required to effect the proper MPI send/recv
+        // transfers. A pool rank will receive from one or more non pool ranks and the
+        // non pool ranks will send to one pool rank. The outer vector of rankAssignments
+        // is indexed by the all_comm_ rank number, and the inner vector contains the list
+        // of ranks the outer index rank interacts with for data transfers. Once constructed,
+        // each inner vector of rankAssignments is sent to the associated rank in the
+        // comm_all_ group.
+        std::vector<std::vector<std::pair<int, int>>> rankAssignments(size_all_);
+        std::vector<int> rankAssignSizes(size_all_, 0);
+        for (auto & rankGroup : rankGrouping) {
+            // rankGroup is a std::pair<int, std::vector<int>>
+            // The first element is the pool rank, and the second element is
+            // the list of associated non pool ranks.
+            std::vector<std::pair<int, int>> rankGroupPairs(rankGroup.second.size());
+            std::size_t i = 0;
+            for (auto & nonPoolRank : rankGroup.second) {
+                rankGroupPairs[i] = std::make_pair(nonPoolRank, allNlocs[nonPoolRank]);
+                std::vector<std::pair<int, int>> associatedPoolRank;
+                associatedPoolRank.push_back(
+                    std::make_pair(rankGroup.first, allNlocs[nonPoolRank]));
+                rankAssignments[nonPoolRank] = associatedPoolRank;
+                rankAssignSizes[nonPoolRank] = 1;
+                i += 1;
+            }
+            rankAssignments[rankGroup.first] = rankGroupPairs;
+            rankAssignSizes[rankGroup.first] = rankGroupPairs.size();
+        }
+
+        // Send the rank assignments to the other ranks. Use scatter to spread the
+        // sizes (number of ranks) in each rank's assignment. Then use send/receive
+        // to transfer each ranks assignment.
+        int myRankAssignSize;
+        comm_all_.scatter(rankAssignSizes, myRankAssignSize, 0);
+
+        // Copy my assignment directory. Use MPI send/recv for all other ranks.
+        rank_assignment_ = rankAssignments[0];
+        for (std::size_t i = 1; i < rankAssignments.size(); ++i) {
+            if (rankAssignSizes[i] > 0) {
+                comm_all_.send(rankAssignments[i].data(), rankAssignSizes[i], i, mpiTagBase + i);
+            }
+        }
+    } else {
+        // Receive the rank assignments from rank 0. First use scatter to receive the
+        // sizes (number of ranks) in this rank's assignment.
+        int myRankAssignSize;
+        std::vector<int> dummyVector(size_all_);
+        comm_all_.scatter(dummyVector, myRankAssignSize, 0);
+
+        rank_assignment_.resize(myRankAssignSize);
+        if (myRankAssignSize > 0) {
+            comm_all_.receive(rank_assignment_.data(), myRankAssignSize, 0, mpiTagBase + rank_all_);
+        }
+    }
+}
+
 //--------------------------------------------------------------------------------------
 void IoPoolBase::createIoPool(IoPoolGroupMap & rankGrouping) {
     int myColor;
@@ -96,6 +205,20 @@ void IoPoolBase::createIoPool(IoPoolGroupMap & rankGrouping) {
         rank_pool_ = comm_pool_->rank();
         size_pool_ = comm_pool_->size();
     }
+    owns_pool_comms_ = true;
+}
+
+//--------------------------------------------------------------------------------------
+void IoPoolBase::deleteIoPool() {
+    if (owns_pool_comms_) {
+        if (eckit::mpi::hasComm(poolCommName)) {
+            eckit::mpi::deleteComm(poolCommName);
+        }
+        if (eckit::mpi::hasComm(nonPoolCommName)) {
+            eckit::mpi::deleteComm(nonPoolCommName);
+        }
+        owns_pool_comms_ = false;
+    }
 }
 
 //--------------------------------------------------------------------------------------
@@ -150,9 +273,14 @@ IoPoolBase::IoPoolBase(const oops::Parameter<IoPoolParameters> & ioPoolParams,
                      comm_all_(commAll), rank_all_(commAll.rank()), size_all_(commAll.size()),
                      comm_time_(commTime), rank_time_(commTime.rank()),
                      size_time_(commTime.size()), win_start_(winStart), win_end_(winEnd),
-                     total_nlocs_(0), global_nlocs_(0) {
+                     total_nlocs_(0), global_nlocs_(0), comm_pool_(nullptr),
+                     owns_pool_comms_(false) {
 }
 
-IoPoolBase::~IoPoolBase() = default;
+// Release the split communicator groups here as well as in finalize so that they do not
+// outlive a pool whose owner throws before calling finalize.
+IoPoolBase::~IoPoolBase() {
+    deleteIoPool();
+}
 
 }  // namespace ioda
@@ -100,9 +100,48 @@ void ObsGroup::resize(const std::vector<std::pair<Variable, ioda::Dimensions_t>>
 
 void ObsGroup::resizeVars(Group& g,
                           const std::vector<std::pair<Variable, ioda::Dimensions_t>>& newDims)
+{
+  visitDependentVars(g, newDims, [](Variable& var, const std::vector<Dimensions_t>& varNewDims) {
+    var.resize(varNewDims);
+  });
+}
+
+void ObsGroup::reserve(const std::vector<std::pair<Variable, ioda::Dimensions_t>>& capacityDims) {
+  try {
+    for (std::size_t i = 0; i < capacityDims.size(); ++i) {
+      Variable var = capacityDims[i].first;
+      var.reserve({capacityDims[i].second});
+    }
+    visitDependentVars(*this, capacityDims,
+                       [](Variable& var, const std::vector<Dimensions_t>& varCapacityDims) {
+      var.reserve(varCapacityDims);
+    });
+  } catch (...) {
+    std::throw_with_nested(Exception(
+      "An exception occurred inside ioda while reserving storage for an ObsGroup.",
+      ioda_Here()));
+  }
+}
+
+void ObsGroup::shrinkToFit() {
+  try {
+    auto groupVars = listObjects(ObjectType::Variable, true)[ObjectType::Variable];
+    for (const auto& varName : groupVars) {
+      vars.open(varName).shrinkToFit();
+    }
+  } catch (...) {
+    std::throw_with_nested(Exception(
+      "An exception occurred inside ioda while releasing storage for an ObsGroup.",
+      ioda_Here()));
+  }
+}
+
+void ObsGroup::visitDependentVars(
+    Group& g, const std::vector<std::pair<Variable, ioda::Dimensions_t>>& newDims,
+    const std::function<void(Variable&, const std::vector<Dimensions_t>&)>& varFunc)
 {
   try {
-    // Visit the variables in this group, and resize according to
+    // Visit the variables in this group, and update their dimensions according to
     // what's in the newDims vector.
     auto groupVars = g.listObjects(ObjectType::Variable, true)[ObjectType::Variable];
     for (std::size_t i = 0; i < groupVars.size(); ++i) {
@@ -128,7 +167,7 @@ void ObsGroup::resizeVars(Group& g,
             }
           }
         }
-        var.resize(varNewDims);
+        varFunc(var, varNewDims);
       }
     }
   } catch (...) {
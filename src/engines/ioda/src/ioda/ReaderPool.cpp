@@ -27,28 +27,6 @@
 
 namespace ioda {
 
-constexpr int defaultMaxPoolSize = 10;
-
-// These next two constants are the "color" values used for the MPI split comm command.
-// They just need to be two different numbers, which will create the pool communicator,
-// and a second communicator that holds all of the other ranks not in the pool.
-//
-// Unfortunately, the eckit interface doesn't appear to support using MPI_UNDEFINED for
-// the nonPoolColor. Ie, you need to assign all ranks into a communcator group.
-constexpr int poolColor = 1;
-constexpr int nonPoolColor = 2;
-const char poolCommName[] = "IoPool";
-const char nonPoolCommName[] = "NonIoPool";
-
-//--------------------------------------------------------------------------------------
-void ReaderPool::groupRanks(IoPoolGroupMap & rankGrouping) {
-}
-
-//--------------------------------------------------------------------------------------
-void ReaderPool::assignRanksToIoPool(const std::size_t nlocs,
-                                     const IoPoolGroupMap & rankGrouping) {
-}
-
 //--------------------------------------------------------------------------------------
 ReaderPool::ReaderPool(const oops::Parameter<IoPoolParameters> & ioPoolParams,
                const oops::RequiredPolymorphicParameter
@@ -58,36 +36,77 @@ ReaderPool::ReaderPool(const oops::Parameter<IoPoolParameters> & ioPoolParams,
                const std::vector<std::string> & obsVarNames)
                    : IoPoolBase(ioPoolParams, commAll, commTime, winStart, winEnd),
                      reader_params_(readerParams), obs_var_names_(obsVarNames) {
-}
+    // Set the pool size. This is the minimum of the specified max pool size or
+    // the size of the comm_all_ communicator group.
+    setTargetPoolSize();
+
+    // This call will return a data structure that shows how to assign the ranks
+    // to the io pools, plus which non io pool ranks get associated with the io pool
+    // ranks. Only rank 0 needs to do this.
+    IoPoolGroupMap rankGrouping;
+    groupRanks(rankGrouping);
+
+    // The reader does not use rank assignments: the frames are distributed from the
+    // pool ranks listed in pool_ranks_.
+    // Create the io pool communicator group using the split communicator command.
+    createIoPool(rankGrouping);
+
+    // Let every rank know which ranks are in the io pool. These are the ranks that
+    // will be sending frames of data read from the input file.
+    int poolMember = (comm_pool_ == nullptr) ? -1 : rank_all_;
+    std::vector<int> poolMembers(size_all_);
+    comm_all_.allGather(poolMember, poolMembers.begin(), poolMembers.end());
+    for (auto & rank : poolMembers) {
+        if (rank >= 0) {
+            pool_ranks_.push_back(rank);
+        }
+    }
 
-ReaderPool::~ReaderPool() = default;
+    // For now, the pool ranks read the input file independently of each other.
+    is_parallel_io_ = false;
+}
 
-//--------------------------------------------------------------------------------------
+ReaderPool::~ReaderPool() {
+    // Release the split communicator groups if finalize was not reached.
+    deleteIoPool();
+}
 
 //--------------------------------------------------------------------------------------
-void ReaderPool::load(Group & destGroup) {
-    Group fileGroup;
+std::unique_ptr<Engines::ReaderBase> ReaderPool::createReaderEngine() {
+    std::unique_ptr<Engines::ReaderBase> readerEngine;
     if (comm_pool_ != nullptr) {
         Engines::ReaderCreationParameters
             createParams(win_start_, win_end_, *comm_pool_, comm_time_,
                          obs_var_names_, is_parallel_io_);
-        std::unique_ptr<Engines::ReaderBase> readerEngine =
-            Engines::ReaderFactory::create(reader_params_, createParams);
-
-        fileGroup = readerEngine->getObsGroup();
+        readerEngine = Engines::ReaderFactory::create(reader_params_, createParams);
 
         // collect the destination from the reader engine instance
         std::ostringstream ss;
         ss << *readerEngine;
         readerDest_ = ss.str();
     }
+    return readerEngine;
+}
+
+//--------------------------------------------------------------------------------------
+void ReaderPool::load(Group & destGroup) {
+    Group fileGroup;
+    std::unique_ptr<Engines::ReaderBase> readerEngine = createReaderEngine();
+    if (readerEngine != nullptr) {
+        fileGroup = readerEngine->getObsGroup();
+    }
 
-    // Copy the ObsSpace ObsGroup to the output file Group.
+    // Copy the input file Group to the ObsSpace ObsGroup.
     ioReadGroup(*this, fileGroup, destGroup, is_parallel_io_);
 }
 
 //--------------------------------------------------------------------------------------
 void ReaderPool::finalize() {
+    oops::Log::trace() << "ReaderPool::finalize, start" << std::endl;
+    // At this point there are two split communicator groups: one for the io pool and the
+    // other for the processes not included in the io pool.
+    deleteIoPool();
+    oops::Log::trace() << "ReaderPool::finalize, end" << std::endl;
 }
 
 //--------------------------------------------------------------------------------------
@@ -9,6 +9,8 @@
 
 #include "ioda/Io/ReaderUtils.h"
 
+#include <numeric>
+
 #include "eckit/mpi/Comm.h"
 
 #include "ioda/Group.h"
@@ -20,4 +22,55 @@ void ioReadGroup(const ioda::ReaderPool & ioPool, const ioda::Group& fileGroup,
                  ioda::Group& memGroup, const bool isParallelIo) {
 }
 
+void packStrings(const std::vector<std::string> & strings, std::vector<int> & lengths,
+                 std::vector<char> & chars) {
+    lengths.resize(strings.size());
+    std::size_t numChars = 0;
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        lengths[i] = strings[i].size();
+        numChars += strings[i].size();
+    }
+    chars.clear();
+    chars.reserve(numChars);
+    for (auto & str : strings) {
+        chars.insert(chars.end(), str.begin(), str.end());
+    }
+}
+
+void unpackStrings(const std::vector<int> & lengths, const std::vector<char> & chars,
+                   std::vector<std::string> & strings) {
+    strings.resize(lengths.size());
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < lengths.size(); ++i) {
+        strings[i].assign(chars.data() + offset, lengths[i]);
+        offset += lengths[i];
+    }
+}
+
+void broadcastStrings(const eckit::mpi::Comm & comm, std::vector<std::string> & strings,
+                      const int root) {
+    std::vector<int> lengths;
+    std::vector<char> chars;
+    if (comm.rank() == root) {
+        packStrings(strings, lengths, chars);
+    }
+
+    // Send the lengths first so the other ranks can size the character buffer.
+    std::size_t numStrings = lengths.size();
+    comm.broadcast(numStrings, root);
+    lengths.resize(numStrings);
+    if (numStrings > 0) {
+        comm.broadcast(lengths, root);
+    }
+    std::size_t numChars = std::accumulate(lengths.begin(), lengths.end(), std::size_t(0));
+    chars.resize(numChars);
+    if (numChars > 0) {
+        comm.broadcast(chars, root);
+    }
+
+    if (comm.rank() != root) {
+        unpackStrings(lengths, chars, strings);
+    }
+}
+
 }  // namespace ioda
@@ -6,24 +6,50 @@
  */
 #include "ioda/Misc/UnitConversions.h"
 #include "ioda/Exception.h"
+#include "ioda/Units.h"
 
-#include <functional>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
 namespace ioda {
-void convertColumn(const std::string &unit, std::vector<double> &dataToConvert) {
+namespace {
+const detail::AffineUnitConversion &getUnitConversion(const std::string &unit) {
   try {
-    std::function<double(double)> conversionFunction = detail::unitConversionEquations.at(unit);
-    for (double& value : dataToConvert) {
-      value = conversionFunction(value);
-    }
+    return detail::unitConversionEquations.at(unit);
   } catch (std::out_of_range) {
     throw Exception("unit does not have a defined unit conversion equation", ioda_Here())
       .add("unit", unit);
   }
 }
+}  // namespace
+
+void convertColumn(const std::string &unit, std::vector<double> &dataToConvert) {
+  const detail::AffineUnitConversion &conversion = getUnitConversion(unit);
+  udunits::detail::affineConvert(dataToConvert.data(), dataToConvert.size(),
+                                 dataToConvert.data(), conversion.scale, conversion.offset);
+}
+void convertColumn(const std::string &unit, std::vector<double> &dataToConvert,
+                   double missingValue) {
+  const detail::AffineUnitConversion &conversion = getUnitConversion(unit);
+  udunits::detail::affineConvert(dataToConvert.data(), dataToConvert.size(),
+                                 dataToConvert.data(), conversion.scale, conversion.offset,
+                                 missingValue);
+}
+void convertColumn(const std::string &unit, std::vector<float> &dataToConvert,
+                   float missingValue) {
+  const detail::AffineUnitConversion &conversion = getUnitConversion(unit);
+  udunits::detail::affineConvert(dataToConvert.data(), dataToConvert.size(),
+                                 dataToConvert.data(), conversion.scale, conversion.offset,
+                                 missingValue);
+}
+void convertColumn(const std::string &unit, std::vector<int> &dataToConvert,
+                   int missingValue) {
+  const detail::AffineUnitConversion &conversion = getUnitConversion(unit);
+  udunits::detail::affineConvert(dataToConvert.data(), dataToConvert.size(),
+                                 dataToConvert.data(), conversion.scale, conversion.offset,
+                                 missingValue);
+}
 std::string getSIUnit(const std::string &unit) {
   try {
     std::string siUnit = detail::equivalentSIUnit.at(unit);
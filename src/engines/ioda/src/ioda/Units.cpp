@@ -12,6 +12,8 @@
 
 #include <udunits2.h>
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <iostream>
 #include <map>
@@ -28,7 +30,9 @@ class Converter_impl : public Converter {
   std::shared_ptr<cv_converter> converter_;
 
 public:
-  Converter_impl(std::shared_ptr<cv_converter> converter) : converter_(converter) {}
+  Converter_impl(std::shared_ptr<cv_converter> converter) : converter_(converter) {
+    if (converter_) detectAffine();
+  }
   virtual ~Converter_impl() = default;
   float* convert(const float* in, size_t N, float* out) const final {
     return cv_convert_floats(converter_.get(), in, N, out);
@@ -69,6 +73,29 @@ static int handle_log(const char* fmt, va_list args) {
 
 Converter::~Converter() = default;
 
+void Converter::detectAffine() {
+  // Fit scale and offset through two points, then check the fit at points spread over
+  // the range of typical values. Nonlinear (e.g. logarithmic) conversions fail the check
+  // and keep using udunits.
+  const double probes[] = {0., 1., -273.15, 1013.25, 1.e6};
+  const size_t nprobes  = sizeof(probes) / sizeof(probes[0]);
+  double results[nprobes];
+  convert(probes, nprobes, results);
+
+  const double offset = results[0];
+  const double scale  = results[1] - results[0];
+  if (!std::isfinite(offset) || !std::isfinite(scale)) return;
+  for (size_t i = 2; i < nprobes; ++i) {
+    const double expected = scale * probes[i] + offset;
+    if (!std::isfinite(results[i])
+        || std::abs(results[i] - expected) > 1.e-12 * std::max(1., std::abs(results[i])))
+      return;
+  }
+  scale_  = scale;
+  offset_ = offset;
+  affine_ = true;
+}
+
 Units::~Units() = default;
 Units::Units(std::shared_ptr<detail::udunits_units_impl> impl) : impl_{impl} {}
 Units::Units(const std::string& units_str) { *this = UnitsInterface::instance().units(units_str); }
@@ -251,6 +251,29 @@ Variable Variable_Base<>::resize(const std::vector<Dimensions_t>& newDims) {
   }
 }
 
+template <>
+void Variable_Base<>::reserve(const std::vector<Dimensions_t>& capacityDims) {
+  try {
+    // Reserving storage is only a hint, so backends without support ignore it.
+    if (backend_ != nullptr) backend_->reserve(capacityDims);
+  } catch (...) {
+    std::throw_with_nested(Exception(
+      "An exception occurred inside ioda while reserving storage for a variable.",
+      ioda_Here()));
+  }
+}
+
+template <>
+void Variable_Base<>::shrinkToFit() {
+  try {
+    if (backend_ != nullptr) backend_->shrinkToFit();
+  } catch (...) {
+    std::throw_with_nested(Exception(
+      "An exception occurred inside ioda while releasing storage for a variable.",
+      ioda_Here()));
+  }
+}
+
 template <>
 Variable Variable_Base<>::attachDimensionScale(unsigned int DimensionNumber,
                                                const Variable& scale) {
@@ -411,6 +434,20 @@ Variable Variable_Base<>::parallelWrite(gsl::span<const char> data,
   }
 }
 
+template <>
+Variable Variable_Base<>::collectiveWrite(gsl::span<const char> data,
+                          const Type& in_memory_dataType,
+                          const Selection& mem_selection, const Selection& file_selection) {
+  try {
+    if (backend_ == nullptr)
+      throw Exception("Missing backend or unimplemented backend function.", ioda_Here());
+    return backend_->collectiveWrite(data, in_memory_dataType, mem_selection, file_selection);
+  } catch (...) {
+    std::throw_with_nested(Exception(
+      "An exception occurred inside ioda while writing data to a variable.", ioda_Here()));
+  }
+}
+
 template <>
 Variable Variable_Base<>::read(gsl::span<char> data, const Type& in_memory_dataType,
                                const Selection& mem_selection,
@@ -19,6 +19,7 @@
 
 #include "ioda/Copying.h"
 #include "ioda/Engines/EngineUtils.h"
+#include "ioda/Engines/HH.h"
 #include "ioda/Exception.h"
 #include "ioda/Io/WriterUtils.h"
 
@@ -26,123 +27,75 @@
 
 namespace ioda {
 
-constexpr int defaultMaxPoolSize = 10;
-
-// These next two constants are the "color" values used for the MPI split comm command.
-// They just need to be two different numbers, which will create the pool communicator,
-// and a second communicator that holds all of the other ranks not in the pool.
-//
-// Unfortunately, the eckit interface doesn't appear to support using MPI_UNDEFINED for
-// the nonPoolColor. Ie, you need to assign all ranks into a communcator group.
-constexpr int poolColor = 1;
-constexpr int nonPoolColor = 2;
-const char poolCommName[] = "IoPool";
-const char nonPoolCommName[] = "NonIoPool";
+constexpr std::size_t defaultChunkBytes = 1048576;
+constexpr int maxCompressionLevel = 9;
 
 //--------------------------------------------------------------------------------------
-void WriterPool::groupRanks(IoPoolGroupMap & rankGrouping) {
-    rankGrouping.clear();
-    if (rank_all_ == 0) {
-        // We want the order of the locations in the resulting single output file after
-        // concatenating the output files created by the io pool. To do this we need to
-        // assign the tiles (block of locations from a given rank in the all_comm_ group)
-        // in numeric order since this is how the concatenator puts together the files
-        // from the current code. Ie, we want the tiles from rank 0 first, rank 1 second,
-        // rank 2 third and so on.
-        //
-        // We also want to avoid transferring data between ranks selected for the io pool
-        // since this isn't necessary. Ie, each rank in the pool should own its own tile.
-        //
-        // To accomplish this, divide the total number of ranks into groupings of an even
-        // number of ranks under the assumption that the obs are fairly well load balanced.
-        // TODO(srh) This assumption likely falls apart with the halo distribution but that
-        // can be addressed later. If needed we can do the same type of grouping but base
-        // it on the number of locations instead of the ranks which will make the MPI
-        // transfers more complicated.
-        int base_assign_size = size_all_ / target_pool_size_;
-        int rem_assign_size = size_all_ % target_pool_size_;
-        int start = 0;
-        for (std::size_t i = 0; i < target_pool_size_; ++i) {
-            int count = base_assign_size;
-            if (i < rem_assign_size) {
-                count += 1;
+void WriterPool::setCompressionInfo() {
+    compression_level_ = 0;
+    collective_write_ = false;
+    chunk_alignment_ = 0;
+    if (comm_pool_ == nullptr) {
+        return;
+    }
+
+    compression_level_ = std::min(std::max(params_.value().compressionLevel.value(), 0),
+                                  maxCompressionLevel);
+    if ((compression_level_ > 0) && is_parallel_io_ &&
+        !Engines::HH::haveParallelFilteredWrites()) {
+        // Fall back to uncompressed output with the independent writes.
+        oops::Log::warning() << "WARNING: WriterPool: the HDF5 library cannot write "
+                             << "compressed variables in parallel, the output will not be "
+                             << "compressed" << std::endl;
+        compression_level_ = 0;
+    }
+    collective_write_ = is_parallel_io_ &&
+        ((compression_level_ > 0) || params_.value().collectiveWrite.value());
+
+    // When writing a single file in parallel, each pool rank writes the block of locations
+    // starting at its nlocs_start_. Record the greatest common divisor of these starting
+    // points so that the chunk lengths can be chosen to divide all of them.
+    if (is_parallel_io_) {
+        std::vector<std::size_t> nlocsStarts(size_pool_);
+        comm_pool_->allGather(nlocs_start_, nlocsStarts.begin(), nlocsStarts.end());
+        for (std::size_t start : nlocsStarts) {
+            std::size_t a = chunk_alignment_;
+            while (start != 0) {
+                const std::size_t r = a % start;
+                a = start;
+                start = r;
             }
-            // start is the rank that goes into the pool, and the remaining sequence
-            // of count-1 numbers starting with start+1 are the non pool ranks that
-            // are associated with the pool rank (start).
-            std::vector<int> rankGroup(count - 1);
-            std::iota(rankGroup.begin(), rankGroup.end(), start + 1);
-            rankGrouping.insert(std::make_pair(start, rankGroup));
-            start += count;
+            chunk_alignment_ = a;
         }
     }
 }
 
 //--------------------------------------------------------------------------------------
-void WriterPool::assignRanksToIoPool(const std::size_t nlocs,
-                                     const IoPoolGroupMap & rankGrouping) {
-    constexpr int mpiTagBase = 10000;
-
-    // Collect the nlocs from all of the other ranks.
-    std::vector<std::size_t> allNlocs(size_all_);
-    comm_all_.allGather(nlocs, allNlocs.begin(), allNlocs.end());
-
-    if (rank_all_ == 0) {
-        // Follow the grouping that is contained in the rankGrouping structure to create
-        // the assignments for the MPI send/recv transfers. The rankAssignments structure
-        // contains the mapping that is required to effect the proper MPI send/recv
-        // transfers. A pool rank will receive from one or more non pool ranks and the
-        // non pool ranks will send to one pool rank. The outer vector of rankAssignments
-        // is indexed by the all_comm_ rank number, and the inner vector contains the list
-        // of ranks the outer index rank interacts with for data transfers. Once constructed,
-        // each inner vector of rankAssignments is sent to the associated rank in the
-        // comm_all_ group.
-        std::vector<std::vector<std::pair<int, int>>> rankAssignments(size_all_);
-        std::vector<int> rankAssignSizes(size_all_, 0);
-        for (auto & rankGroup : rankGrouping) {
-            // rankGroup is a std::pair<int, std::vector<int>>
-            // The first element is the pool rank, and the second element is
-            // the list of associated non pool ranks.
-            std::vector<std::pair<int, int>> rankGroupPairs(rankGroup.second.size());
-            std::size_t i = 0;
-            for (auto & nonPoolRank : rankGroup.second) {
-                rankGroupPairs[i] = std::make_pair(nonPoolRank, allNlocs[nonPoolRank]);
-                std::vector<std::pair<int, int>> associatedPoolRank;
-                associatedPoolRank.push_back(
-                    std::make_pair(rankGroup.first, allNlocs[nonPoolRank]));
-                rankAssignments[nonPoolRank] = associatedPoolRank;
-                rankAssignSizes[nonPoolRank] = 1;
-                i += 1;
-            }
-            rankAssignments[rankGroup.first] = rankGroupPairs;
-            rankAssignSizes[rankGroup.first] = rankGroupPairs.size();
-        }
-
-        // Send the rank assignments to the other ranks. Use scatter to spread the
-        // sizes (number of ranks) in each rank's assignment. Then use send/receive
-        // to transfer each ranks assignment.
-        int myRankAssignSize;
-        comm_all_.scatter(rankAssignSizes, myRankAssignSize, 0);
-
-        // Copy my assignment directory. Use MPI send/recv for all other ranks.
-        rank_assignment_ = rankAssignments[0];
-        for (std::size_t i = 1; i < rankAssignments.size(); ++i) {
-            if (rankAssignSizes[i] > 0) {
-                comm_all_.send(rankAssignments[i].data(), rankAssignSizes[i], i, mpiTagBase + i);
+Dimensions_t WriterPool::locationChunkSize(const std::size_t elementBytes) const {
+    std::size_t chunkBytes = defaultChunkBytes;
+    if (params_.value().chunkSize.value() != boost::none) {
+        chunkBytes = *params_.value().chunkSize.value();
+    }
+    const std::size_t numLocs = is_parallel_io_ ? global_nlocs_ : total_nlocs_;
+    std::size_t maxLocs = chunkBytes / std::max(elementBytes, std::size_t(1));
+    maxLocs = std::max(std::min(maxLocs, numLocs), std::size_t(1));
+
+    // Look for the largest divisor of the alignment that fits in a chunk. Chunks much
+    // smaller than the target compress poorly, so if the only such divisors are small,
+    // accept chunks that straddle the pool ranks' blocks.
+    if (chunk_alignment_ > 0) {
+        constexpr std::size_t maxTries = 100000;
+        const std::size_t minLocs = std::max(maxLocs / 4, std::size_t(1));
+        const std::size_t firstDivisor = (chunk_alignment_ + maxLocs - 1) / maxLocs;
+        const std::size_t lastDivisor =
+            std::min(chunk_alignment_ / minLocs, firstDivisor + maxTries);
+        for (std::size_t k = firstDivisor; k <= lastDivisor; ++k) {
+            if (chunk_alignment_ % k == 0) {
+                return chunk_alignment_ / k;
             }
         }
-    } else {
-        // Receive the rank assignments from rank 0. First use scatter to receive the
-        // sizes (number of ranks) in this rank's assignment.
-        int myRankAssignSize;
-        std::vector<int> dummyVector(size_all_);
-        comm_all_.scatter(dummyVector, myRankAssignSize, 0);
-
-        rank_assignment_.resize(myRankAssignSize);
-        if (myRankAssignSize > 0) {
-            comm_all_.receive(rank_assignment_.data(), myRankAssignSize, 0, mpiTagBase + rank_all_);
-        }
     }
+    return maxLocs;
 }
 
 //--------------------------------------------------------------------------------------
@@ -151,11 +104,15 @@ WriterPool::WriterPool(const oops::Parameter<IoPoolParameters> & ioPoolParams,
                    <Engines::WriterParametersBase, Engines::WriterFactory> & writerParams,
                const eckit::mpi::Comm & commAll, const eckit::mpi::Comm & commTime,
                const util::DateTime & winStart, const util::DateTime & winEnd,
-               const std::vector<bool> & patchObsVec)
+               const std::size_t nlocs,
+               const std::vector<std::pair<std::size_t, std::size_t>> & patchObsRuns)
                    : IoPoolBase(ioPoolParams, commAll, commTime, winStart, winEnd),
-                     writer_params_(writerParams), patch_obs_vec_(patchObsVec) {
-    nlocs_ = patchObsVec.size();
-    patch_nlocs_ = std::count(patchObsVec.begin(), patchObsVec.end(), true);
+                     writer_params_(writerParams), patch_obs_runs_(patchObsRuns) {
+    nlocs_ = nlocs;
+    patch_nlocs_ = 0;
+    for (const auto & run : patchObsRuns) {
+        patch_nlocs_ += run.second;
+    }
     // For now, the target pool size is simply the minumum of the specified (or default) max
     // pool size and the size of the comm_all_ communicator group.
     setTargetPoolSize();
@@ -206,6 +163,9 @@ WriterPool::WriterPool(const oops::Parameter<IoPoolParameters> & ioPoolParams,
         create_multiple_files_ = false;
     }
 
+    // Set the compression and collective write settings for the Location variables.
+    setCompressionInfo();
+
     // Create an object of the writer pre-/post-processor here so that it can be
     // accessed throught the lifetime of the io pool object. The lifetime of the
     // writer engine is only during the save function. The writer pre-/post-processor
@@ -254,12 +214,7 @@ void WriterPool::finalize() {
 
     // At this point there are two split communicator groups: one for the io pool and the
     // other for the processes not included in the io pool.
-    if (eckit::mpi::hasComm(poolCommName)) {
-        eckit::mpi::deleteComm(poolCommName);
-    }
-    if (eckit::mpi::hasComm(nonPoolCommName)) {
-        eckit::mpi::deleteComm(nonPoolCommName);
-    }
+    deleteIoPool();
     oops::Log::trace() << "WriterPool::finalize, end" << std::endl;
 }
 
@@ -9,6 +9,7 @@
 
 #include "ioda/Io/WriterUtils.h"
 
+#include <algorithm>
 #include <functional>
 #include <numeric>
 #include <unordered_set>
@@ -18,6 +19,7 @@
 #include "ioda/Copying.h"
 #include "ioda/Exception.h"
 #include "ioda/Group.h"
+#include "ioda/Io/ReaderUtils.h"
 #include "ioda/Io/WriterPool.h"
 #include "ioda/Misc/DimensionScales.h"
 #include "ioda/Types/Type.h"
@@ -123,21 +125,46 @@ template <typename VarType>
 void selectPatchValues(const WriterPool & ioPool, const Variable & srcVar,
                        const Dimensions_t & dimFactor, std::vector<VarType> & varData) {
     // Read all the values from the source variable
-    std::vector<VarType> totalVarData;
-    srcVar.read<VarType>(totalVarData);
-
-    // Use this rank's patchObsVec to select the patch ("owned") values only. patchObsVec
-    // hold boolean values, and the patch locations are where the entries are set to "true".
-    varData.clear();
-    varData.reserve(ioPool.patch_nlocs() * dimFactor);
-    auto patchObsVec = ioPool.patchObsVec();
-    for (std::size_t i = 0; i < patchObsVec.size(); ++i) {
-        if (patchObsVec[i]) {
-            std::size_t indx = i * dimFactor;
-            for (std::size_t j = 0; j < dimFactor; ++j) {
-                varData.push_back(totalVarData[indx + j]);
-            }
+    srcVar.read<VarType>(varData);
+
+    // If all locations are patch locations there is nothing to select.
+    if (ioPool.all_patch()) {
+        return;
+    }
+
+    // Use this rank's patch runs to select the patch ("owned") values only, compacting
+    // them in place. Each run is a block of consecutive locations, so it moves as a whole,
+    // and a run never moves to a later position than it started at.
+    std::size_t dest = 0;
+    for (const auto & run : ioPool.patchObsRuns()) {
+        const std::size_t start = run.first * dimFactor;
+        const std::size_t count = run.second * dimFactor;
+        if (start != dest) {
+            std::move(varData.begin() + start, varData.begin() + start + count,
+                      varData.begin() + dest);
+        }
+        dest += count;
+    }
+    varData.resize(dest);
+}
+
+template <typename VarType>
+void writeLocationVarData(const WriterPool & ioPool, const std::string & varName,
+                          const std::vector<VarType> & varData, Group & dest,
+                          const bool isParallelIo) {
+    Variable destVar = dest.vars.open(varName);
+    if (isParallelIo) {
+        Selection memSelect = createBlockSelection(destVar.getDimensions().dimsCur,
+                              0, ioPool.total_nlocs(), false);
+        Selection fileSelect = createBlockSelection(destVar.getDimensions().dimsCur,
+                               ioPool.nlocs_start(), ioPool.total_nlocs(), true);
+        if (ioPool.collective_write()) {
+            destVar.collectiveWrite<VarType>(varData, memSelect, fileSelect);
+        } else {
+            destVar.parallelWrite<VarType>(varData, memSelect, fileSelect);
         }
+    } else {
+        destVar.write<VarType>(varData);
     }
 }
 
@@ -165,16 +192,7 @@ void transferVarDataMPI(const WriterPool & ioPool, const Variable & srcVar,
                 varData.data() + varStarts[i], varCounts[i], fromRank, tag);
         }
         ioPool.comm_all().waitAll(recvRequests);
-        Variable destVar = dest.vars.open(varName);
-        if (isParallelIo) {
-            Selection memSelect = createBlockSelection(destVar.getDimensions().dimsCur,
-                                  0, ioPool.total_nlocs(), false);
-            Selection fileSelect = createBlockSelection(destVar.getDimensions().dimsCur,
-                                   ioPool.nlocs_start(), ioPool.total_nlocs(), true);
-            destVar.parallelWrite<VarType>(varData, memSelect, fileSelect);
-        } else {
-            destVar.write<VarType>(varData);
-        }
+        writeLocationVarData<VarType>(ioPool, varName, varData, dest, isParallelIo);
     } else {
         // Non io pool ranks. These ranks will always read their data from src, and send it as
         // is to their assigned io pool rank.
@@ -190,6 +208,11 @@ void transferVarDataMPI(const WriterPool & ioPool, const Variable & srcVar,
 }
 
 // template specialization for std::string
+//
+// Strings are transferred as a vector of lengths followed by a single character buffer
+// holding the concatenated strings (see packStrings in ReaderUtils). This avoids padding
+// every string out to the maximum length and lets all of the transfers for a variable
+// be posted at once with non-blocking requests.
 template <>
 void transferVarDataMPI<std::string>(const WriterPool & ioPool, const Variable & srcVar,
                         const std::string & varName, const int varNumber,
@@ -197,68 +220,237 @@ void transferVarDataMPI<std::string>(const WriterPool & ioPool, const Variable &
                         const std::vector<std::size_t> & varCounts,
                         const Dimensions_t & dimFactor, Group & dest,
                         const bool isParallelIo, const std::size_t strLen) {
-    int maxStringLength = strLen + 1;
-
     std::vector<std::string> varData;
     selectPatchValues<std::string>(ioPool, srcVar, dimFactor, varData);
+    const std::size_t numAssignments = ioPool.rank_assignment().size();
     if (ioPool.rank_pool() >= 0) {
         // Resize varData according to total nlocs.
         Dimensions_t numElements = ioPool.total_nlocs() * dimFactor;
         varData.resize(numElements);
 
-        // Walk through the rank assignments and issue receive commands.
-        for (std::size_t i = 0; i < ioPool.rank_assignment().size(); ++i) {
+        // Walk through the rank assignments and issue receive commands for the string
+        // lengths. The lengths and characters for a given rank use the same tag, and since
+        // MPI does not allow messages with matching source and tag to overtake each other
+        // the lengths always arrive first.
+        std::vector<std::vector<int>> strLengths(numAssignments);
+        std::vector<eckit::mpi::Request> recvRequests(numAssignments);
+        for (std::size_t i = 0; i < numAssignments; ++i) {
             int fromRank = ioPool.rank_assignment()[i].first;
             int tag = mpiTagBase + (varNumber * varNumTagFactor) + fromRank;
-            std::vector<char> strBuffer(varCounts[i] * maxStringLength, '\0');
-            ioPool.comm_all().receive(strBuffer.data(), strBuffer.size(), fromRank, tag);
-            for (std::size_t j = 0; j < varCounts[i]; ++j) {
-                std::size_t offset = j * maxStringLength;
-                auto strEnd = std::find(strBuffer.begin() + offset, strBuffer.end(), '\0');
-                if (strEnd == strBuffer.end()) {
-                    throw Exception("End of string not found during MPI transfer", ioda_Here());
-                }
-                std::string str(strBuffer.begin() + offset, strEnd);
-                varData[varStarts[i] + j] = str;
-            }
+            strLengths[i].resize(varCounts[i]);
+            recvRequests[i] = ioPool.comm_all().iReceive(
+                strLengths[i].data(), varCounts[i], fromRank, tag);
         }
-        Variable destVar = dest.vars.open(varName);
-        if (isParallelIo) {
-            Selection memSelect = createBlockSelection(destVar.getDimensions().dimsCur,
-                                  0, ioPool.total_nlocs(), false);
-            Selection fileSelect = createBlockSelection(destVar.getDimensions().dimsCur,
-                                   ioPool.nlocs_start(), ioPool.total_nlocs(), true);
-            destVar.parallelWrite<std::string>(varData, memSelect, fileSelect);
-        } else {
-            destVar.write<std::string>(varData);
+        ioPool.comm_all().waitAll(recvRequests);
+
+        // Now that the lengths are known, size the character buffers and receive them.
+        std::vector<std::vector<char>> strChars(numAssignments);
+        for (std::size_t i = 0; i < numAssignments; ++i) {
+            int fromRank = ioPool.rank_assignment()[i].first;
+            int tag = mpiTagBase + (varNumber * varNumTagFactor) + fromRank;
+            strChars[i].resize(std::accumulate(strLengths[i].begin(), strLengths[i].end(),
+                                               std::size_t(0)));
+            recvRequests[i] = ioPool.comm_all().iReceive(
+                strChars[i].data(), strChars[i].size(), fromRank, tag);
         }
+        ioPool.comm_all().waitAll(recvRequests);
+
+        std::vector<std::string> rankStrings;
+        for (std::size_t i = 0; i < numAssignments; ++i) {
+            unpackStrings(strLengths[i], strChars[i], rankStrings);
+            std::move(rankStrings.begin(), rankStrings.end(), varData.begin() + varStarts[i]);
+        }
+
+        writeLocationVarData<std::string>(ioPool, varName, varData, dest, isParallelIo);
     } else {
         // Non io pool ranks. These ranks will always read their data from src, and send it as
-        // is to their assigned io pool rank.
-        for (std::size_t i = 0; i < ioPool.rank_assignment().size(); ++i) {
+        // is to their assigned io pool rank. The packed buffers need to stay alive until
+        // the sends complete.
+        std::vector<std::vector<int>> strLengths(numAssignments);
+        std::vector<std::vector<char>> strChars(numAssignments);
+        std::vector<eckit::mpi::Request> sendRequests;
+        sendRequests.reserve(2 * numAssignments);
+        for (std::size_t i = 0; i < numAssignments; ++i) {
             int toRank = ioPool.rank_assignment()[i].first;
             int tag = mpiTagBase + (varNumber * varNumTagFactor) + ioPool.rank_all();
-            std::vector<char> strBuffer(varCounts[i] * maxStringLength, '\0');
-            for (std::size_t i = 0; i < varData.size(); ++i) {
-                for (std::size_t j = 0; j < varData[i].size(); ++j) {
-                    std::size_t bufIndx = (i * maxStringLength) + j;
-                    strBuffer[(i * maxStringLength) + j] = varData[i][j];
-                }
+            const std::vector<std::string> rankStrings(
+                varData.begin() + varStarts[i], varData.begin() + varStarts[i] + varCounts[i]);
+            packStrings(rankStrings, strLengths[i], strChars[i]);
+            sendRequests.push_back(ioPool.comm_all().iSend(
+                strLengths[i].data(), strLengths[i].size(), toRank, tag));
+            sendRequests.push_back(ioPool.comm_all().iSend(
+                strChars[i].data(), strChars[i].size(), toRank, tag));
+        }
+        ioPool.comm_all().waitAll(sendRequests);
+    }
+}
+
+// Batched transfer of the numeric variables dimensioned by Location.
+//
+// Instead of one set of messages per variable, each non io pool rank packs its patch values
+// of a batch of variables into one buffer and sends it to its io pool rank in a single
+// message. The io pool ranks post the receives for the next batch before writing the
+// variables of the current batch, so that the transfers overlap the file writes. Two
+// batches are in flight at a time, and a batch is limited to half of the batch memory
+// limit on the io pool rank receiving the most locations.
+
+struct BatchVar {
+    std::string name;
+    Variable var;
+    std::vector<std::size_t> starts;
+    std::vector<std::size_t> counts;
+    Dimensions_t dimFactor;
+    std::size_t valueBytes;
+};
+
+struct BatchRecv {
+    std::vector<std::vector<char>> buffers;
+    std::vector<eckit::mpi::Request> requests;
+};
+
+constexpr int batchTag = 15000;
+
+template <typename VarType>
+void packBatchVar(const WriterPool & ioPool, const BatchVar & batchVar,
+                  std::vector<std::vector<char>> & buffers) {
+    std::vector<VarType> varData;
+    selectPatchValues<VarType>(ioPool, batchVar.var, batchVar.dimFactor, varData);
+    for (std::size_t i = 0; i < buffers.size(); ++i) {
+        const char * first = reinterpret_cast<const char *>(varData.data() + batchVar.starts[i]);
+        buffers[i].insert(buffers[i].end(), first,
+                          first + batchVar.counts[i] * sizeof(VarType));
+    }
+}
+
+template <typename VarType>
+void unpackAndWriteBatchVar(const WriterPool & ioPool, const BatchVar & batchVar,
+                            const BatchRecv & recv, std::vector<std::size_t> & offsets,
+                            Group & dest, const bool isParallelIo) {
+    std::vector<VarType> varData;
+    selectPatchValues<VarType>(ioPool, batchVar.var, batchVar.dimFactor, varData);
+    varData.resize(ioPool.total_nlocs() * batchVar.dimFactor);
+    for (std::size_t i = 0; i < recv.buffers.size(); ++i) {
+        const std::size_t numBytes = batchVar.counts[i] * sizeof(VarType);
+        std::copy(recv.buffers[i].data() + offsets[i],
+                  recv.buffers[i].data() + offsets[i] + numBytes,
+                  reinterpret_cast<char *>(varData.data() + batchVar.starts[i]));
+        offsets[i] += numBytes;
+    }
+    writeLocationVarData<VarType>(ioPool, batchVar.name, varData, dest, isParallelIo);
+}
+
+void postBatchReceives(const WriterPool & ioPool, const std::vector<BatchVar> & batch,
+                       BatchRecv & recv) {
+    const std::size_t numAssignments = ioPool.rank_assignment().size();
+    recv.buffers.assign(numAssignments, std::vector<char>());
+    recv.requests.resize(numAssignments);
+    for (std::size_t i = 0; i < numAssignments; ++i) {
+        std::size_t numBytes = 0;
+        for (const auto & batchVar : batch) {
+            numBytes += batchVar.counts[i] * batchVar.valueBytes;
+        }
+        recv.buffers[i].resize(numBytes);
+        recv.requests[i] = ioPool.comm_all().iReceive(recv.buffers[i].data(), numBytes,
+                               ioPool.rank_assignment()[i].first, batchTag);
+    }
+}
+
+void transferBatchedVarData(const WriterPool & ioPool, const std::vector<BatchVar> & batchVars,
+                            Group & dest, const bool isParallelIo) {
+    // Split the variables into batches. The batches need to be the same on all ranks, so
+    // base them on the largest number of locations received by any io pool rank.
+    std::size_t maxTotalNlocs = (ioPool.rank_pool() >= 0) ? ioPool.total_nlocs() : 0;
+    ioPool.comm_all().allReduceInPlace(maxTotalNlocs, eckit::mpi::max());
+    const std::size_t maxBatchBytes = std::max(ioPool.batch_memory_limit() / 2, std::size_t(1));
+    std::vector<std::vector<BatchVar>> batches;
+    std::size_t batchBytes = 0;
+    for (const auto & batchVar : batchVars) {
+        const std::size_t varBytes = maxTotalNlocs * batchVar.dimFactor * batchVar.valueBytes;
+        if (batches.empty() || (batchBytes > 0 && batchBytes + varBytes > maxBatchBytes)) {
+            batches.emplace_back();
+            batchBytes = 0;
+        }
+        batches.back().push_back(batchVar);
+        batchBytes += varBytes;
+    }
+
+    const std::size_t numAssignments = ioPool.rank_assignment().size();
+    if (ioPool.rank_pool() >= 0) {
+        // Receive batch b + 1 while writing the variables of batch b.
+        std::vector<BatchRecv> recvs(batches.size());
+        if (!batches.empty()) postBatchReceives(ioPool, batches[0], recvs[0]);
+        for (std::size_t b = 0; b < batches.size(); ++b) {
+            if (b + 1 < batches.size()) postBatchReceives(ioPool, batches[b + 1], recvs[b + 1]);
+            ioPool.comm_all().waitAll(recvs[b].requests);
+            std::vector<std::size_t> offsets(numAssignments, 0);
+            for (const auto & batchVar : batches[b]) {
+                VarUtils::forAnySupportedVariableType(
+                    batchVar.var,
+                    [&](auto typeDiscriminator) {
+                        typedef decltype(typeDiscriminator) T;
+                        unpackAndWriteBatchVar<T>(ioPool, batchVar, recvs[b], offsets, dest,
+                                                  isParallelIo);
+                    },
+                    VarUtils::ThrowIfVariableIsOfUnsupportedType(batchVar.name));
             }
-            ioPool.comm_all().send(strBuffer.data(), strBuffer.size(), toRank, tag);
+            recvs[b] = BatchRecv();
         }
+    } else {
+        // Keep the buffers of the previous batch alive until its sends complete.
+        std::vector<std::vector<char>> prevBuffers;
+        std::vector<eckit::mpi::Request> prevRequests;
+        for (const auto & batch : batches) {
+            std::vector<std::vector<char>> buffers(numAssignments);
+            for (const auto & batchVar : batch) {
+                VarUtils::forAnySupportedVariableType(
+                    batchVar.var,
+                    [&](auto typeDiscriminator) {
+                        typedef decltype(typeDiscriminator) T;
+                        packBatchVar<T>(ioPool, batchVar, buffers);
+                    },
+                    VarUtils::ThrowIfVariableIsOfUnsupportedType(batchVar.name));
+            }
+            std::vector<eckit::mpi::Request> requests(numAssignments);
+            for (std::size_t i = 0; i < numAssignments; ++i) {
+                requests[i] = ioPool.comm_all().iSend(buffers[i].data(), buffers[i].size(),
+                                  ioPool.rank_assignment()[i].first, batchTag);
+            }
+            ioPool.comm_all().waitAll(prevRequests);
+            prevBuffers = std::move(buffers);
+            prevRequests = std::move(requests);
+        }
+        ioPool.comm_all().waitAll(prevRequests);
+    }
+}
+
+void setCompression(const WriterPool & ioPool, const Dimensions & varDims,
+                    const std::size_t valueBytes, VariableCreationParameters & params) {
+    // Only the numeric variables dimensioned by Location are compressed. These are the large ones,
+    // and when writing in parallel they are written with collective MPI-IO which HDF5
+    // requires for filtered variables. The remaining variables are written with the
+    // independent style which doesn't support compression.
+    params.noCompress();
+    if (ioPool.compression_level() > 0) {
+        Dimensions_t elementBytes = valueBytes;
+        for (std::size_t i = 1; i < varDims.dimsCur.size(); ++i) {
+            elementBytes *= std::max(varDims.dimsCur[i], Dimensions_t(1));
+        }
+        params.chunk = true;
+        params.chunks = varDims.dimsCur;
+        params.chunks[0] = ioPool.locationChunkSize(elementBytes);
+        for (std::size_t i = 1; i < params.chunks.size(); ++i) {
+            params.chunks[i] = std::max(params.chunks[i], Dimensions_t(1));
+        }
+        params.compressWithGZIP(ioPool.compression_level());
+        params.setShuffle(ioPool.shuffle());
     }
 }
 
 template <typename VarType>
-void createVariable(const std::string & varName, const Variable & srcVar,
-                    const int adjustNlocs, Has_Variables & destVars,
+void createVariable(const WriterPool & ioPool, const std::string & varName,
+                    const Variable & srcVar, const int adjustNlocs, Has_Variables & destVars,
                     const std::size_t strLen) {
     VariableCreationParameters params = srcVar.getCreationParameters(false, false);
-    // For now we want to use mpio independent writing style which doesn't support
-    // compression. This is currently being mitigated since we have to run a 
-    // workaround to convert fixed length strings to variable length strings for
-    // netcdf compatibility. And in this workaround, we can turn on compression.
     params.noCompress();
     Dimensions varDims = srcVar.getDimensions();
     // If adjust Nlocs is >= 0, this means that this is a variable that needs
@@ -268,6 +460,7 @@ void createVariable(const std::string & varName, const Variable & srcVar,
         if (varDims.dimsMax[0] != ioda::Unlimited) {
             varDims.dimsMax[0] = adjustNlocs;
         }
+        setCompression(ioPool, varDims, sizeof(VarType), params);
     }
     Variable destVar = destVars.create<VarType>(varName, varDims, params);
     copyAttributes(srcVar.atts, destVar.atts);
@@ -275,9 +468,9 @@ void createVariable(const std::string & varName, const Variable & srcVar,
 
 // createVariable specialization for string
 template <>
-void createVariable<std::string>(const std::string & varName, const Variable & srcVar,
-                                 const int adjustNlocs, Has_Variables & destVars,
-                                 const std::size_t strLen) {
+void createVariable<std::string>(const WriterPool & ioPool, const std::string & varName,
+                                 const Variable & srcVar, const int adjustNlocs,
+                                 Has_Variables & destVars, const std::size_t strLen) {
     // Since the fill value is coming from a variable length string, and we are
     // writing out a fixed length string, the fill value might be a longer length
     // than the string length. For now, record the fill value in an attribute
@@ -285,10 +478,6 @@ void createVariable<std::string>(const std::string & varName, const Variable & s
     // The origFillValue attribute can be used by the "convert back to variable length
     // string" application to restore the fill value.
     VariableCreationParameters params = srcVar.getCreationParameters(false, false);
-    // For now we want to use mpio independent writing style which doesn't support
-    // compression. This is currently being mitigated since we have to run a 
-    // workaround to convert fixed length strings to variable length strings for
-    // netcdf compatibility. And in this workaround, we can turn on compression.
     params.noCompress();
     auto fv = srcVar.getFillValue();
     std::string origFillValue = detail::getFillValue<std::string>(fv);
@@ -301,6 +490,9 @@ void createVariable<std::string>(const std::string & varName, const Variable & s
         if (varDims.dimsMax[0] != ioda::Unlimited) {
             varDims.dimsMax[0] = adjustNlocs;
         }
+        // Fixed length string variables are not compressed: the upgrader rewrites them
+        // as variable length strings, which HDF5 cannot compress, so the work would be
+        // thrown away.
     }
     // Set the string length in a specialized type.
     Type fixedStrType =
@@ -330,11 +522,43 @@ void copyVarData(const ioda::WriterPool & ioPool, const ioda::Group & src, ioda:
                  const std::map<std::string, std::size_t> & maxStringLengths){
   // For ranks in the io pool, collect the variable data and write out to the file. The
   // ranks not in the io pool will participate only in the MPI send/recv calls.
+  //
+  // In batched mode, the numeric variables using the Location dimension are transferred
+  // first, in batches. The remaining variables are transferred one at a time below.
+  std::unordered_set<std::string> batchedVarNames;
+  if (ioPool.batch_transfers()) {
+    std::vector<BatchVar> batchVars;
+    for (auto & srcNamedVar : srcNamedVars) {
+      if ((varsUsingLocation.count(srcNamedVar.name) == 0) ||
+          srcNamedVar.var.isA<std::string>()) {
+        continue;
+      }
+      BatchVar batchVar;
+      batchVar.name = srcNamedVar.name;
+      batchVar.var = srcNamedVar.var;
+      calcVarStartsCounts(ioPool, batchVar.var, batchVar.starts, batchVar.counts,
+                          batchVar.dimFactor);
+      VarUtils::forAnySupportedVariableType(
+          batchVar.var,
+          [&](auto typeDiscriminator) {
+              batchVar.valueBytes = sizeof(decltype(typeDiscriminator));
+          },
+          VarUtils::ThrowIfVariableIsOfUnsupportedType(batchVar.name));
+      batchedVarNames.insert(batchVar.name);
+      batchVars.push_back(std::move(batchVar));
+    }
+    transferBatchedVarData(ioPool, batchVars, dest, isParallelIo);
+  }
+
   int varNumber = 1;
   for (auto & srcNamedVar : srcNamedVars) {
     std::string varName = srcNamedVar.name;
     Variable srcVar = srcNamedVar.var;
     bool varTypeSupported = true;
+    if (batchedVarNames.count(varName) > 0) {
+        varNumber += 1;
+        continue;
+    }
     // Only the variable using the Location dimension will need to use MPI send/recv.
     // If the variable is not using Location, then simply transfer data from src to dest.
     if(varsUsingLocation.count(varName) > 0) {
@@ -386,13 +610,13 @@ void calcMaxStringLengths(const ioda::WriterPool & ioPool,
     // Walk through all variables and figure out the max string length which must
     // be done over the entire set of obs spaces.
     maxStringLengths.clear();
+    std::vector<std::string> stringVarNames;
+    std::vector<std::size_t> stringVarMaxLens;
     for (auto & namedVar : allVarsList) {
-        std::string varName = namedVar.name;
         Variable var = namedVar.var;
         if (var.isA<std::string>()) {
             // Variable is a string type. Read in the values and find the maximum
-            // string length. Then do an allReduce to send the maximum of all ranks
-            // to every rank.
+            // string length on this rank.
             std::vector<std::string> varData;
             var.read(varData);
             std::size_t maxStringLen = 0;
@@ -401,19 +625,24 @@ void calcMaxStringLengths(const ioda::WriterPool & ioPool,
                     maxStringLen = varData[i].size();
                 }
             }
-            std::size_t globalMaxStringLen;
-            ioPool.comm_all()
-                .allReduce(maxStringLen, globalMaxStringLen, eckit::mpi::max());
-            // If all of the strings are empty, then globalMaxStringLen is set to
-            // zero which causes problems with the fixed length string type. In this
-            // case, set the globalMaxStringLen to 1.
-            if (globalMaxStringLen == 0) {
-                globalMaxStringLen = 1;
-            }
-            maxStringLengths
-                .insert(std::pair<std::string, std::size_t>(varName, globalMaxStringLen));
+            stringVarNames.push_back(namedVar.name);
+            stringVarMaxLens.push_back(maxStringLen);
         }
     }
+
+    // Reduce the maximum lengths of all the string variables in one collective. Every
+    // rank holds the same variable list so the entries line up across the ranks.
+    if (!stringVarMaxLens.empty()) {
+        ioPool.comm_all().allReduceInPlace(stringVarMaxLens.begin(), stringVarMaxLens.end(),
+                                           eckit::mpi::max());
+    }
+    for (std::size_t i = 0; i < stringVarNames.size(); ++i) {
+        // If all of the strings are empty, then the maximum length is zero which causes
+        // problems with the fixed length string type. In this case, set it to 1.
+        std::size_t globalMaxStringLen = std::max(stringVarMaxLens[i], std::size_t(1));
+        maxStringLengths
+            .insert(std::pair<std::string, std::size_t>(stringVarNames[i], globalMaxStringLen));
+    }
 }
 
 void ioWriteGroup(const ioda::WriterPool & ioPool, const ioda::Group& memGroup,
@@ -496,7 +725,8 @@ void ioWriteGroup(const ioda::WriterPool & ioPool, const ioda::Group& memGroup,
           old_var,
           [&](auto typeDiscriminator) {
               typedef decltype(typeDiscriminator) T;
-              createVariable<T>(var_name, old_var, adjustNlocs, fileGroup.vars, strLen);
+              createVariable<T>(ioPool, var_name, old_var, adjustNlocs, fileGroup.vars,
+                                strLen);
           },
           VarUtils::ThrowIfVariableIsOfUnsupportedType(var_name));
     }
@@ -0,0 +1,127 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+/// This program times ObsStore Variable reads and writes for the selection styles
+/// that the ObsSpace uses: the whole variable, a hyperslab along the Location
+/// dimension, and a subset of channels.
+///
+/// Usage: ioda-engines_bench-obsstore-selections [num_floats ...]
+/// By default, variables holding 1M, 10M and 100M floats are timed.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "ioda/Engines/ObsStore.h"
+#include "ioda/Exception.h"
+#include "ioda/Group.h"
+
+namespace {
+
+const ioda::Dimensions_t numChans = 20;
+
+template <typename Func>
+double timeIt(Func func, int numReps = 3) {
+  double best = -1.0;
+  for (int i = 0; i < numReps; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if ((best < 0.0) || (elapsed.count() < best)) best = elapsed.count();
+  }
+  return best;
+}
+
+void report(const std::string& name, std::size_t numFloats, std::size_t numSelected,
+            double readTime, double writeTime) {
+  const double mbytes = static_cast<double>(numSelected * sizeof(float)) / (1024.0 * 1024.0);
+  std::cout << std::setw(12) << numFloats << std::setw(12) << name << std::setw(14) << numSelected
+            << std::fixed << std::setprecision(4) << std::setw(12) << readTime << std::setw(12)
+            << writeTime << std::setprecision(1) << std::setw(12) << mbytes / readTime
+            << std::setw(12) << mbytes / writeTime << std::endl;
+}
+
+void benchSize(std::size_t numFloats) {
+  ioda::Group g = ioda::Engines::ObsStore::createRootGroup();
+  const ioda::Dimensions_t numLocs = gsl::narrow<ioda::Dimensions_t>(numFloats) / numChans;
+  const std::size_t totalFloats    = gsl::narrow<std::size_t>(numLocs * numChans);
+
+  ioda::Variable var = g.vars.create<float>("ObsValue/brightnessTemperature",
+                                            {numLocs, numChans});
+  std::vector<float> values(totalFloats);
+  std::iota(values.begin(), values.end(), 0.0f);
+  var.write<float>(values);
+
+  // Whole variable
+  {
+    std::vector<float> out;
+    double readTime  = timeIt([&]() { var.read<float>(out); });
+    double writeTime = timeIt([&]() { var.write<float>(values); });
+    report("whole", totalFloats, totalFloats, readTime, writeTime);
+  }
+
+  // Hyperslab covering the middle half of the Location dimension
+  {
+    const ioda::Dimensions_t start = numLocs / 4;
+    const ioda::Dimensions_t count = numLocs / 2;
+    const std::size_t numSelected  = gsl::narrow<std::size_t>(count * numChans);
+    ioda::Selection memSelect;
+    memSelect.extent({count, numChans}).select({ioda::SelectionOperator::SET, {0, 0},
+                                                {count, numChans}});
+    ioda::Selection fileSelect;
+    fileSelect.select({ioda::SelectionOperator::SET, {start, 0}, {count, numChans}});
+    std::vector<float> out(numSelected);
+    double readTime  = timeIt([&]() { var.read<float>(gsl::make_span(out), memSelect,
+                                                      fileSelect); });
+    double writeTime = timeIt([&]() { var.write<float>(gsl::make_span(out), memSelect,
+                                                       fileSelect); });
+    report("locations", totalFloats, numSelected, readTime, writeTime);
+  }
+
+  // Subset of channels, selected the same way as ObsSpace::createChannelSelections
+  {
+    const std::vector<ioda::Dimensions_t> chanIndices{2, 3, 4, 5, 11, 17};
+    std::vector<ioda::Dimensions_t> locIndices(numLocs);
+    std::iota(locIndices.begin(), locIndices.end(), 0);
+    const ioda::Dimensions_t numSelected
+      = numLocs * gsl::narrow<ioda::Dimensions_t>(chanIndices.size());
+    ioda::Selection memSelect;
+    memSelect.extent({numSelected}).select({ioda::SelectionOperator::SET, {0}, {numSelected}});
+    ioda::Selection fileSelect;
+    fileSelect.extent({numLocs, numChans})
+      .select({ioda::SelectionOperator::SET, 0, locIndices})
+      .select({ioda::SelectionOperator::AND, 1, chanIndices});
+    std::vector<float> out(gsl::narrow<std::size_t>(numSelected));
+    double readTime  = timeIt([&]() { var.read<float>(gsl::make_span(out), memSelect,
+                                                      fileSelect); });
+    double writeTime = timeIt([&]() { var.write<float>(gsl::make_span(out), memSelect,
+                                                       fileSelect); });
+    report("channels", totalFloats, gsl::narrow<std::size_t>(numSelected), readTime, writeTime);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  try {
+    std::vector<std::size_t> sizes;
+    for (int i = 1; i < argc; ++i) sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+    if (sizes.empty()) sizes = {1000000, 10000000, 100000000};
+
+    std::cout << std::setw(12) << "floats" << std::setw(12) << "selection" << std::setw(14)
+              << "selected" << std::setw(12) << "read (s)" << std::setw(12) << "write (s)"
+              << std::setw(12) << "read MB/s" << std::setw(12) << "write MB/s" << std::endl;
+    for (const auto numFloats : sizes) benchSize(numFloats);
+  } catch (const std::exception& e) {
+    ioda::unwind_exception_stack(e);
+    return 1;
+  }
+  return 0;
+}
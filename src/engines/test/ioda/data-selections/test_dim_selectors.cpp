@@ -85,6 +85,25 @@ void test_group_backend_engine(ioda::Group g) {
   bool r2 = check2.isApprox(reference2);
   if (!r2)
     throw;  // jedi_throw.add("Reason", "Test 2 result for file_test_data1 do not match expected results");
+
+  // Read the same column subset from two variables with the same shape, using fresh
+  // Selection objects each time. Backends may reuse the selection between the reads.
+  Eigen::ArrayXXi test_data2 = test_data1 + 100;
+  ioda::Variable file_test_data2 = g.vars.create<int>("test_data2", {4, 4}).writeWithEigenRegular(test_data2);
+  auto columnSubset = []() {
+    return ioda::Selection().select({ioda::SelectionOperator::SET, 1, {1, 3}});
+  };
+  const std::vector<int> reference3{18, 23, 6, 24, 21, 25, 14, 26};
+  const std::vector<int> reference4{102, 104, 106, 108, 110, 112, 114, 116};
+  for (int i = 0; i < 2; ++i) {
+    std::vector<int> check3(8), check4(8);
+    file_test_data1.read<int>(gsl::make_span(check3), ioda::Selection().extent({8}),
+                              columnSubset());
+    file_test_data2.read<int>(gsl::make_span(check4), ioda::Selection().extent({8}),
+                              columnSubset());
+    if (check3 != reference3 || check4 != reference4)
+      throw;  // jedi_throw.add("Reason", "Test 3 results do not match expected results");
+  }
 }
 
 int main(int argc, char** argv) {
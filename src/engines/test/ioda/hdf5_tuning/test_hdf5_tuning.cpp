@@ -0,0 +1,255 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <hdf5.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+#include "ioda/Engines/EngineUtils.h"
+#include "ioda/Engines/HH.h"
+#include "ioda/Group.h"
+
+using namespace eckit::testing;
+
+namespace ioda {
+namespace test {
+
+const char fileName[] = "test-hdf5-tuning.hdf5";
+const char pagedFileName[] = "test-hdf5-tuning-paged.hdf5";
+const std::size_t MiB = 1024 * 1024;
+
+/// Chunk cache settings read back from HDF5.
+struct ChunkCache {
+  std::size_t nslots;
+  std::size_t nbytes;
+};
+
+/// Write a file holding datasets with different chunk layouts. No data are written, so
+/// no chunks are allocated.
+void writeTestFile() {
+  Group f = Engines::HH::createFile(fileName, Engines::BackendCreateModes::Truncate_If_Exists);
+
+  // One range of 1000 locations spans 20 chunks of 80000 bytes: 1.6 MB
+  VariableCreationParameters medium;
+  medium.chunk = true;
+  medium.chunks = {200, 100};
+  f.vars.create<float>("medium", {1000, 2000}, {1000, 2000}, medium);
+
+  // One range of 1000 locations spans 100 chunks of 4 MB: 400 MB
+  VariableCreationParameters big;
+  big.chunk = true;
+  big.chunks = {1000, 1000};
+  for (int i = 1; i <= 6; ++i) {
+    f.vars.create<float>("Group/big" + std::to_string(i), {1000, 100000}, {1000, 100000}, big);
+  }
+
+  f.vars.create<int>("small", {1000});
+}
+
+/// Open the test file through the backend factory.
+Group openTestFile(const Engines::BackendOpenModes mode, const std::size_t chunkCacheBytes) {
+  Engines::BackendCreationParameters params;
+  params.fileName = fileName;
+  params.action = Engines::BackendFileActions::Open;
+  params.openMode = mode;
+  params.hdf5Tuning.chunkCacheBytes = chunkCacheBytes;
+  return Engines::constructBackend(Engines::BackendNames::Hdf5File, params);
+}
+
+/// Open or create \p name through the backend factory with the settings in \p tuning.
+Group constructTestFile(const std::string & name, const Engines::BackendFileActions action,
+                        const Engines::Hdf5FileTuning & tuning) {
+  Engines::BackendCreationParameters params;
+  params.fileName = name;
+  params.action = action;
+  params.openMode = Engines::BackendOpenModes::Read_Only;
+  params.createMode = Engines::BackendCreateModes::Truncate_If_Exists;
+  params.hdf5Tuning = tuning;
+  return Engines::constructBackend(Engines::BackendNames::Hdf5File, params);
+}
+
+/// File access property list of the open file \p name. The caller closes it.
+hid_t fileAccessPlist(const std::string & name) {
+  std::vector<hid_t> ids(H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_FILE));
+  H5Fget_obj_ids(H5F_OBJ_ALL, H5F_OBJ_FILE, ids.size(), ids.data());
+  for (const hid_t id : ids) {
+    std::vector<char> fname(H5Fget_name(id, nullptr, 0) + 1);
+    H5Fget_name(id, fname.data(), fname.size());
+    if (std::string(fname.data()).find(name) == std::string::npos) continue;
+    return H5Fget_access_plist(id);
+  }
+  throw eckit::testing::TestException("File " + name + " is not open", Here());
+}
+
+/// Chunk cache of the open test file.
+ChunkCache fileChunkCache() {
+  hid_t fapl = fileAccessPlist(fileName);
+  int mdcNelmts;
+  ChunkCache cache;
+  double w0;
+  H5Pget_cache(fapl, &mdcNelmts, &cache.nslots, &cache.nbytes, &w0);
+  H5Pclose(fapl);
+  return cache;
+}
+
+#if H5_VERSION_GE(1, 10, 1)
+/// Page buffer size of the open file \p name.
+std::size_t filePageBufferSize(const std::string & name) {
+  hid_t fapl = fileAccessPlist(name);
+  std::size_t bufSize;
+  unsigned minMetaPerc;
+  unsigned minRawPerc;
+  H5Pget_page_buffer_size(fapl, &bufSize, &minMetaPerc, &minRawPerc);
+  H5Pclose(fapl);
+  return bufSize;
+}
+#endif
+
+/// Chunk cache of the open dataset \p path.
+ChunkCache datasetChunkCache(const std::string & path) {
+  std::vector<hid_t> ids(H5Fget_obj_count(H5F_OBJ_ALL, H5F_OBJ_DATASET));
+  H5Fget_obj_ids(H5F_OBJ_ALL, H5F_OBJ_DATASET, ids.size(), ids.data());
+  for (const hid_t id : ids) {
+    std::vector<char> name(H5Iget_name(id, nullptr, 0) + 1);
+    H5Iget_name(id, name.data(), name.size());
+    if (std::string(name.data()) != path) continue;
+    hid_t dapl = H5Dget_access_plist(id);
+    ChunkCache cache;
+    double w0;
+    H5Pget_chunk_cache(dapl, &cache.nslots, &cache.nbytes, &w0);
+    H5Pclose(dapl);
+    return cache;
+  }
+  throw eckit::testing::TestException("Dataset " + path + " is not open", Here());
+}
+
+CASE("Write the test file") {
+  writeTestFile();
+}
+
+CASE("Chunk caches are derived from the chunk layouts within the per file limit") {
+  Group f = openTestFile(Engines::BackendOpenModes::Read_Only, 0);
+  const ChunkCache fileCache = fileChunkCache();
+
+  // Datasets that are not chunked, or whose chunks fit, keep the file cache
+  {
+    Variable small = f.vars.open("small");
+    EXPECT_EQUAL(datasetChunkCache("/small").nbytes, fileCache.nbytes);
+  }
+
+  // The cache holds the chunks covering one range of locations, with about 100 hash
+  // slots per chunk
+  {
+    Variable medium = f.vars.open("medium");
+    const ChunkCache cache = datasetChunkCache("/medium");
+    EXPECT_EQUAL(cache.nbytes, std::size_t(1600000));
+    EXPECT(cache.nslots >= 2000);
+  }
+  const std::size_t budget = 256 * MiB - (1600000 - fileCache.nbytes);
+
+  // Large layouts are capped at 64 MiB per dataset, and reopening a dataset does not take
+  // more of the file budget.
+  for (int i = 0; i < 3; ++i) {
+    Variable big1 = f.vars.open("Group/big1");
+    EXPECT_EQUAL(datasetChunkCache("/Group/big1").nbytes, 64 * MiB);
+  }
+  Group grp = f.open("Group");
+  for (int i = 2; i <= 3; ++i) {
+    const std::string name = "big" + std::to_string(i);
+    Variable big = grp.vars.open(name);
+    EXPECT_EQUAL(datasetChunkCache("/Group/" + name).nbytes, 64 * MiB);
+  }
+
+  // The last datasets get what is left of the budget, then the file cache
+  const std::size_t perDataset = 64 * MiB - fileCache.nbytes;
+  const std::size_t left = budget - 3 * perDataset;
+  std::size_t remaining = left;
+  for (int i = 4; i <= 6; ++i) {
+    const std::string name = "Group/big" + std::to_string(i);
+    const std::size_t extra = std::min(perDataset, remaining);
+    remaining -= extra;
+    Variable big = f.vars.open(name);
+    EXPECT_EQUAL(datasetChunkCache("/" + name).nbytes, fileCache.nbytes + extra);
+  }
+  EXPECT(remaining == 0);
+}
+
+CASE("An explicit chunk cache size is used for every dataset") {
+  Group f = openTestFile(Engines::BackendOpenModes::Read_Only, 2 * MiB);
+  EXPECT_EQUAL(fileChunkCache().nbytes, 2 * MiB);
+
+  Variable medium = f.vars.open("medium");
+  EXPECT_EQUAL(datasetChunkCache("/medium").nbytes, 2 * MiB);
+  Variable big = f.vars.open("Group/big1");
+  EXPECT_EQUAL(datasetChunkCache("/Group/big1").nbytes, 2 * MiB);
+}
+
+CASE("Chunk caches are not derived for files opened for writing") {
+  Group f = openTestFile(Engines::BackendOpenModes::Read_Write, 0);
+  const ChunkCache fileCache = fileChunkCache();
+
+  Variable big = f.vars.open("Group/big1");
+  EXPECT_EQUAL(datasetChunkCache("/Group/big1").nbytes, fileCache.nbytes);
+}
+
+#if H5_VERSION_GE(1, 10, 1)
+CASE("A page buffer is not set for files without paged file space") {
+  Engines::Hdf5FileTuning tuning;
+  tuning.pageBufferBytes = 4 * MiB;
+  Group f = constructTestFile(fileName, Engines::BackendFileActions::Open, tuning);
+  EXPECT_EQUAL(filePageBufferSize(fileName), std::size_t(0));
+
+  Variable medium = f.vars.open("medium");
+  EXPECT(medium.getDimensions().numElements == 2000000);
+}
+
+CASE("A page buffer is set for files with paged file space") {
+  Engines::Hdf5FileTuning tuning;
+  tuning.pageBufferBytes = 4 * MiB;
+
+  // The writer ignores the page buffer unless the file is paged
+  {
+    Group f = constructTestFile(pagedFileName, Engines::BackendFileActions::Create, tuning);
+    EXPECT_EQUAL(filePageBufferSize(pagedFileName), std::size_t(0));
+  }
+
+  tuning.fileSpacePageSize = 64 * 1024;
+  {
+    Group f = constructTestFile(pagedFileName, Engines::BackendFileActions::Create, tuning);
+    EXPECT_EQUAL(filePageBufferSize(pagedFileName), 4 * MiB);
+    f.vars.create<int>("ints", {1000});
+  }
+
+  // The reader finds the paged file space in the file
+  tuning.fileSpacePageSize = 0;
+  {
+    Group f = constructTestFile(pagedFileName, Engines::BackendFileActions::Open, tuning);
+    EXPECT_EQUAL(filePageBufferSize(pagedFileName), 4 * MiB);
+    EXPECT(f.vars.exists("ints"));
+  }
+}
+
+CASE("A page buffer smaller than one page is rejected") {
+  Engines::Hdf5FileTuning tuning;
+  tuning.pageBufferBytes = 4096;
+  tuning.fileSpacePageSize = 64 * 1024;
+  EXPECT_THROWS(constructTestFile(pagedFileName, Engines::BackendFileActions::Create, tuning));
+
+  // The page size of the file written by the previous case is 64 KiB
+  EXPECT_THROWS(constructTestFile(pagedFileName, Engines::BackendFileActions::Open, tuning));
+}
+#endif
+
+}  // namespace test
+}  // namespace ioda
+
+int main(int argc, char** argv) { return run_tests(argc, argv); }
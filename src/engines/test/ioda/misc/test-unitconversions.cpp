@@ -0,0 +1,134 @@
+/*
+ * (C) Crown Copyright 2022 Met Office
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include "ioda/Misc/UnitConversions.h"
+#include "ioda/Units.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+using namespace eckit::testing;
+
+namespace ioda {
+namespace test {
+
+/// Converter applying a function given at construction, for testing the affine detection.
+class FunctionConverter : public udunits::Converter {
+public:
+  typedef double (*Function)(double);
+  explicit FunctionConverter(Function func) : func_(func) { detectAffine(); }
+  float* convert(const float* in, size_t N, float* out) const final {
+    for (size_t i = 0; i < N; ++i) out[i] = static_cast<float>(func_(in[i]));
+    return out;
+  }
+  double* convert(const double* in, size_t N, double* out) const final {
+    for (size_t i = 0; i < N; ++i) out[i] = func_(in[i]);
+    return out;
+  }
+
+private:
+  Function func_;
+};
+
+double celsiusToFahrenheit(double val) { return 1.8 * val + 32.0; }
+double square(double val) { return val * val; }
+
+bool isClose(double a, double b) {
+  return std::abs(a - b) <= 1.0e-9 * std::max(1.0, std::abs(b));
+}
+
+CASE("Convert a double column") {
+  std::vector<double> data = {0.0, 50.0, 100.0};
+  convertColumn("celsius", data);
+  const std::vector<double> expected = {273.15, 323.15, 373.15};
+  for (std::size_t i = 0; i < data.size(); ++i) EXPECT(isClose(data[i], expected[i]));
+}
+
+CASE("Convert a double column with missing values") {
+  const double missing = -9999.0;
+  std::vector<double> data = {1.0, missing, 2.5};
+  convertColumn("hectopascal", data, missing);
+  EXPECT(data == std::vector<double>({100.0, missing, 250.0}));
+}
+
+CASE("Convert a float column with missing values") {
+  const float missing = 9.96921e+36f;
+  std::vector<float> data = {0.0f, missing, 100.0f};
+  convertColumn("celsius", data, missing);
+  EXPECT(data[1] == missing);
+  EXPECT(std::abs(data[0] - 273.15f) < 1.0e-4f);
+  EXPECT(std::abs(data[2] - 373.15f) < 1.0e-4f);
+}
+
+CASE("Convert an int column with missing values rounds to the nearest integer") {
+  const int missing = -2147483647;
+  // 3 knots = 1.54 m/s and 7 knots = 3.60 m/s, which truncation would make 1 and 3.
+  std::vector<int> data = {3, missing, 7, 10};
+  convertColumn("knot", data, missing);
+  EXPECT(data == std::vector<int>({2, missing, 4, 5}));
+
+  std::vector<int> negatives = {-3, -7};
+  convertColumn("knot", negatives, missing);
+  EXPECT(negatives == std::vector<int>({-2, -4}));
+}
+
+CASE("Convert a column with an unknown unit") {
+  std::vector<double> data = {1.0};
+  EXPECT_THROWS(convertColumn("furlong", data));
+  EXPECT_THROWS(getSIUnit("furlong"));
+  EXPECT(getSIUnit("knot") == "meters per second");
+}
+
+CASE("Affine conversions are detected") {
+  FunctionConverter converter(celsiusToFahrenheit);
+  EXPECT(converter.isAffine());
+  EXPECT(isClose(converter.scale(), 1.8));
+  EXPECT(isClose(converter.offset(), 32.0));
+
+  std::vector<int> data = {0, 100, 37, -999};
+  converter.convertInPlace(data.data(), data.size(), -999);
+  EXPECT(data == std::vector<int>({32, 212, 99, -999}));
+}
+
+CASE("Nonlinear conversions are not detected as affine") {
+  FunctionConverter converter(square);
+  EXPECT(!converter.isAffine());
+
+  std::vector<float> in = {1.5f, 3.0f};
+  std::vector<float> out(in.size());
+  converter.tconvert(in.data(), in.size(), out.data());
+  EXPECT(out == std::vector<float>({2.25f, 9.0f}));
+
+  // Integer results of a nonlinear conversion are rounded as well.
+  std::vector<int> ints = {-1, 5};
+  converter.convertInPlace(ints.data(), ints.size(), -1);
+  EXPECT(ints == std::vector<int>({-1, 25}));
+}
+
+CASE("Udunits conversions are detected as affine") {
+  std::shared_ptr<udunits::Converter> kToC =
+      udunits::Units("K").getConverterTo(udunits::Units("degC"));
+  EXPECT(kToC->isAffine());
+  EXPECT(isClose(kToC->scale(), 1.0));
+  EXPECT(isClose(kToC->offset(), -273.15));
+
+  std::shared_ptr<udunits::Converter> hPaToPa =
+      udunits::Units("hPa").getConverterTo(udunits::Units("Pa"));
+  EXPECT(hPaToPa->isAffine());
+  EXPECT(isClose(hPaToPa->scale(), 100.0));
+  EXPECT(isClose(hPaToPa->offset(), 0.0));
+}
+
+}  // namespace test
+}  // namespace ioda
+
+int main(int argc, char** argv) { return run_tests(argc, argv); }
@@ -0,0 +1,156 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+#include "ObsStore/Selection.hpp"
+#include "ObsStore/VarAttrStore.hpp"
+
+using namespace eckit::testing;
+
+namespace ioda {
+namespace test {
+
+typedef std::vector<std::pair<std::size_t, std::size_t>> Runs;
+
+/// Linear memory indices of a selection, one point at a time.
+std::vector<std::size_t> pointIndices(ObsStore::Selection & sel) {
+  std::vector<std::size_t> indices;
+  for (sel.init_lin_indx(); !sel.end_lin_indx(); ) indices.push_back(sel.next_lin_indx());
+  return indices;
+}
+
+/// Runs of a selection, as (start, length) pairs.
+Runs selectionRuns(ObsStore::Selection & sel) {
+  Runs runs;
+  for (sel.init_lin_run(); !sel.end_lin_run(); ) {
+    std::size_t length;
+    const std::size_t start = sel.next_lin_run(length);
+    runs.emplace_back(start, length);
+  }
+  return runs;
+}
+
+/// Linear memory indices obtained by expanding the runs of a selection.
+std::vector<std::size_t> expandRuns(const Runs & runs) {
+  std::vector<std::size_t> indices;
+  for (const auto & run : runs) {
+    for (std::size_t i = 0; i < run.second; ++i) indices.push_back(run.first + i);
+  }
+  return indices;
+}
+
+/// Check that the runs of a selection match the expected runs, and cover the same
+/// indices in the same order as the point-by-point walk.
+void checkRuns(ObsStore::Selection & sel, const Runs & expectedRuns) {
+  const Runs runs = selectionRuns(sel);
+  EXPECT(runs == expectedRuns);
+  EXPECT(expandRuns(runs) == pointIndices(sel));
+}
+
+CASE("ALL selection is a single run") {
+  ObsStore::Selection sel(0, 12);
+  checkRuns(sel, {{0, 12}});
+}
+
+CASE("Adjacent indices merge into runs") {
+  ObsStore::Selection sel(ObsStore::SelectionModes::INTERSECT, {{2, 3, 4, 7, 8}}, {10});
+  checkRuns(sel, {{2, 3}, {7, 2}});
+}
+
+CASE("Repeated indices start a new run") {
+  ObsStore::Selection sel(ObsStore::SelectionModes::INTERSECT, {{3, 4, 4, 5}}, {10});
+  checkRuns(sel, {{3, 2}, {4, 2}});
+}
+
+CASE("Out of order indices are not merged") {
+  ObsStore::Selection sel(ObsStore::SelectionModes::INTERSECT, {{5, 4, 3}}, {10});
+  checkRuns(sel, {{5, 1}, {4, 1}, {3, 1}});
+}
+
+CASE("Completely selected trailing dimensions fold into the run") {
+  // Locations 1 and 2 of a 4 x 5 x 6 variable: one run of 2 * 5 * 6 elements
+  ObsStore::Selection sel(ObsStore::SelectionModes::INTERSECT,
+                          {{1, 2}, {0, 1, 2, 3, 4}, {0, 1, 2, 3, 4, 5}}, {4, 5, 6});
+  checkRuns(sel, {{30, 60}});
+}
+
+CASE("Partially selected trailing dimension gives runs per location") {
+  // Channels 1, 2 and 4 of a 3 x 6 variable
+  ObsStore::Selection sel(ObsStore::SelectionModes::INTERSECT,
+                          {{0, 1, 2}, {1, 2, 4}}, {3, 6});
+  checkRuns(sel, {{1, 2}, {4, 1}, {7, 2}, {10, 1}, {13, 2}, {16, 1}});
+}
+
+CASE("Hyperslab in the middle dimension") {
+  // Locations 0 and 2, levels 1 to 2, all of 3 channels of a 3 x 4 x 3 variable
+  ObsStore::Selection sel(ObsStore::SelectionModes::INTERSECT,
+                          {{0, 2}, {1, 2}, {0, 1, 2}}, {3, 4, 3});
+  checkRuns(sel, {{3, 6}, {27, 6}});
+}
+
+CASE("Adjacent points merge into runs") {
+  // Points (0,1), (0,2), (1,0), (3,3) of a 4 x 4 variable
+  ObsStore::Selection sel(ObsStore::SelectionModes::POINT, {{0, 0, 1, 3}, {1, 2, 0, 3}},
+                          {4, 4});
+  checkRuns(sel, {{1, 2}, {4, 1}, {15, 1}});
+}
+
+CASE("Empty selection has no runs") {
+  ObsStore::Selection sel(ObsStore::SelectionModes::INTERSECT, {{}, {0, 1}}, {4, 2});
+  EXPECT(selectionRuns(sel).empty());
+}
+
+CASE("Run pairs split at the boundaries of both selections") {
+  ObsStore::Selection mSel(0, 6);
+  ObsStore::Selection fSel(ObsStore::SelectionModes::INTERSECT, {{0, 1, 2}, {1, 2}}, {3, 4});
+  Runs mRuns;
+  Runs fRuns;
+  ObsStore::forEachRunPair(mSel, fSel,
+                           [&](std::size_t mIndx, std::size_t fIndx, std::size_t count) {
+    mRuns.emplace_back(mIndx, count);
+    fRuns.emplace_back(fIndx, count);
+  });
+  EXPECT(mRuns == Runs({{0, 2}, {2, 2}, {4, 2}}));
+  EXPECT(fRuns == Runs({{1, 2}, {5, 2}, {9, 2}}));
+}
+
+CASE("Store write and read through runs match the point-by-point transfer") {
+  // Write channels 1, 2 and 4 of a 3 x 6 variable, then read them back.
+  ObsStore::VarAttrStore<float> store;
+  store.resize(18);
+  std::vector<float> values(9);
+  for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<float>(i + 1);
+
+  ObsStore::Selection mSel(0, 9);
+  ObsStore::Selection fSel(ObsStore::SelectionModes::INTERSECT,
+                           {{0, 1, 2}, {1, 2, 4}}, {3, 6});
+  store.write(gsl::make_span(reinterpret_cast<const char *>(values.data()),
+                             values.size() * sizeof(float)), mSel, fSel);
+
+  std::vector<float> all(18, -1.0f);
+  ObsStore::Selection allSel(0, 18);
+  ObsStore::Selection allMemSel(0, 18);
+  store.read(gsl::make_span(reinterpret_cast<char *>(all.data()), all.size() * sizeof(float)),
+             allMemSel, allSel);
+  const std::vector<float> expectedAll = {0, 1, 2, 0, 3, 0, 0, 4, 5, 0, 6, 0, 0, 7, 8, 0, 9, 0};
+  EXPECT(all == expectedAll);
+
+  std::vector<float> readBack(9, -1.0f);
+  store.read(gsl::make_span(reinterpret_cast<char *>(readBack.data()),
+                            readBack.size() * sizeof(float)), mSel, fSel);
+  EXPECT(readBack == values);
+}
+
+}  // namespace test
+}  // namespace ioda
+
+int main(int argc, char** argv) { return run_tests(argc, argv); }
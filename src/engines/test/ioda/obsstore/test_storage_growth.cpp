@@ -0,0 +1,135 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+#include "ioda/Engines/ObsStore.h"
+#include "ioda/ObsGroup.h"
+
+#include "ObsStore/VarAttrStore.hpp"
+
+using namespace eckit::testing;
+
+namespace ioda {
+namespace test {
+
+CASE("growStorage at least doubles the capacity") {
+  std::vector<int> storage;
+  storage.reserve(10);
+  ObsStore::growStorage(storage, 11);
+  EXPECT(storage.capacity() >= 20);
+
+  // A request beyond double the capacity is honoured as is
+  const std::size_t capacity = storage.capacity();
+  ObsStore::growStorage(storage, 4 * capacity);
+  EXPECT(storage.capacity() >= 4 * capacity);
+
+  // A request within the capacity does nothing
+  const std::size_t grownCapacity = storage.capacity();
+  ObsStore::growStorage(storage, grownCapacity);
+  EXPECT(storage.capacity() == grownCapacity);
+}
+
+CASE("Growing one element at a time reallocates a logarithmic number of times") {
+  ObsStore::VarAttrStore<float> store;
+  const std::size_t numSteps = 10000;
+  std::size_t numReallocs = 0;
+  std::size_t capacity = store.capacity();
+  for (std::size_t i = 1; i <= numSteps; ++i) {
+    store.resize(i);
+    if (store.capacity() != capacity) {
+      numReallocs++;
+      EXPECT(store.capacity() >= 2 * capacity);
+      capacity = store.capacity();
+    }
+  }
+  // Doubling from 1 reaches 10000 after 15 reallocations
+  EXPECT(numReallocs <= 16);
+}
+
+CASE("Reserve sets the capacity without changing the data") {
+  // Three elements per datum, as for a Location x Channel variable with 3 channels
+  ObsStore::VarAttrStore<int> store(3);
+  store.resize(2);
+  std::vector<int> values(6);
+  std::iota(values.begin(), values.end(), 1);
+  ObsStore::Selection allSel(0, 6);
+  store.write(gsl::make_span(reinterpret_cast<const char *>(values.data()),
+                             values.size() * sizeof(int)), allSel, allSel);
+
+  store.reserve(100);
+  const std::size_t capacity = store.capacity();
+  EXPECT(capacity >= 100);
+
+  // Growing within the reservation does not reallocate
+  store.resize(60);
+  store.resize(100);
+  EXPECT(store.capacity() == capacity);
+
+  std::vector<int> readBack(6);
+  store.read(gsl::make_span(reinterpret_cast<char *>(readBack.data()),
+                            readBack.size() * sizeof(int)), allSel, allSel);
+  EXPECT(readBack == values);
+}
+
+CASE("shrinkToFit keeps the data") {
+  ObsStore::VarAttrStore<double> store;
+  store.reserve(1000);
+  store.resize(10);
+  EXPECT(store.capacity() >= 1000);
+  std::vector<double> values(10);
+  std::iota(values.begin(), values.end(), 0.5);
+  ObsStore::Selection allSel(0, 10);
+  store.write(gsl::make_span(reinterpret_cast<const char *>(values.data()),
+                             values.size() * sizeof(double)), allSel, allSel);
+
+  // Releasing the unused capacity is a non-binding request, so only the data are checked
+  store.shrinkToFit();
+  EXPECT(store.capacity() >= 10);
+  std::vector<double> readBack(10);
+  store.read(gsl::make_span(reinterpret_cast<char *>(readBack.data()),
+                            readBack.size() * sizeof(double)), allSel, allSel);
+  EXPECT(readBack == values);
+}
+
+CASE("ObsGroup reserve, resize and shrinkToFit keep the data") {
+  const Dimensions_t numLocs = 5;
+  const Dimensions_t numChans = 3;
+  Group backend = Engines::ObsStore::createRootGroup();
+  ObsGroup og = ObsGroup::generate(
+    backend, {NewDimensionScale<int>("Location", numLocs, Unlimited, numLocs),
+              NewDimensionScale<int>("Channel", numChans, numChans, numChans)});
+  Variable locVar = og.vars.open("Location");
+  Variable chanVar = og.vars.open("Channel");
+  Variable obsVar = og.vars.createWithScales<float>("ObsValue/brightnessTemperature",
+                                                   {locVar, chanVar});
+  std::vector<float> values(numLocs * numChans);
+  std::iota(values.begin(), values.end(), 0.0f);
+  obsVar.write<float>(values);
+
+  og.reserve({std::pair<Variable, Dimensions_t>(locVar, 4 * numLocs)});
+  EXPECT(obsVar.getDimensions().dimsCur == std::vector<Dimensions_t>({numLocs, numChans}));
+
+  og.resize({std::pair<Variable, Dimensions_t>(locVar, 2 * numLocs)});
+  og.shrinkToFit();
+  EXPECT(obsVar.getDimensions().dimsCur == std::vector<Dimensions_t>({2 * numLocs, numChans}));
+
+  std::vector<float> readBack;
+  obsVar.read<float>(readBack);
+  EXPECT(readBack.size() == static_cast<std::size_t>(2 * numLocs * numChans));
+  EXPECT(std::vector<float>(readBack.begin(), readBack.begin() + values.size()) == values);
+}
+
+}  // namespace test
+}  // namespace ioda
+
+int main(int argc, char** argv) { return run_tests(argc, argv); }
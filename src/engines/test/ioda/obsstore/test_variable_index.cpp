@@ -0,0 +1,96 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+#include "ObsStore/Group.hpp"
+#include "ObsStore/Type.hpp"
+#include "ObsStore/Variables.hpp"
+
+using namespace eckit::testing;
+
+namespace ioda {
+namespace test {
+
+/// Create a one dimensional variable of the given type.
+std::shared_ptr<ObsStore::Variable> createVar(ObsStore::Has_Variables & vars,
+                                              const std::string & name,
+                                              ObsStore::ObsTypes type,
+                                              ObsStore::ObsTypeClasses typeClass,
+                                              std::size_t typeSize) {
+  auto dtype = std::make_shared<ObsStore::Type>(type, typeClass, typeSize, true);
+  return vars.create(name, dtype, {4}, {4}, ObsStore::VarCreateParams());
+}
+
+std::shared_ptr<ObsStore::Variable> createFloatVar(ObsStore::Has_Variables & vars,
+                                                   const std::string & name) {
+  return createVar(vars, name, ObsStore::ObsTypes::FLOAT, ObsStore::ObsTypeClasses::FLOAT,
+                   sizeof(float));
+}
+
+CASE("Removing a variable through a subgroup drops it from the root index") {
+  std::shared_ptr<ObsStore::Group> root = ObsStore::Group::createRootGroup();
+  auto var = createFloatVar(*root->vars, "ObsValue/airTemperature");
+
+  // Opening by path from the root puts the variable in the root index
+  EXPECT(root->vars->open("ObsValue/airTemperature") == var);
+
+  const std::size_t version = root->vars->structureVersion();
+  std::shared_ptr<ObsStore::Group> subgroup = root->open("ObsValue");
+  subgroup->vars->remove("airTemperature");
+  EXPECT(root->vars->structureVersion() != version);
+  EXPECT(subgroup->vars->structureVersion() == root->vars->structureVersion());
+
+  EXPECT(!root->vars->exists("ObsValue/airTemperature"));
+  EXPECT_THROWS(root->vars->open("ObsValue/airTemperature"));
+}
+
+CASE("Renaming a variable drops the old path from the index") {
+  std::shared_ptr<ObsStore::Group> root = ObsStore::Group::createRootGroup();
+  auto var = createFloatVar(*root->vars, "ObsValue/airTemperature");
+  EXPECT(root->vars->open("ObsValue/airTemperature") == var);
+
+  root->vars->rename("ObsValue/airTemperature", "virtualTemperature");
+  EXPECT(!root->vars->exists("ObsValue/airTemperature"));
+  EXPECT(root->vars->exists("ObsValue/virtualTemperature"));
+  EXPECT(root->vars->open("ObsValue/virtualTemperature") == var);
+}
+
+CASE("A re-created variable replaces the indexed one") {
+  std::shared_ptr<ObsStore::Group> root = ObsStore::Group::createRootGroup();
+  auto floatVar = createFloatVar(*root->vars, "MetaData/stationId");
+  EXPECT(root->vars->open("MetaData/stationId") == floatVar);
+
+  root->vars->remove("MetaData/stationId");
+  auto intVar = createVar(*root->vars, "MetaData/stationId", ObsStore::ObsTypes::INT,
+                          ObsStore::ObsTypeClasses::INTEGER, sizeof(int));
+  std::shared_ptr<ObsStore::Variable> opened = root->vars->open("MetaData/stationId");
+  EXPECT(opened == intVar);
+  EXPECT(opened->dtype()->getType() == ObsStore::ObsTypes::INT);
+}
+
+CASE("Changes to one group tree leave the index of another tree alone") {
+  std::shared_ptr<ObsStore::Group> root1 = ObsStore::Group::createRootGroup();
+  std::shared_ptr<ObsStore::Group> root2 = ObsStore::Group::createRootGroup();
+  createFloatVar(*root1->vars, "ObsValue/airTemperature");
+  auto var2 = createFloatVar(*root2->vars, "ObsValue/airTemperature");
+  EXPECT(root2->vars->open("ObsValue/airTemperature") == var2);
+
+  const std::size_t version2 = root2->vars->structureVersion();
+  root1->vars->remove("ObsValue/airTemperature");
+  EXPECT(root2->vars->structureVersion() == version2);
+  EXPECT(root2->vars->open("ObsValue/airTemperature") == var2);
+}
+
+}  // namespace test
+}  // namespace ioda
+
+int main(int argc, char** argv) { return run_tests(argc, argv); }
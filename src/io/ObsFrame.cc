@@ -128,22 +128,12 @@ Selection ObsFrame::createObsIoSelection(const std::vector<Dimensions_t> & varSh
 }
 
 //------------------------------------------------------------------------------------
-void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varList,
-                                       const VarUtils::Vec_Named_Variable & dimVarList,
-                                       const VarUtils::VarDimMap & varDimMap) {
-    // create an ObsGroup with an in-memory backend
-    Engines::BackendNames backendName;
-    Engines::BackendCreationParameters backendParams;
-    backendParams.action = Engines::BackendFileActions::Create;
-    backendParams.createMode = Engines::BackendCreateModes::Truncate_If_Exists;
-    backendParams.fileName = ioda::Engines::HH::genUniqueName();
-    backendParams.allocBytes = 1024*1024*50;
-    backendParams.flush = false;
-
-    backendName = Engines::BackendNames::ObsStore;  // Hdf5Mem;  ObsStore;
-    Group backend = constructBackend(backendName, backendParams);
-
-    // create dimensions for frame
+ObsGroup ObsFrame::createObsGroupStructure(Group & backend,
+                                           const VarUtils::Vec_Named_Variable & varList,
+                                           const VarUtils::Vec_Named_Variable & dimVarList,
+                                           const VarUtils::VarDimMap & varDimMap,
+                                           const bool cropLocationOnly) {
+    // create dimensions
     NewDimensionScales_t newDims;
     for (auto & dimNameObject : dimVarList) {
         std::string dimName = dimNameObject.name;
@@ -152,7 +142,11 @@ void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varL
         // Don't allow Channel to be limited by the frame size since Channel is
         // the second dimension (and we are only limiting the frame size on
         // the first dimension, typically Location).
-        if (dimName != "Channel") {
+        //
+        // When cropLocationOnly is set, only crop the Location dimension. This is used
+        // for building a replica of the backend structure.
+        bool cropDim = cropLocationOnly ? (dimName == "Location") : (dimName != "Channel");
+        if (cropDim) {
             if (dimSize > max_frame_size_) {
                 dimSize = max_frame_size_;
             }
@@ -172,13 +166,13 @@ void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varL
               },
               VarUtils::ThrowIfVariableIsOfUnsupportedType(dimName));
     }
-    obs_frame_ = ObsGroup::generate(backend, newDims);
+    ObsGroup destGroup = ObsGroup::generate(backend, newDims);
 
     // fill in dimension coordinate values
     for (auto & dimVarNameObject : dimVarList) {
         std::string dimVarName = dimVarNameObject.name;
         Variable srcDimVar = dimVarNameObject.var;
-        Variable destDimVar = obs_frame_.vars.open(dimVarName);
+        Variable destDimVar = destGroup.vars.open(dimVarName);
 
         // Set up the dimension selection objects. The prior loop declared the
         // sizes of all the dimensions in the frame so use that as a guide, and
@@ -207,7 +201,7 @@ void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varL
         }
     }
 
-    // create variables for frame
+    // create variables
     for (auto & varNameObject : varList) {
         std::string varName = varNameObject.name;
 
@@ -215,7 +209,7 @@ void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varL
         VarUtils::Vec_Named_Variable dimVarNames = varDimMap.at(varNameObject);
         std::vector<Variable> dimVars;
         for (auto & dimVarName : dimVarNames) {
-          dimVars.push_back(obs_frame_.vars.open(dimVarName.name));
+          dimVars.push_back(destGroup.vars.open(dimVarName.name));
         }
 
         Variable sourceVar = varNameObject.var;
@@ -228,12 +222,38 @@ void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varL
                       auto varFillValue = sourceVar.getFillValue();
                       params.setFillValue<T>(ioda::detail::getFillValue<T>(varFillValue));
                   }
-                  Variable destVar = obs_frame_.vars.createWithScales<T>(
+                  Variable destVar = destGroup.vars.createWithScales<T>(
                       varName, dimVars, params);
                   copyAttributes(sourceVar.atts, destVar.atts);
               },
               VarUtils::ThrowIfVariableIsOfUnsupportedType(varName));
     }
+    return destGroup;
+}
+
+//------------------------------------------------------------------------------------
+void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varList,
+                                       const VarUtils::Vec_Named_Variable & dimVarList,
+                                       const VarUtils::VarDimMap & varDimMap) {
+    obs_frame_ = createFrameGroup(varList, dimVarList, varDimMap);
+}
+
+//------------------------------------------------------------------------------------
+ObsGroup ObsFrame::createFrameGroup(const VarUtils::Vec_Named_Variable & varList,
+                                    const VarUtils::Vec_Named_Variable & dimVarList,
+                                    const VarUtils::VarDimMap & varDimMap) {
+    // create an ObsGroup with an in-memory backend
+    Engines::BackendNames backendName;
+    Engines::BackendCreationParameters backendParams;
+    backendParams.action = Engines::BackendFileActions::Create;
+    backendParams.createMode = Engines::BackendCreateModes::Truncate_If_Exists;
+    backendParams.fileName = ioda::Engines::HH::genUniqueName();
+    backendParams.allocBytes = 1024*1024*50;
+    backendParams.flush = false;
+
+    backendName = Engines::BackendNames::ObsStore;  // Hdf5Mem;  ObsStore;
+    Group backend = constructBackend(backendName, backendParams);
+    ObsGroup frame = createObsGroupStructure(backend, varList, dimVarList, varDimMap, false);
 
     // If we are using the string or offset datetimes from the backend, then create the
     // epoch datetime variable. ObsSpace::initFromObsSource will expect the epoch
@@ -241,9 +261,9 @@ void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varL
     if (use_string_datetime_ || use_offset_datetime_) {
       VariableCreationParameters params;
       std::vector<Variable> dimVars;
-      dimVars.push_back(obs_frame_.vars.open("Location"));
+      dimVars.push_back(frame.vars.open("Location"));
       Variable destVar =
-          obs_frame_.vars.createWithScales<int64_t>("MetaData/dateTime", dimVars, params);
+          frame.vars.createWithScales<int64_t>("MetaData/dateTime", dimVars, params);
 
       std::string epochDatetime;
       if (use_string_datetime_) {
@@ -253,7 +273,7 @@ void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varL
       } else {
         // Using offset datetime, set the epoch to the "date_time" global attribute
         int refDtimeInt;
-        this->obs_data_in_->getObsGroup().atts.open("date_time").read<int>(refDtimeInt);
+        backend_obs_group_.atts.open("date_time").read<int>(refDtimeInt);
 
         int year = refDtimeInt / 1000000;     // refDtimeInt contains YYYYMMDDhh
         int tempInt = refDtimeInt % 1000000;
@@ -267,6 +287,7 @@ void ObsFrame::createFrameFromObsGroup(const VarUtils::Vec_Named_Variable & varL
       }
       destVar.atts.add<std::string>("units", epochDatetime);
     }
+    return frame;
 }
 
 }  // namespace ioda
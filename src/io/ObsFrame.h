@@ -89,7 +89,7 @@ class ObsFrame : public util::Printable {
     Dimensions_t backendMaxVarSize() const {return backend_max_var_size_;}
 
     /// \brief return the backend (not the frame) obs group
-    ObsGroup backendObsGroup() const {return obs_data_in_->getObsGroup();}
+    ObsGroup backendObsGroup() const {return backend_obs_group_;}
 
     /// \brief return list of indices indicating which locations were selected from ObsIo
     virtual std::vector<std::size_t> index() const {return std::vector<std::size_t>{};}
@@ -140,6 +140,12 @@ class ObsFrame : public util::Printable {
     /// \brief ioda engines backend for reading obs data
     std::unique_ptr<Engines::ReaderBase> obs_data_in_;
 
+    /// \brief ObsGroup holding the structure of the obs source
+    /// \details On the ranks that read the obs source this is the backend ObsGroup
+    /// itself. On the other ranks it is a replica of the backend structure (variables,
+    /// dimensions, attributes) without the variable data.
+    ObsGroup backend_obs_group_;
+
     /// \brief ObsGroup object (temporary storage for a single frame)
     ObsGroup obs_frame_;
 
@@ -234,6 +240,32 @@ class ObsFrame : public util::Printable {
                                  const VarUtils::Vec_Named_Variable & dimVarList,
                                  const VarUtils::VarDimMap & varDimMap);
 
+    /// \brief create and return an ObsGroup based frame
+    /// \details This does the work for createFrameFromObsGroup, but returns the frame
+    ///          instead of setting obs_frame_ so that additional frames can be created.
+    /// \param varList source ObsGroup list of regular variables
+    /// \param dimVarList source ObsGroup list of dimension variable names
+    /// \param varDimMap source ObsGroup map showing variables with associated dimensions
+    ObsGroup createFrameGroup(const VarUtils::Vec_Named_Variable & varList,
+                              const VarUtils::Vec_Named_Variable & dimVarList,
+                              const VarUtils::VarDimMap & varDimMap);
+
+    /// \brief create an ObsGroup with the dimensions and variables from a source ObsGroup
+    /// \details The variables are created with their fill values and attributes, but no
+    ///          variable data is transferred. The dimension coordinate values are transferred
+    ///          up to the (possibly cropped) dimension sizes.
+    /// \param backend ioda Group to hold the new ObsGroup
+    /// \param varList source ObsGroup list of regular variables
+    /// \param dimVarList source ObsGroup list of dimension variable names
+    /// \param varDimMap source ObsGroup map showing variables with associated dimensions
+    /// \param cropLocationOnly when true limit only the Location dimension to the maximum
+    ///          frame size, otherwise limit all dimensions except Channel
+    ObsGroup createObsGroupStructure(Group & backend,
+                                     const VarUtils::Vec_Named_Variable & varList,
+                                     const VarUtils::Vec_Named_Variable & dimVarList,
+                                     const VarUtils::VarDimMap & varDimMap,
+                                     const bool cropLocationOnly);
+
     /// \brief print() for oops::Printable base class
     /// \param ostream output stream
     virtual void print(std::ostream & os) const = 0;
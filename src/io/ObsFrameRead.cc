@@ -7,13 +7,17 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <numeric>
 
 #include "oops/util/Logger.h"
 
 #include "ioda/distribution/DistributionFactory.h"
 #include "ioda/Exception.h"
 #include "ioda/Copying.h"
+#include "ioda/Engines/HH.h"
 #include "ioda/io/ObsFrameRead.h"
+#include "ioda/Io/ReaderUtils.h"
 #include "ioda/Variables/VarUtils.h"
 
 namespace ioda {
@@ -31,22 +35,36 @@ namespace detail {
 //------------------------------------------------------------------------------------
 ObsFrameRead::ObsFrameRead(const ObsSpaceParameters & params) :
     ObsFrame(params) {
-    // Create the backend engine object. Use the "simulated variables" spec from
-    // the YAML (params.top_level_.simVars) since that is the required spec, thus
-    // the only list guaranteed to be available at this time (ie, before reading
-    // the obs input and constructing the ObsSpace).
-    Engines::ReaderCreationParameters createParams(
-        params.windowStart(), params.windowEnd(),
-        params.comm(), params.timeComm(),
-        params.top_level_.simVars.value().variables(), false);
-    obs_data_in_ = Engines::ReaderFactory::create(
-        params.top_level_.obsDataIn.value().engine.value().engineParameters, createParams);
-
-    ObsGroup og = obs_data_in_->getObsGroup();
+    // Create the reader io pool, and then the backend engine object on the ranks
+    // in the pool. Use the "simulated variables" spec from the YAML
+    // (params.top_level_.simVars) since that is the required spec, thus the only list
+    // guaranteed to be available at this time (ie, before reading the obs input and
+    // constructing the ObsSpace).
+    reader_pool_ = std::make_unique<ReaderPool>(
+        params_.top_level_.ioPool,
+        params_.top_level_.obsDataIn.value().engine.value().engineParameters,
+        params_.comm(), params_.timeComm(), params_.windowStart(), params_.windowEnd(),
+        params_.top_level_.simVars.value().variables());
+    obs_data_in_ = reader_pool_->createReaderEngine();
+    if (obs_data_in_ != nullptr) {
+        backend_obs_group_ = obs_data_in_->getObsGroup();
+    }
+
+    // Collect information from the backend which will help with frame initialization
+    // and frame looping. The ranks outside the io pool get a replica of the backend
+    // structure from rank 0.
+    max_frame_size_ = params.top_level_.obsDataIn.value().maxFrameSize;
+    oops::Log::debug() << "ObsFrameRead: maximum frame size: " << max_frame_size_ << std::endl;
+    max_prefetch_frames_ =
+        std::max(params.top_level_.obsDataIn.value().prefetchFrames.value(), 0);
+    prefetch_stop_ = false;
+    shareBackendStructure();
+
+    ObsGroup og = backend_obs_group_;
 
     // record number of locations from backend
-    backend_nlocs_ = og.vars.open("Location").getDimensions().dimsCur[0];
-    if (backend_nlocs_ == 0) {
+    backend_nlocs_ = backend_var_sizes_.at("Location");
+    if ((backend_nlocs_ == 0) && (obs_data_in_ != nullptr)) {
       oops::Log::warning() << "WARNING: Input file " << obs_data_in_->fileName()
                            << " contains zero observations" << std::endl;
     }
@@ -99,31 +117,44 @@ ObsFrameRead::ObsFrameRead(const ObsSpaceParameters & params) :
                         << std::endl;
     }
 
-    // Collect information from the backend which will help with frame initialization
-    // and frame looping. Note the call to collectVarDimInfo will cache variable
-    // and dimension information from the backend since doing these on the fly is
-    // very slow with the HDF5 backend.
-    VarUtils::collectVarDimInfo(og, backend_var_list_, backend_dim_var_list_,
-                                backend_dims_attached_to_vars_, backend_max_var_size_);
-
     // record variables by which observations should be grouped into records
     obs_grouping_vars_ = params.top_level_.obsDataIn.value().obsGrouping.value().obsGroupVars;
 
+    // Every rank does the locations check, record number assignment and the MPI
+    // distribution for all the locations in a frame. Record the variables these
+    // steps need so they can be broadcast from the rank that read the frame.
+    frame_bcast_vars_ = { "MetaData/dateTime", "MetaData/latitude", "MetaData/longitude" };
+    for (auto & obsGroupVarName : obs_grouping_vars_) {
+        std::string varName = std::string("MetaData/") + obsGroupVarName;
+        if (std::find(frame_bcast_vars_.begin(), frame_bcast_vars_.end(), varName) ==
+                frame_bcast_vars_.end()) {
+            frame_bcast_vars_.push_back(varName);
+        }
+    }
+
     // Create an MPI distribution
     const auto & distParams = params.top_level_.distribution.value().params.value();
     distname_ = distParams.name;
     dist_ = DistributionFactory::create(params.comm(), distParams);
-
-    max_frame_size_ = params.top_level_.obsDataIn.value().maxFrameSize;
-    oops::Log::debug() << "ObsFrameRead: maximum frame size: " << max_frame_size_ << std::endl;
 }
 
-ObsFrameRead::~ObsFrameRead() {}
+ObsFrameRead::~ObsFrameRead() {
+    stopPrefetch();
+
+    // Release the backend before the io pool since the backend engine holds a reference
+    // to the io pool communicator group.
+    obs_data_in_.reset();
+    reader_pool_->finalize();
+}
 
 //------------------------------------------------------------------------------------
 void ObsFrameRead::frameInit(Has_Attributes & destAttrs) {
+    // Shut down a prefetch from a prior walk through the frames
+    stopPrefetch();
+
     // reset counters, etc.
     frame_start_ = 0;
+    frame_num_ = 0;
     next_rec_num_ = 0;
     rec_num_increment_ = 1;
     unique_rec_nums_.clear();
@@ -140,7 +171,7 @@ void ObsFrameRead::frameInit(Has_Attributes & destAttrs) {
                             backend_dims_attached_to_vars_);
 
     // copy the global attributes
-    copyAttributes(obs_data_in_->getObsGroup().atts, destAttrs);
+    copyAttributes(backend_obs_group_.atts, destAttrs);
 
     // Collect variable and dimension information for downstream use. Don't use the
     // max_var_size_ from obs_frame_ since it is artificially cropped to the max_frame_size_.
@@ -149,11 +180,17 @@ void ObsFrameRead::frameInit(Has_Attributes & destAttrs) {
     Dimensions_t dummyMaxVarSize;
     VarUtils::collectVarDimInfo(obs_frame_, var_list_, dim_var_list_,
                                 dims_attached_to_vars_, dummyMaxVarSize);
+
+    // Start reading ahead on the ranks that read from the backend
+    if ((max_prefetch_frames_ > 0) && (obs_data_in_ != nullptr)) {
+        startPrefetch();
+    }
 }
 
 //------------------------------------------------------------------------------------
 void ObsFrameRead::frameNext() {
     frame_start_ += max_frame_size_;
+    frame_num_++;
     adjusted_location_frame_start_ += adjusted_location_frame_count_;
 }
 
@@ -167,71 +204,32 @@ bool ObsFrameRead::frameAvailable() {
         obs_frame_.resize(
             { std::pair<Variable, Dimensions_t>(LocationVar, frameCount("Location")) });
 
-        // Transfer all variable data
-        Dimensions_t frameStart = this->frameStart();
-        for (auto & varNameObject : backend_var_list_) {
-            std::string varName = varNameObject.name;
-            Variable sourceVar = varNameObject.var;
-            Dimensions_t frameCount = this->basicFrameCount(sourceVar);
-            if (frameCount > 0) {
-                // Transfer the variable data for this frame. Do this in two steps:
-                //    ObsIo --> memory buffer --> frame storage
-
-                // Selection objects for transfer;
-                std::vector<Dimensions_t> varShape = sourceVar.getDimensions().dimsCur;
-                Selection obsIoSelect = createObsIoSelection(varShape, frameStart, frameCount);
-                Selection memBufferSelect = createMemSelection(varShape, frameCount);
-                Selection obsFrameSelect = createEntireFrameSelection(varShape, frameCount);
-
-                // Transfer the data
-                Variable destVar = obs_frame_.vars.open(varName);
-
-                VarUtils::forAnySupportedVariableType(
-                      destVar,
-                      [&](auto typeDiscriminator) {
-                          typedef decltype(typeDiscriminator) T;
-                          std::vector<T> varValues;
-                          sourceVar.read<T>(varValues, memBufferSelect, obsIoSelect);
-                          destVar.write<T>(varValues, memBufferSelect, obsFrameSelect);
-                      },
-                      VarUtils::ThrowIfVariableIsOfUnsupportedType(varName));
+        // One of the io pool ranks reads this frame from the backend.
+        const int readerRank = frameReaderRank();
+        if (static_cast<int>(params_.comm().rank()) == readerRank) {
+            if (prefetch_thread_.joinable()) {
+                takePrefetchedFrame(frame_num_);
+            } else {
+                readFrameFromBackend(obs_frame_, frame_start_);
             }
         }
 
-        // If using the string or offset datetimes, convert those to epoch datetimes
-        if (use_string_datetime_) {
-          // Read in string datetimes and convert to time offsets. Use the window
-          // start time as the epoch.
-          std::vector<std::string> dtStrings;
-          Variable stringDtVar = obs_frame_.vars.open("MetaData/datetime");
-          stringDtVar.read<std::string>(dtStrings);
-          std::vector<int64_t> timeOffsets = convertDtStringsToTimeOffsets(
-              params_.windowStart(), dtStrings);
-
-          // Transfer the epoch datetime to the new variable.
-          Variable epochDtVar = obs_frame_.vars.open("MetaData/dateTime");
-          epochDtVar.write<int64_t>(timeOffsets);
-        } else if (use_offset_datetime_) {
-          // Use the date_time global attribute as the epoch. This means that
-          // we just need to convert the float offset times in hours to an
-          // int64_t offset in seconds.
-          std::vector<float> dtTimeOffsets;
-          Variable offsetDtVar = obs_frame_.vars.open("MetaData/time");
-          offsetDtVar.read<float>(dtTimeOffsets);
-
-          std::vector<int64_t> timeOffsets(dtTimeOffsets.size());
-          for (std::size_t i = 0; i < dtTimeOffsets.size(); ++i) {
-            timeOffsets[i] = static_cast<int64_t>(lround(dtTimeOffsets[i] * 3600.0));
-          }
-
-          // Transfer the epoch datetime to the new variable.
-          Variable epochDtVar = obs_frame_.vars.open("MetaData/dateTime");
-          epochDtVar.write<int64_t>(timeOffsets);
+        // Every rank needs the variables for the locations check, obs grouping and
+        // MPI distribution for the entire frame.
+        Dimensions_t locFrameCount = basicFrameCount("Location");
+        for (auto & varName : frame_bcast_vars_) {
+            if (obs_frame_.vars.exists(varName)) {
+                broadcastFrameVar(varName, locFrameCount, readerRank);
+            }
         }
 
         // generate the frame index and record numbers for this frame
         genFrameIndexRecNums(dist_);
 
+        // Now that each rank knows which frame locations it is keeping, get those
+        // locations from the reader rank.
+        distributeFrame(readerRank);
+
         // clear the selection caches
         known_frame_selections_.clear();
         known_mem_selections_.clear();
@@ -242,6 +240,15 @@ bool ObsFrameRead::frameAvailable() {
     return (haveAnotherFrame);
 }
 
+//------------------------------------------------------------------------------------
+Dimensions_t ObsFrameRead::locationCapacityHint() const {
+    const Dimensions_t commSize = params_.comm().size();
+    if (dist_->isIdentity() || (commSize <= 1)) {
+        return backend_nlocs_;
+    }
+    return (backend_nlocs_ + commSize - 1) / commSize;
+}
+
 //------------------------------------------------------------------------------------
 Dimensions_t ObsFrameRead::frameStart() {
     return frame_start_;
@@ -259,15 +266,20 @@ Dimensions_t ObsFrameRead::frameCount(const std::string & varName) {
     } else if (use_offset_datetime_ && (varName == "MetaData/dateTime")) {
         useVarName = "MetaData/time";
     }
-    Variable var = obs_data_in_->getObsGroup().vars.open(useVarName);
+    // Use the cached backend information instead of querying the backend since a
+    // prefetch thread may be accessing the backend.
+    bool isDimVar = std::any_of(backend_dim_var_list_.begin(), backend_dim_var_list_.end(),
+        [&useVarName](const Named_Variable & dimVar) {
+            return (dimVar.name == useVarName);
+        });
     Dimensions_t  fCount;
-    if (var.isDimensionScale()) {
-        fCount = basicFrameCount(var);
+    if (isDimVar) {
+        fCount = basicFrameCount(useVarName);
     } else {
         if (isVarDimByLocation_Impl(useVarName, backend_dims_attached_to_vars_)) {
             fCount = adjusted_location_frame_count_;
         } else {
-            fCount = basicFrameCount(var);
+            fCount = basicFrameCount(useVarName);
         }
     }
     return fCount;
@@ -298,11 +310,16 @@ void ObsFrameRead::print(std::ostream & os) const {
 }
 
 //------------------------------------------------------------------------------------
-Dimensions_t ObsFrameRead::basicFrameCount(const Variable & var) {
+Dimensions_t ObsFrameRead::basicFrameCount(const std::string & varName) {
+    return basicFrameCount(varName, frame_start_);
+}
+
+Dimensions_t ObsFrameRead::basicFrameCount(const std::string & varName,
+                                           const Dimensions_t frameStart) {
     Dimensions_t count;
-    Dimensions_t varSize0 = var.getDimensions().dimsCur[0];
-    if ((frame_start_ + max_frame_size_) > varSize0) {
-        count = varSize0 - frame_start_;
+    Dimensions_t varSize0 = backend_var_sizes_.at(varName);
+    if ((frameStart + max_frame_size_) > varSize0) {
+        count = varSize0 - frameStart;
         if (count < 0) { count = 0; }
     } else {
         count = max_frame_size_;
@@ -337,7 +354,7 @@ void ObsFrameRead::genFrameIndexRecNums(std::shared_ptr<Distribution> & dist) {
     // numbers. This is because we are generating record numbers on the fly
     // since we want to get to the point where we can do the MPI distribution
     // without knowing how many obs (and records) we are going to encounter.
-    if (obs_data_in_->applyLocationsCheck()) {
+    if (apply_locations_check_) {
         genFrameLocationsWithQcheck(locIndex, frameIndex);
     } else {
         genFrameLocationsAll(locIndex, frameIndex);
@@ -604,6 +621,466 @@ void ObsFrameRead::applyMpiDistribution(const std::shared_ptr<Distribution> & di
     nrecs_ = unique_rec_nums_.size();
 }
 
+//------------------------------------------------------------------------------------
+void ObsFrameRead::shareBackendStructure() {
+    const eckit::mpi::Comm & comm = params_.comm();
+    constexpr int root = 0;
+
+    // Only ship the backend structure when there are ranks outside the io pool. Rank 0
+    // is always a member of the io pool.
+    const bool haveNonPoolRanks = (reader_pool_->pool_ranks().size() < comm.size());
+    if (haveNonPoolRanks) {
+        // Note the call to collectVarDimInfo will cache variable and dimension information
+        // from the backend since doing these on the fly is very slow with the HDF5 backend.
+        if (comm.rank() == root) {
+            VarUtils::collectVarDimInfo(backend_obs_group_, backend_var_list_,
+                                        backend_dim_var_list_, backend_dims_attached_to_vars_,
+                                        backend_max_var_size_);
+        }
+
+        std::vector<char> image;
+        if (comm.rank() == root) {
+            image = Engines::HH::getFileImage(createBackendReplica());
+        }
+        std::size_t imageSize = image.size();
+        comm.broadcast(imageSize, root);
+        image.resize(imageSize);
+        comm.broadcast(image, root);
+        if (obs_data_in_ == nullptr) {
+            backend_obs_group_ =
+                Engines::HH::openMemoryFileImage(Engines::HH::genUniqueName(), image);
+        }
+    }
+    if ((!haveNonPoolRanks) || (comm.rank() != root)) {
+        VarUtils::collectVarDimInfo(backend_obs_group_, backend_var_list_,
+                                    backend_dim_var_list_, backend_dims_attached_to_vars_,
+                                    backend_max_var_size_);
+    }
+
+    // Record the sizes of the first dimension of the backend variables. The replica
+    // of the backend has its Location dimension cropped to the frame size, so the ranks
+    // outside the io pool get these from rank 0.
+    std::vector<std::string> varNames;
+    std::vector<Dimensions_t> varSizes;
+    int applyLocationsCheck = 0;
+    if (obs_data_in_ != nullptr) {
+        for (auto & varList : { backend_dim_var_list_, backend_var_list_ }) {
+            for (auto & varNameObject : varList) {
+                varNames.push_back(varNameObject.name);
+                varSizes.push_back(varNameObject.var.getDimensions().dimsCur[0]);
+            }
+        }
+        applyLocationsCheck = obs_data_in_->applyLocationsCheck() ? 1 : 0;
+    }
+    if (haveNonPoolRanks) {
+        broadcastStrings(comm, varNames, root);
+        varSizes.resize(varNames.size());
+        if (varSizes.size() > 0) {
+            comm.broadcast(varSizes, root);
+        }
+        comm.broadcast(backend_max_var_size_, root);
+        comm.broadcast(applyLocationsCheck, root);
+    }
+    for (std::size_t i = 0; i < varNames.size(); ++i) {
+        backend_var_sizes_[varNames[i]] = varSizes[i];
+    }
+    apply_locations_check_ = (applyLocationsCheck == 1);
+}
+
+//------------------------------------------------------------------------------------
+ObsGroup ObsFrameRead::createBackendReplica() {
+    // Use the HDF5 in-memory backend so that the replica can be transferred as a
+    // file image. Variables are created without writing any data so their storage
+    // is never allocated, which keeps the image small.
+    Engines::BackendNames backendName = Engines::BackendNames::Hdf5Mem;
+    Engines::BackendCreationParameters backendParams;
+    backendParams.action = Engines::BackendFileActions::Create;
+    backendParams.createMode = Engines::BackendCreateModes::Truncate_If_Exists;
+    backendParams.fileName = ioda::Engines::HH::genUniqueName();
+    backendParams.allocBytes = 1024*1024;
+    backendParams.flush = false;
+    Group backend = constructBackend(backendName, backendParams);
+
+    ObsGroup replica = createObsGroupStructure(backend, backend_var_list_,
+                           backend_dim_var_list_, backend_dims_attached_to_vars_, true);
+    copyAttributes(backend_obs_group_.atts, replica.atts);
+    return replica;
+}
+
+//------------------------------------------------------------------------------------
+int ObsFrameRead::frameReaderRank() const {
+    const std::vector<int> & poolRanks = reader_pool_->pool_ranks();
+    return poolRanks[frame_num_ % poolRanks.size()];
+}
+
+//------------------------------------------------------------------------------------
+void ObsFrameRead::readFrameFromBackend(ObsGroup & frame, const Dimensions_t frameStart) {
+    // Transfer all variable data
+    for (auto & varNameObject : backend_var_list_) {
+        std::string varName = varNameObject.name;
+        Variable sourceVar = varNameObject.var;
+        Dimensions_t frameCount = this->basicFrameCount(varName, frameStart);
+        if (frameCount > 0) {
+            // Transfer the variable data for this frame. Do this in two steps:
+            //    ObsIo --> memory buffer --> frame storage
+
+            // Selection objects for transfer;
+            std::vector<Dimensions_t> varShape = sourceVar.getDimensions().dimsCur;
+            Selection obsIoSelect = createObsIoSelection(varShape, frameStart, frameCount);
+            Selection memBufferSelect = createMemSelection(varShape, frameCount);
+            Selection obsFrameSelect = createEntireFrameSelection(varShape, frameCount);
+
+            // Transfer the data
+            Variable destVar = frame.vars.open(varName);
+
+            VarUtils::forAnySupportedVariableType(
+                  destVar,
+                  [&](auto typeDiscriminator) {
+                      typedef decltype(typeDiscriminator) T;
+                      std::vector<T> varValues;
+                      sourceVar.read<T>(varValues, memBufferSelect, obsIoSelect);
+                      destVar.write<T>(varValues, memBufferSelect, obsFrameSelect);
+                  },
+                  VarUtils::ThrowIfVariableIsOfUnsupportedType(varName));
+        }
+    }
+
+    // If using the string or offset datetimes, convert those to epoch datetimes
+    if (use_string_datetime_) {
+      // Read in string datetimes and convert to time offsets. Use the window
+      // start time as the epoch.
+      std::vector<std::string> dtStrings;
+      Variable stringDtVar = frame.vars.open("MetaData/datetime");
+      stringDtVar.read<std::string>(dtStrings);
+      std::vector<int64_t> timeOffsets = convertDtStringsToTimeOffsets(
+          params_.windowStart(), dtStrings);
+
+      // Transfer the epoch datetime to the new variable.
+      Variable epochDtVar = frame.vars.open("MetaData/dateTime");
+      epochDtVar.write<int64_t>(timeOffsets);
+    } else if (use_offset_datetime_) {
+      // Use the date_time global attribute as the epoch. This means that
+      // we just need to convert the float offset times in hours to an
+      // int64_t offset in seconds.
+      std::vector<float> dtTimeOffsets;
+      Variable offsetDtVar = frame.vars.open("MetaData/time");
+      offsetDtVar.read<float>(dtTimeOffsets);
+
+      std::vector<int64_t> timeOffsets(dtTimeOffsets.size());
+      for (std::size_t i = 0; i < dtTimeOffsets.size(); ++i) {
+        timeOffsets[i] = static_cast<int64_t>(lround(dtTimeOffsets[i] * 3600.0));
+      }
+
+      // Transfer the epoch datetime to the new variable.
+      Variable epochDtVar = frame.vars.open("MetaData/dateTime");
+      epochDtVar.write<int64_t>(timeOffsets);
+    }
+}
+
+//------------------------------------------------------------------------------------
+void ObsFrameRead::startPrefetch() {
+    // From here until stopPrefetch, only the prefetch thread may call into the backend
+    // (see the rule in ObsFrameRead.h).
+    // This rank reads every pool size-th frame starting with its position in the pool.
+    const std::vector<int> & poolRanks = reader_pool_->pool_ranks();
+    const int myRank = params_.comm().rank();
+    std::size_t poolIndex =
+        std::find(poolRanks.begin(), poolRanks.end(), myRank) - poolRanks.begin();
+    std::vector<std::size_t> frameNums;
+    for (std::size_t frameNum = poolIndex;
+         static_cast<Dimensions_t>(frameNum) * max_frame_size_ < max_var_size_;
+         frameNum += poolRanks.size()) {
+        frameNums.push_back(frameNum);
+    }
+    if (frameNums.empty()) {
+        return;
+    }
+
+    // Create the storage for the frames in flight up front so the prefetch thread
+    // only needs to read variable data from the backend. Together with obs_frame_
+    // this bounds the memory used to max_prefetch_frames_ + 1 frames.
+    prefetch_ready_frames_.clear();
+    prefetch_free_frames_.clear();
+    for (std::size_t i = 0; i < std::min(max_prefetch_frames_, frameNums.size()); ++i) {
+        prefetch_free_frames_.push_back(
+            createFrameGroup(backend_var_list_, backend_dim_var_list_,
+                             backend_dims_attached_to_vars_));
+    }
+    prefetch_stop_ = false;
+    prefetch_error_ = nullptr;
+    prefetch_thread_ = std::thread(&ObsFrameRead::prefetchFrames, this, frameNums);
+}
+
+//------------------------------------------------------------------------------------
+void ObsFrameRead::stopPrefetch() {
+    if (prefetch_thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(prefetch_mutex_);
+            prefetch_stop_ = true;
+        }
+        prefetch_cond_.notify_all();
+        prefetch_thread_.join();
+    }
+    prefetch_ready_frames_.clear();
+    prefetch_free_frames_.clear();
+}
+
+//------------------------------------------------------------------------------------
+void ObsFrameRead::prefetchFrames(const std::vector<std::size_t> & frameNums) {
+    try {
+        for (auto frameNum : frameNums) {
+            // Wait for free frame storage
+            ObsGroup frame;
+            {
+                std::unique_lock<std::mutex> lock(prefetch_mutex_);
+                prefetch_cond_.wait(lock, [this] {
+                    return (prefetch_stop_ || !prefetch_free_frames_.empty());
+                });
+                if (prefetch_stop_) {
+                    return;
+                }
+                frame = prefetch_free_frames_.front();
+                prefetch_free_frames_.pop_front();
+            }
+
+            Dimensions_t frameStart = frameNum * max_frame_size_;
+            Variable LocationVar = frame.vars.open("Location");
+            frame.resize({ std::pair<Variable, Dimensions_t>(
+                LocationVar, basicFrameCount("Location", frameStart)) });
+            readFrameFromBackend(frame, frameStart);
+
+            {
+                std::lock_guard<std::mutex> lock(prefetch_mutex_);
+                prefetch_ready_frames_.push_back(std::make_pair(frameNum, frame));
+            }
+            prefetch_cond_.notify_all();
+        }
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(prefetch_mutex_);
+            prefetch_error_ = std::current_exception();
+        }
+        prefetch_cond_.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------------------
+void ObsFrameRead::takePrefetchedFrame(const std::size_t frameNum) {
+    {
+        std::unique_lock<std::mutex> lock(prefetch_mutex_);
+        prefetch_cond_.wait(lock, [this] {
+            return ((prefetch_error_ != nullptr) || !prefetch_ready_frames_.empty());
+        });
+        if (prefetch_ready_frames_.empty()) {
+            std::rethrow_exception(prefetch_error_);
+        }
+        if (prefetch_ready_frames_.front().first != frameNum) {
+            std::string errorMsg = std::string("ObsFrameRead: prefetched frame ") +
+                std::to_string(prefetch_ready_frames_.front().first) +
+                std::string(" does not match the expected frame ") + std::to_string(frameNum);
+            throw Exception(errorMsg.c_str(), ioda_Here());
+        }
+
+        // Hand the storage of the frame just processed back to the prefetch thread.
+        prefetch_free_frames_.push_back(obs_frame_);
+        obs_frame_ = prefetch_ready_frames_.front().second;
+        prefetch_ready_frames_.pop_front();
+    }
+    prefetch_cond_.notify_all();
+}
+
+//------------------------------------------------------------------------------------
+template <typename DataType>
+void ObsFrameRead::broadcastFrameValues(std::vector<DataType> & values, const int readerRank) {
+    std::size_t numValues = values.size();
+    params_.comm().broadcast(numValues, readerRank);
+    values.resize(numValues);
+    if (numValues > 0) {
+        params_.comm().broadcast(values, readerRank);
+    }
+}
+
+template <>
+void ObsFrameRead::broadcastFrameValues(std::vector<std::string> & values,
+                                       const int readerRank) {
+    broadcastStrings(params_.comm(), values, readerRank);
+}
+
+//------------------------------------------------------------------------------------
+template <typename DataType>
+void ObsFrameRead::transferFrameRows(Variable & frameVar, const int readerRank,
+                                     const std::vector<int> & rowCounts,
+                                     const std::vector<Dimensions_t> & rowIndex) {
+    constexpr int mpiTag = 40000;
+    const eckit::mpi::Comm & comm = params_.comm();
+    const int myRank = comm.rank();
+
+    // A row is the entry for one location, ie all the elements in the second
+    // and subsequent dimensions.
+    std::vector<Dimensions_t> varShape = frameVar.getDimensions().dimsCur;
+    Dimensions_t rowSize = std::accumulate(varShape.begin() + 1, varShape.end(),
+                                           static_cast<Dimensions_t>(1),
+                                           std::multiplies<Dimensions_t>());
+    if (myRank == readerRank) {
+        // The reader keeps its own locations in place. Pack the locations kept by
+        // each of the other ranks and send them off.
+        std::vector<DataType> frameValues;
+        Dimensions_t frameCount = varShape[0];
+        frameVar.read<DataType>(frameValues, createMemSelection(varShape, frameCount),
+                                createEntireFrameSelection(varShape, frameCount));
+
+        std::vector<std::vector<DataType>> sendBuffers(comm.size());
+        std::vector<eckit::mpi::Request> sendRequests;
+        std::size_t rowStart = 0;
+        for (int rank = 0; rank < static_cast<int>(comm.size()); ++rank) {
+            const int numRows = rowCounts[rank];
+            if ((rank != myRank) && (numRows > 0)) {
+                std::vector<DataType> & buffer = sendBuffers[rank];
+                buffer.resize(numRows * rowSize);
+                for (int i = 0; i < numRows; ++i) {
+                    std::copy_n(frameValues.begin() + rowIndex[rowStart + i] * rowSize,
+                                rowSize, buffer.begin() + i * rowSize);
+                }
+                sendRequests.push_back(comm.iSend(buffer.data(), buffer.size(), rank, mpiTag));
+            }
+            rowStart += numRows;
+        }
+        comm.waitAll(sendRequests);
+    } else if (frame_loc_index_.size() > 0) {
+        std::vector<DataType> rowValues(frame_loc_index_.size() * rowSize);
+        eckit::mpi::Request recvRequest =
+            comm.iReceive(rowValues.data(), rowValues.size(), readerRank, mpiTag);
+        comm.wait(recvRequest);
+        frameVar.write<DataType>(rowValues,
+                                 createMemSelection(varShape, frame_loc_index_.size()),
+                                 createIndexedFrameSelection(varShape));
+    }
+}
+
+template <>
+void ObsFrameRead::transferFrameRows<std::string>(Variable & frameVar, const int readerRank,
+                                                  const std::vector<int> & rowCounts,
+                                                  const std::vector<Dimensions_t> & rowIndex) {
+    constexpr int mpiTag = 40000;
+    const eckit::mpi::Comm & comm = params_.comm();
+    const int myRank = comm.rank();
+
+    // Strings are sent as a vector of lengths followed by a single character buffer.
+    std::vector<Dimensions_t> varShape = frameVar.getDimensions().dimsCur;
+    Dimensions_t rowSize = std::accumulate(varShape.begin() + 1, varShape.end(),
+                                           static_cast<Dimensions_t>(1),
+                                           std::multiplies<Dimensions_t>());
+    if (myRank == readerRank) {
+        std::vector<std::string> frameValues;
+        Dimensions_t frameCount = varShape[0];
+        frameVar.read<std::string>(frameValues, createMemSelection(varShape, frameCount),
+                                   createEntireFrameSelection(varShape, frameCount));
+
+        std::vector<std::vector<int>> lengthBuffers(comm.size());
+        std::vector<std::vector<char>> charBuffers(comm.size());
+        std::vector<eckit::mpi::Request> sendRequests;
+        std::size_t rowStart = 0;
+        for (int rank = 0; rank < static_cast<int>(comm.size()); ++rank) {
+            const int numRows = rowCounts[rank];
+            if ((rank != myRank) && (numRows > 0)) {
+                std::vector<std::string> rowValues(numRows * rowSize);
+                for (int i = 0; i < numRows; ++i) {
+                    std::copy_n(frameValues.begin() + rowIndex[rowStart + i] * rowSize,
+                                rowSize, rowValues.begin() + i * rowSize);
+                }
+                packStrings(rowValues, lengthBuffers[rank], charBuffers[rank]);
+                sendRequests.push_back(comm.iSend(lengthBuffers[rank].data(),
+                                       lengthBuffers[rank].size(), rank, mpiTag));
+                sendRequests.push_back(comm.iSend(charBuffers[rank].data(),
+                                       charBuffers[rank].size(), rank, mpiTag));
+            }
+            rowStart += numRows;
+        }
+        comm.waitAll(sendRequests);
+    } else if (frame_loc_index_.size() > 0) {
+        std::vector<int> lengths(frame_loc_index_.size() * rowSize);
+        comm.receive(lengths.data(), lengths.size(), readerRank, mpiTag);
+        std::vector<char> chars(std::accumulate(lengths.begin(), lengths.end(), 0));
+        comm.receive(chars.data(), chars.size(), readerRank, mpiTag);
+
+        std::vector<std::string> rowValues;
+        unpackStrings(lengths, chars, rowValues);
+        frameVar.write<std::string>(rowValues,
+                                    createMemSelection(varShape, frame_loc_index_.size()),
+                                    createIndexedFrameSelection(varShape));
+    }
+}
+
+//------------------------------------------------------------------------------------
+void ObsFrameRead::broadcastFrameVar(const std::string & varName,
+                                     const Dimensions_t frameCount, const int readerRank) {
+    const bool isReader = (static_cast<int>(params_.comm().rank()) == readerRank);
+    Variable frameVar = obs_frame_.vars.open(varName);
+    std::vector<Dimensions_t> varShape = frameVar.getDimensions().dimsCur;
+    Selection memSelect = createMemSelection(varShape, frameCount);
+    Selection frameSelect = createEntireFrameSelection(varShape, frameCount);
+    VarUtils::forAnySupportedVariableType(
+          frameVar,
+          [&](auto typeDiscriminator) {
+              typedef decltype(typeDiscriminator) T;
+              std::vector<T> varValues;
+              if (isReader) {
+                  frameVar.read<T>(varValues, memSelect, frameSelect);
+              }
+              broadcastFrameValues<T>(varValues, readerRank);
+              if (!isReader) {
+                  frameVar.write<T>(varValues, memSelect, frameSelect);
+              }
+          },
+          VarUtils::ThrowIfVariableIsOfUnsupportedType(varName));
+}
+
+//------------------------------------------------------------------------------------
+void ObsFrameRead::distributeFrame(const int readerRank) {
+    const eckit::mpi::Comm & comm = params_.comm();
+    const bool isReader = (static_cast<int>(comm.rank()) == readerRank);
+
+    // Let the reader rank know which frame locations each rank is keeping.
+    int numRows = frame_loc_index_.size();
+    std::vector<int> rowCounts(comm.size(), 0);
+    comm.gather(numRows, rowCounts, readerRank);
+    std::vector<int> rowDispls(comm.size(), 0);
+    for (std::size_t i = 1; i < rowCounts.size(); ++i) {
+        rowDispls[i] = rowDispls[i - 1] + rowCounts[i - 1];
+    }
+    std::vector<Dimensions_t> rowIndex;
+    if (isReader) {
+        rowIndex.resize(rowDispls.back() + rowCounts.back());
+    }
+    comm.gatherv(frame_loc_index_, rowIndex, rowCounts, rowDispls, readerRank);
+
+    for (auto & varNameObject : backend_var_list_) {
+        const std::string & varName = varNameObject.name;
+        if (std::find(frame_bcast_vars_.begin(), frame_bcast_vars_.end(), varName) !=
+                frame_bcast_vars_.end()) {
+            // Already have the entire frame for this variable
+            continue;
+        }
+        Variable frameVar = obs_frame_.vars.open(varName);
+        if (isVarDimByLocation_Impl(varName, backend_dims_attached_to_vars_)) {
+            VarUtils::forAnySupportedVariableType(
+                  frameVar,
+                  [&](auto typeDiscriminator) {
+                      typedef decltype(typeDiscriminator) T;
+                      transferFrameRows<T>(frameVar, readerRank, rowCounts, rowIndex);
+                  },
+                  VarUtils::ThrowIfVariableIsOfUnsupportedType(varName));
+        } else {
+            // Variables not dimensioned by Location are not subject to the MPI
+            // distribution, so every rank gets the entire frame.
+            Dimensions_t frameCount = basicFrameCount(varName);
+            if (frameCount > 0) {
+                broadcastFrameVar(varName, frameCount, readerRank);
+            }
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 bool ObsFrameRead::insideTimingWindow(const util::DateTime & obsDt) {
     return ((obsDt > params_.windowStart()) && (obsDt <= params_.windowEnd()));
@@ -8,6 +8,14 @@
 #ifndef IO_OBSFRAMEREAD_H_
 #define IO_OBSFRAMEREAD_H_
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "eckit/config/LocalConfiguration.h"
@@ -15,6 +23,7 @@
 #include "ioda/core/IodaUtils.h"
 #include "ioda/distribution/Distribution.h"
 #include "ioda/io/ObsFrame.h"
+#include "ioda/Io/ReaderPool.h"
 #include "ioda/ObsSpaceParameters.h"
 #include "ioda/Variables/VarUtils.h"
 
@@ -29,6 +38,11 @@ namespace ioda {
 ///          reading data from an ObsIo object. This includes reading the frame,
 ///          filtering out obs that are outside the DA timing window, generating record
 ///          numbers, applying obs grouping (optional) and applying the MPI distribution.
+///
+///          Only the ranks in a reader io pool access the obs source. The frames are read
+///          by the pool ranks in a round-robin fashion. The pool rank that read a frame
+///          broadcasts the variables needed for the location checks and the record
+///          assignment, and then sends each rank only the frame locations it kept.
 /// \author Stephen Herbener (JCSDA)
 
 class ObsFrameRead : public ObsFrame, private util::ObjectCounter<ObsFrameRead> {
@@ -78,6 +92,13 @@ class ObsFrameRead : public ObsFrame, private util::ObjectCounter<ObsFrameRead>
     /// \brief return adjusted Location frame count
     Dimensions_t adjLocationFrameCount() const override {return adjusted_location_frame_count_;}
 
+    /// \brief return the expected number of locations kept on this rank after walking
+    /// through all of the frames
+    /// \details This is exact when every rank keeps every location, and otherwise assumes
+    /// the locations are shared evenly among the ranks. Use it to reserve storage up
+    /// front; it is not a limit on the number of locations.
+    Dimensions_t locationCapacityHint() const;
+
     /// \brief read a frame variable
     /// \details It's possible for some variables to not be included in the
     ///          read because the frame has gone past their ending index.
@@ -105,6 +126,50 @@ class ObsFrameRead : public ObsFrame, private util::ObjectCounter<ObsFrameRead>
     /// \brief MPI distribution object
     std::shared_ptr<Distribution> dist_;
 
+    /// \brief io pool of ranks that read the obs source
+    std::unique_ptr<ReaderPool> reader_pool_;
+
+    /// \brief true if the obs source locations need to be checked (timing window, etc.)
+    bool apply_locations_check_;
+
+    /// \brief size of the first dimension of the backend variables (including dimensions)
+    std::map<std::string, Dimensions_t> backend_var_sizes_;
+
+    /// \brief variables that every rank needs in their entirety for each frame
+    /// \details These are the variables used for the locations check, obs grouping and
+    /// the MPI distribution.
+    std::vector<std::string> frame_bcast_vars_;
+
+    /// \brief current frame number
+    std::size_t frame_num_;
+
+    /// \brief maximum number of frames read ahead by the prefetch thread
+    /// \details Zero disables the prefetch. When enabled, the io pool ranks read their
+    /// upcoming frames in a background thread while the current frame is being processed.
+    /// The thread owns all access to the backend while it is running.
+    std::size_t max_prefetch_frames_;
+
+    /// \brief background thread reading upcoming frames from the backend
+    std::thread prefetch_thread_;
+
+    /// \brief mutex protecting the prefetch queues and flags
+    std::mutex prefetch_mutex_;
+
+    /// \brief signals changes to the prefetch queues and flags
+    std::condition_variable prefetch_cond_;
+
+    /// \brief frames read by the prefetch thread, paired with their frame numbers
+    std::deque<std::pair<std::size_t, ObsGroup>> prefetch_ready_frames_;
+
+    /// \brief frame storage available to the prefetch thread
+    std::deque<ObsGroup> prefetch_free_frames_;
+
+    /// \brief tells the prefetch thread to quit
+    bool prefetch_stop_;
+
+    /// \brief exception caught in the prefetch thread, rethrown on the main thread
+    std::exception_ptr prefetch_error_;
+
     /// \brief true if the backend produces a different series of observations on each process,
     /// false if they are all the same
     bool each_process_reads_separate_obs_;
@@ -163,8 +228,78 @@ class ObsFrameRead : public ObsFrame, private util::ObjectCounter<ObsFrameRead>
     /// frame has moved past the end of some variables but not so for other
     /// variables. When the frame is past the end of the given variable, this
     /// routine returns a zero to indicate that we're done with this variable.
-    /// \param var variable
-    Dimensions_t basicFrameCount(const Variable & var);
+    /// \param varName name of backend variable
+    Dimensions_t basicFrameCount(const std::string & varName);
+
+    /// \brief return frame count for variable for the frame starting at frameStart
+    /// \param varName name of backend variable
+    /// \param frameStart start of the frame
+    Dimensions_t basicFrameCount(const std::string & varName, const Dimensions_t frameStart);
+
+    /// \brief share the structure of the obs source with the ranks outside the io pool
+    /// \details Rank 0 builds a replica of the backend structure (no variable data) in
+    /// an HDF5 in-memory file and broadcasts the file image. This function also collects
+    /// the backend variable and dimension information on all ranks.
+    void shareBackendStructure();
+
+    /// \brief create a replica of the backend structure in an HDF5 in-memory file
+    ObsGroup createBackendReplica();
+
+    /// \brief return the rank (in the obs space communicator group) reading the current frame
+    int frameReaderRank() const;
+
+    /// \brief read a frame from the backend
+    /// \param frame destination frame storage
+    /// \param frameStart start of the frame in the backend
+    void readFrameFromBackend(ObsGroup & frame, const Dimensions_t frameStart);
+
+    /// \brief start the prefetch thread for the frames read by this rank
+    /// \details The HDF5 library is not built thread-safe, so while the prefetch thread
+    /// is running it makes every call on the backend and the main thread must not make
+    /// any HDF5 calls. The main thread works on frames held in ObsStore memory and gets
+    /// the backend variable information from the lists cached in frameInit. Any new
+    /// access to obs_data_in_ or backend_obs_group_ has to go through the prefetch thread
+    /// or come after stopPrefetch.
+    void startPrefetch();
+
+    /// \brief stop and join the prefetch thread
+    void stopPrefetch();
+
+    /// \brief prefetch thread main loop
+    /// \param frameNums frame numbers to be read by this rank, in order
+    void prefetchFrames(const std::vector<std::size_t> & frameNums);
+
+    /// \brief make the prefetched frame frameNum the current frame (obs_frame_)
+    /// \param frameNum frame number
+    void takePrefetchedFrame(const std::size_t frameNum);
+
+    /// \brief broadcast the current frame of a variable from the rank that read the frame
+    /// \param varName variable name
+    /// \param frameCount size of the current frame for the variable
+    /// \param readerRank rank that read the current frame
+    void broadcastFrameVar(const std::string & varName, const Dimensions_t frameCount,
+                           const int readerRank);
+
+    /// \brief transfer the frame data to the ranks that kept locations from the frame
+    /// \param readerRank rank that read the current frame
+    void distributeFrame(const int readerRank);
+
+    /// \brief broadcast frame values from the rank that read the frame
+    /// \param values frame values, filled in on the ranks that did not read the frame
+    /// \param readerRank rank that read the current frame
+    template <typename DataType>
+    void broadcastFrameValues(std::vector<DataType> & values, const int readerRank);
+
+    /// \brief send rows (first dimension entries) of a frame variable to the ranks that
+    /// kept them, and receive the rows kept by this rank
+    /// \param frameVar frame variable
+    /// \param readerRank rank that read the current frame
+    /// \param rowCounts number of frame locations kept by each rank (reader rank only)
+    /// \param rowIndex frame locations kept by each rank concatenated (reader rank only)
+    template <typename DataType>
+    void transferFrameRows(Variable & frameVar, const int readerRank,
+                           const std::vector<int> & rowCounts,
+                           const std::vector<Dimensions_t> & rowIndex);
 
     /// \brief set up frontend and backend selection objects for the given variable
     /// \param varShape dimension sizes for variable being transferred
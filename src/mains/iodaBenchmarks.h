@@ -0,0 +1,685 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef MAINS_IODABENCHMARKS_H_
+#define MAINS_IODABENCHMARKS_H_
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/log/JSON.h"
+#include "eckit/mpi/Comm.h"
+
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Application.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+
+#include "ioda/core/MissingValueKernels.h"
+#include "ioda/distribution/Distribution.h"
+#include "ioda/distribution/DistributionFactory.h"
+#include "ioda/distribution/DistributionUtils.h"
+#include "ioda/Engines/HH.h"
+#include "ioda/ObsGroup.h"
+#include "ioda/ObsSpace.h"
+
+// This application times the main phases of ObsSpace file IO on synthetic inputs so that
+// performance can be tracked across versions. The input files are generated locally with
+// the HH (HDF5) writer at the sizes listed in the configuration, which avoids depending
+// on the downloaded test data. The phases timed are:
+//
+//   generate   - writing the synthetic input file
+//   construct  - ObsSpace construction from the synthetic file
+//   get_db     - reading every variable of a given type out of the ObsSpace
+//   put_db     - writing every variable of a given type into the ObsSpace
+//   save       - ObsSpace::save through the WriterPool for each of the listed pool sizes
+//   generator  - ObsSpace construction from the GenRandom and GenList engines
+//   odb        - ObsSpace save to, and construction from, an ODB file (optional)
+//   kernels    - the missing-value aware vector kernels used by ObsVector, compared with
+//                the equivalent branching loops (optional)
+//   reductions - the distributed dot product with the default and the reproducible
+//                summation (optional). Run with different task counts to compare them.
+//
+// Each phase is repeated and the fastest repetition is kept. The time of a repetition is
+// the maximum over the MPI tasks. Results are written as JSON to the "output file".
+//
+// Example configuration:
+//
+//   window begin: "2018-04-14T21:00:00Z"
+//   window end: "2018-04-15T03:00:00Z"
+//   benchmarks:
+//     output file: "testoutput/ioda_benchmarks.json"
+//     work directory: "testoutput"
+//     repetitions: 3
+//     pool sizes: [1, 2, 4]
+//     cases:
+//     - name: "radiance"
+//       locations: 100000
+//       channels: 22
+//       float variables: 1
+//       integer variables: 4
+//       string variables: 4
+//       string length: 24
+//     odb round trip:
+//       locations: 10000
+//       simulated variables: [airTemperature]
+//       mapping file: "testinput/odb_default_name_map.yaml"
+//       query file: "testinput/iodatest_odb_aircraft.yaml"
+//     vector kernels:
+//       sizes: [1000000, 10000000, 100000000]
+//       missing fraction: 0.05
+//     reductions:
+//       locations: [1000000, 10000000]
+//       variables: 4
+
+namespace ioda {
+
+class IodaBenchmarks : public oops::Application {
+ public:
+// -----------------------------------------------------------------------------
+  explicit IodaBenchmarks(const eckit::mpi::Comm & comm = oops::mpi::world())
+    : Application(comm) {}
+// -----------------------------------------------------------------------------
+  virtual ~IodaBenchmarks() {}
+// -----------------------------------------------------------------------------
+  int execute(const eckit::Configuration & fullConfig, bool /* validate */) const {
+    const util::DateTime winbgn(fullConfig.getString("window begin"));
+    const util::DateTime winend(fullConfig.getString("window end"));
+    const eckit::LocalConfiguration benchConfig(fullConfig, "benchmarks");
+
+    const std::string workDir = benchConfig.getString("work directory", ".");
+    const int numReps = benchConfig.getInt("repetitions", 3);
+    const std::vector<int> poolSizes = benchConfig.getIntVector("pool sizes", {1});
+
+    std::vector<Result> results;
+    for (const auto & caseConfig : benchConfig.getSubConfigurations("cases")) {
+      const BenchCase bcase(caseConfig);
+      const std::string inFile = workDir + "/ioda_benchmarks_" + bcase.name + ".nc4";
+      oops::Log::info() << "IodaBenchmarks: case " << bcase.name << ": " << bcase.numLocs
+                        << " locations, " << bcase.numChans << " channels" << std::endl;
+
+      // Only one task needs to write the input file.
+      addResult(results, bcase.name, "generate", "hdf5", timeIt(1, [&]() {
+        if (this->getComm().rank() == 0) generateFile(bcase, inFile, winbgn, winend);
+      }));
+
+      const eckit::LocalConfiguration obsConfig = caseObsConfig(bcase, inFile);
+      addResult(results, bcase.name, "construct", "hdf5", timeIt(numReps, [&]() {
+        ObsSpace obsdb(obsParams(obsConfig), this->getComm(), winbgn, winend,
+                       oops::mpi::myself());
+      }));
+
+      benchGetPut(results, bcase, obsConfig, winbgn, winend, numReps);
+
+      for (const int poolSize : poolSizes) {
+        eckit::LocalConfiguration saveConfig(obsConfig);
+        saveConfig.set("obsdataout.engine.type", "H5File");
+        saveConfig.set("obsdataout.engine.obsfile", workDir + "/ioda_benchmarks_" +
+                       bcase.name + "_out.nc4");
+        saveConfig.set("io pool.max pool size", poolSize);
+        addResult(results, bcase.name, "save", "pool size " + std::to_string(poolSize),
+                  timeSave(saveConfig, winbgn, winend, numReps));
+      }
+
+      addResult(results, bcase.name, "generator", "GenRandom", timeIt(numReps, [&]() {
+        ObsSpace obsdb(obsParams(generatorObsConfig(bcase, "GenRandom", winbgn, winend)),
+                       this->getComm(), winbgn, winend, oops::mpi::myself());
+      }));
+      addResult(results, bcase.name, "generator", "GenList", timeIt(numReps, [&]() {
+        ObsSpace obsdb(obsParams(generatorObsConfig(bcase, "GenList", winbgn, winend)),
+                       this->getComm(), winbgn, winend, oops::mpi::myself());
+      }));
+    }
+
+    if (benchConfig.has("odb round trip")) {
+      benchOdb(results, eckit::LocalConfiguration(benchConfig, "odb round trip"),
+               workDir, winbgn, winend, numReps);
+    }
+
+    if (benchConfig.has("vector kernels")) {
+      benchKernels(results, eckit::LocalConfiguration(benchConfig, "vector kernels"), numReps);
+    }
+
+    if (benchConfig.has("reductions")) {
+      benchReductions(results, eckit::LocalConfiguration(benchConfig, "reductions"), numReps);
+    }
+
+    if (this->getComm().rank() == 0) {
+      writeResults(benchConfig.getString("output file", "ioda_benchmarks.json"),
+                   benchConfig.getSubConfigurations("cases"), results);
+    }
+    return 0;
+  }
+
+// -----------------------------------------------------------------------------
+ private:
+  /// \brief sizes of one synthetic input file
+  struct BenchCase {
+    explicit BenchCase(const eckit::Configuration & conf)
+      : name(conf.getString("name")),
+        numLocs(conf.getInt("locations")),
+        numChans(conf.getInt("channels", 1)),
+        numFloatVars(conf.getInt("float variables", 1)),
+        numIntVars(conf.getInt("integer variables", 0)),
+        numStringVars(conf.getInt("string variables", 0)),
+        stringLength(conf.getInt("string length", 16)) {}
+
+    std::string name;
+    int numLocs;
+    int numChans;
+    int numFloatVars;
+    int numIntVars;
+    int numStringVars;
+    int stringLength;
+  };
+
+  struct Result {
+    std::string caseName;
+    std::string phase;
+    std::string variant;
+    double seconds;
+  };
+
+  std::string appname() const {
+    return "ioda::IodaBenchmarks";
+  }
+
+// -----------------------------------------------------------------------------
+  /// \brief run func numReps times and return the fastest time, where the time of one
+  ///        repetition is the maximum over the MPI tasks
+  template <typename Func>
+  double timeIt(const int numReps, Func func) const {
+    double best = -1.0;
+    for (int i = 0; i < numReps; ++i) {
+      this->getComm().barrier();
+      const auto start = std::chrono::steady_clock::now();
+      func();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      double maxElapsed;
+      this->getComm().allReduce(elapsed.count(), maxElapsed, eckit::mpi::max());
+      if ((best < 0.0) || (maxElapsed < best)) best = maxElapsed;
+    }
+    return best;
+  }
+
+// -----------------------------------------------------------------------------
+  void addResult(std::vector<Result> & results, const std::string & caseName,
+                 const std::string & phase, const std::string & variant,
+                 const double seconds) const {
+    oops::Log::info() << "IodaBenchmarks: " << caseName << " " << phase << " (" << variant
+                      << "): " << seconds << " s" << std::endl;
+    results.push_back(Result{caseName, phase, variant, seconds});
+  }
+
+// -----------------------------------------------------------------------------
+  static ObsTopLevelParameters obsParams(const eckit::Configuration & obsConfig) {
+    ObsTopLevelParameters params;
+    params.validateAndDeserialize(obsConfig);
+    return params;
+  }
+
+// -----------------------------------------------------------------------------
+  static std::string floatVarName(const int i) { return "var" + std::to_string(i); }
+  static std::string intVarName(const int i) { return "intVar" + std::to_string(i); }
+  static std::string stringVarName(const int i) { return "stringVar" + std::to_string(i); }
+
+// -----------------------------------------------------------------------------
+  static eckit::LocalConfiguration caseObsConfig(const BenchCase & bcase,
+                                                 const std::string & inFile) {
+    std::vector<std::string> simVars;
+    for (int i = 0; i < bcase.numFloatVars; ++i) simVars.push_back(floatVarName(i));
+
+    eckit::LocalConfiguration obsConfig;
+    obsConfig.set("name", bcase.name);
+    obsConfig.set("simulated variables", simVars);
+    if (bcase.numChans > 1) obsConfig.set("channels", "1-" + std::to_string(bcase.numChans));
+    obsConfig.set("obsdatain.engine.type", "H5File");
+    obsConfig.set("obsdatain.engine.obsfile", inFile);
+    return obsConfig;
+  }
+
+// -----------------------------------------------------------------------------
+  static eckit::LocalConfiguration generatorObsConfig(const BenchCase & bcase,
+                                                      const std::string & engineType,
+                                                      const util::DateTime & winbgn,
+                                                      const util::DateTime & winend) {
+    std::vector<std::string> simVars;
+    for (int i = 0; i < bcase.numFloatVars; ++i) simVars.push_back(floatVarName(i));
+
+    eckit::LocalConfiguration obsConfig;
+    obsConfig.set("name", bcase.name);
+    obsConfig.set("simulated variables", simVars);
+    obsConfig.set("obsdatain.engine.type", engineType);
+    obsConfig.set("obsdatain.engine.obs errors", std::vector<float>(simVars.size(), 1.0));
+    if (engineType == "GenRandom") {
+      obsConfig.set("obsdatain.engine.nobs", bcase.numLocs);
+      obsConfig.set("obsdatain.engine.lat1", -90.0);
+      obsConfig.set("obsdatain.engine.lat2", 90.0);
+      obsConfig.set("obsdatain.engine.lon1", 0.0);
+      obsConfig.set("obsdatain.engine.lon2", 360.0);
+      obsConfig.set("obsdatain.engine.random seed", 29837);
+    } else {
+      // Spread the locations evenly through the window, avoiding the window start which
+      // is outside the window.
+      const int64_t windowLength = (winend - winbgn).toSeconds();
+      std::vector<float> lats(bcase.numLocs);
+      std::vector<float> lons(bcase.numLocs);
+      std::vector<int64_t> dateTimes(bcase.numLocs);
+      for (int i = 0; i < bcase.numLocs; ++i) {
+        lats[i] = -90.0f + 180.0f * static_cast<float>(i) / bcase.numLocs;
+        lons[i] = 360.0f * static_cast<float>(i) / bcase.numLocs;
+        dateTimes[i] = 1 + (windowLength - 1) * i / bcase.numLocs;
+      }
+      obsConfig.set("obsdatain.engine.lats", lats);
+      obsConfig.set("obsdatain.engine.lons", lons);
+      obsConfig.set("obsdatain.engine.dateTimes", dateTimes);
+      obsConfig.set("obsdatain.engine.epoch", "seconds since " + winbgn.toString());
+    }
+    return obsConfig;
+  }
+
+// -----------------------------------------------------------------------------
+  /// \brief write a synthetic ioda file with the HH backend
+  static void generateFile(const BenchCase & bcase, const std::string & fileName,
+                           const util::DateTime & winbgn, const util::DateTime & winend) {
+    const Dimensions_t numLocs = bcase.numLocs;
+    const Dimensions_t numChans = bcase.numChans;
+    Group backend = Engines::HH::createFile(fileName,
+                                            Engines::BackendCreateModes::Truncate_If_Exists);
+    NewDimensionScales_t newDims;
+    newDims.push_back(NewDimensionScale<int>("Location", numLocs, numLocs, numLocs));
+    if (numChans > 1) {
+      newDims.push_back(NewDimensionScale<int>("Channel", numChans, numChans, numChans));
+    }
+    ObsGroup og = ObsGroup::generate(backend, newDims);
+
+    std::vector<int> locs(numLocs);
+    std::iota(locs.begin(), locs.end(), 1);
+    og.vars.open("Location").write<int>(locs);
+    std::vector<Variable> obsDims{og.vars.open("Location")};
+    if (numChans > 1) {
+      std::vector<int> chans(numChans);
+      std::iota(chans.begin(), chans.end(), 1);
+      og.vars.open("Channel").write<int>(chans);
+      obsDims.push_back(og.vars.open("Channel"));
+    }
+
+    VariableCreationParameters params;
+    params.chunk = true;
+    params.compressWithGZIP();
+    VariableCreationParameters floatParams = params;
+    floatParams.setFillValue<float>(-999);
+    VariableCreationParameters intParams = params;
+    intParams.setFillValue<int>(-999);
+    VariableCreationParameters int64Params = params;
+    int64Params.setFillValue<int64_t>(-999);
+    VariableCreationParameters stringParams = params;
+    stringParams.setFillValue<std::string>("");
+
+    std::mt19937 gen(29837);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+    std::vector<float> lats(numLocs);
+    std::vector<float> lons(numLocs);
+    std::vector<int64_t> dateTimes(numLocs);
+    const int64_t windowLength = (winend - winbgn).toSeconds();
+    for (Dimensions_t i = 0; i < numLocs; ++i) {
+      lats[i] = -90.0f + 180.0f * uniform(gen);
+      lons[i] = 360.0f * uniform(gen);
+      // The window start is outside the window, so offset the times by at least 1 second.
+      dateTimes[i] = 1 + static_cast<int64_t>((windowLength - 1) * uniform(gen));
+    }
+    og.vars.createWithScales<float>("MetaData/latitude", {obsDims[0]}, floatParams)
+      .write<float>(lats).atts.add<std::string>("units", std::string("degrees_north"));
+    og.vars.createWithScales<float>("MetaData/longitude", {obsDims[0]}, floatParams)
+      .write<float>(lons).atts.add<std::string>("units", std::string("degrees_east"));
+    og.vars.createWithScales<int64_t>("MetaData/dateTime", {obsDims[0]}, int64Params)
+      .write<int64_t>(dateTimes)
+      .atts.add<std::string>("units", std::string("seconds since ") + winbgn.toString());
+
+    const std::size_t numObsValues = numLocs * numChans;
+    std::vector<float> obsValues(numObsValues);
+    std::vector<float> obsErrors(numObsValues);
+    std::vector<int> preQcs(numObsValues);
+    for (int ivar = 0; ivar < bcase.numFloatVars; ++ivar) {
+      for (std::size_t i = 0; i < numObsValues; ++i) {
+        obsValues[i] = 200.0f + 100.0f * uniform(gen);
+        obsErrors[i] = 0.5f + uniform(gen);
+        preQcs[i] = static_cast<int>(4.0f * uniform(gen));
+      }
+      const std::string varName = floatVarName(ivar);
+      og.vars.createWithScales<float>("ObsValue/" + varName, obsDims, floatParams)
+        .write<float>(obsValues);
+      og.vars.createWithScales<float>("ObsError/" + varName, obsDims, floatParams)
+        .write<float>(obsErrors);
+      og.vars.createWithScales<int>("PreQC/" + varName, obsDims, intParams)
+        .write<int>(preQcs);
+    }
+
+    std::vector<int> intValues(numLocs);
+    for (int ivar = 0; ivar < bcase.numIntVars; ++ivar) {
+      for (Dimensions_t i = 0; i < numLocs; ++i) {
+        intValues[i] = static_cast<int>(1000.0f * uniform(gen));
+      }
+      og.vars.createWithScales<int>("MetaData/" + intVarName(ivar), {obsDims[0]}, intParams)
+        .write<int>(intValues);
+    }
+
+    // String metadata such as station identifiers, with varying lengths up to the
+    // requested string length.
+    std::vector<std::string> stringValues(numLocs);
+    for (int ivar = 0; ivar < bcase.numStringVars; ++ivar) {
+      for (Dimensions_t i = 0; i < numLocs; ++i) {
+        const int len = 1 + static_cast<int>((bcase.stringLength - 1) * uniform(gen));
+        stringValues[i].resize(len);
+        for (int j = 0; j < len; ++j) {
+          stringValues[i][j] = static_cast<char>('A' + static_cast<int>(25.0f * uniform(gen)));
+        }
+      }
+      og.vars.createWithScales<std::string>("MetaData/" + stringVarName(ivar), {obsDims[0]},
+                                            stringParams)
+        .write<std::string>(stringValues);
+    }
+  }
+
+// -----------------------------------------------------------------------------
+  template <typename DataType>
+  void benchGetPutType(std::vector<Result> & results, ObsSpace & obsdb,
+                       const std::string & caseName, const std::string & typeName,
+                       const std::vector<std::pair<std::string, std::string>> & vars,
+                       const std::vector<std::string> & dimList, const int numReps) const {
+    if (vars.empty()) return;
+    std::vector<std::vector<DataType>> values(vars.size());
+    addResult(results, caseName, "get_db", typeName, timeIt(numReps, [&]() {
+      for (std::size_t i = 0; i < vars.size(); ++i) {
+        obsdb.get_db(vars[i].first, vars[i].second, values[i]);
+      }
+    }));
+    addResult(results, caseName, "put_db", typeName, timeIt(numReps, [&]() {
+      for (std::size_t i = 0; i < vars.size(); ++i) {
+        obsdb.put_db("Benchmark" + vars[i].first, vars[i].second, values[i], dimList);
+      }
+    }));
+  }
+
+// -----------------------------------------------------------------------------
+  void benchGetPut(std::vector<Result> & results, const BenchCase & bcase,
+                   const eckit::Configuration & obsConfig, const util::DateTime & winbgn,
+                   const util::DateTime & winend, const int numReps) const {
+    ObsSpace obsdb(obsParams(obsConfig), this->getComm(), winbgn, winend, oops::mpi::myself());
+
+    std::vector<std::string> obsDimList{"Location"};
+    if (bcase.numChans > 1) obsDimList.push_back("Channel");
+
+    std::vector<std::pair<std::string, std::string>> floatVars;
+    std::vector<std::pair<std::string, std::string>> intVars;
+    std::vector<std::pair<std::string, std::string>> stringVars;
+    for (int i = 0; i < bcase.numFloatVars; ++i) {
+      floatVars.emplace_back("ObsValue", floatVarName(i));
+      floatVars.emplace_back("ObsError", floatVarName(i));
+    }
+    for (int i = 0; i < bcase.numIntVars; ++i) intVars.emplace_back("MetaData", intVarName(i));
+    for (int i = 0; i < bcase.numStringVars; ++i) {
+      stringVars.emplace_back("MetaData", stringVarName(i));
+    }
+    const std::vector<std::pair<std::string, std::string>> dateTimeVars{
+      {"MetaData", "dateTime"}};
+
+    benchGetPutType<float>(results, obsdb, bcase.name, "float", floatVars, obsDimList,
+                           numReps);
+    benchGetPutType<int>(results, obsdb, bcase.name, "int", intVars, {"Location"}, numReps);
+    benchGetPutType<std::string>(results, obsdb, bcase.name, "string", stringVars,
+                                 {"Location"}, numReps);
+    benchGetPutType<util::DateTime>(results, obsdb, bcase.name, "datetime", dateTimeVars,
+                                    {"Location"}, numReps);
+  }
+
+// -----------------------------------------------------------------------------
+  /// \brief time ObsSpace::save only, the construction is not included
+  double timeSave(const eckit::Configuration & obsConfig, const util::DateTime & winbgn,
+                  const util::DateTime & winend, const int numReps) const {
+    const ObsTopLevelParameters params = obsParams(obsConfig);
+    double best = -1.0;
+    for (int i = 0; i < numReps; ++i) {
+      ObsSpace obsdb(params, this->getComm(), winbgn, winend, oops::mpi::myself());
+      const double seconds = timeIt(1, [&]() { obsdb.save(); });
+      if ((best < 0.0) || (seconds < best)) best = seconds;
+    }
+    return best;
+  }
+
+// -----------------------------------------------------------------------------
+  void benchOdb(std::vector<Result> & results, const eckit::Configuration & odbConfig,
+                const std::string & workDir, const util::DateTime & winbgn,
+                const util::DateTime & winend, const int numReps) const {
+    const std::vector<std::string> simVars = odbConfig.getStringVector("simulated variables");
+    const std::string odbFile = workDir + "/ioda_benchmarks.odb";
+
+    eckit::LocalConfiguration caseConfig;
+    caseConfig.set("name", "odb");
+    caseConfig.set("locations", odbConfig.getInt("locations"));
+    BenchCase bcase(caseConfig);
+    bcase.numFloatVars = 0;
+
+    eckit::LocalConfiguration writeConfig = generatorObsConfig(bcase, "GenRandom", winbgn,
+                                                               winend);
+    writeConfig.set("simulated variables", simVars);
+    writeConfig.set("obsdatain.engine.obs errors", std::vector<float>(simVars.size(), 1.0));
+    writeConfig.set("obsdataout.engine.type", "ODB");
+    writeConfig.set("obsdataout.engine.obsfile", odbFile);
+    writeConfig.set("obsdataout.engine.mapping file", odbConfig.getString("mapping file"));
+    addResult(results, "odb", "save", "odb", timeSave(writeConfig, winbgn, winend, numReps));
+
+    eckit::LocalConfiguration readConfig;
+    readConfig.set("name", "odb");
+    readConfig.set("simulated variables", simVars);
+    readConfig.set("obsdatain.engine.type", "ODB");
+    readConfig.set("obsdatain.engine.obsfile", odbFile);
+    readConfig.set("obsdatain.engine.mapping file", odbConfig.getString("mapping file"));
+    readConfig.set("obsdatain.engine.query file", odbConfig.getString("query file"));
+    addResult(results, "odb", "construct", "odb", timeIt(numReps, [&]() {
+      ObsSpace obsdb(obsParams(readConfig), this->getComm(), winbgn, winend,
+                     oops::mpi::myself());
+    }));
+  }
+
+// -----------------------------------------------------------------------------
+  /// \brief time the missing-value aware kernels against the branching loops they replaced
+  ///
+  /// The variant names the vector size and whether the kernel ("vectorised") or the
+  /// branching loop ("branching") was timed.
+  void benchKernels(std::vector<Result> & results, const eckit::Configuration & kernelConfig,
+                    const int numReps) const {
+    const double missing = util::missingValue(missing);
+    const double missingFraction = kernelConfig.getDouble("missing fraction", 0.05);
+    for (const long size : kernelConfig.getLongVector("sizes", {1000000})) {
+      std::mt19937 gen(29837);
+      std::uniform_real_distribution<double> uniform(0.0, 1.0);
+      std::vector<double> x0(size);
+      std::vector<double> y(size);
+      for (long i = 0; i < size; ++i) {
+        x0[i] = (uniform(gen) < missingFraction) ? missing : 0.5 + uniform(gen);
+        y[i] = (uniform(gen) < missingFraction) ? missing : 0.5 + uniform(gen);
+      }
+      std::vector<double> x(x0);
+      const gsl::span<double> xs = gsl::make_span(x);
+      const gsl::span<const double> ys = gsl::make_span(y);
+      const std::string sizeName = "size " + std::to_string(size);
+
+      // Each repetition starts again from x0 so that the timed loops see the same inputs.
+      auto timeKernel = [&](const std::string & phase, const std::string & variant,
+                            const std::function<void()> & func) {
+        double best = -1.0;
+        for (int i = 0; i < numReps; ++i) {
+          std::copy(x0.begin(), x0.end(), x.begin());
+          const double seconds = timeIt(1, func);
+          if ((best < 0.0) || (seconds < best)) best = seconds;
+        }
+        addResult(results, "kernels", phase, sizeName + " " + variant, best);
+      };
+
+      timeKernel("add", "vectorised", [&]() { missingAwareAdd<double>(xs, ys, missing); });
+      timeKernel("add", "branching", [&]() {
+        for (long i = 0; i < size; ++i) {
+          if (x[i] == missing || y[i] == missing) {
+            x[i] = missing;
+          } else {
+            x[i] += y[i];
+          }
+        }
+      });
+      timeKernel("multiply", "vectorised",
+                 [&]() { missingAwareMultiply<double>(xs, ys, missing); });
+      timeKernel("multiply", "branching", [&]() {
+        for (long i = 0; i < size; ++i) {
+          if (x[i] == missing || y[i] == missing) {
+            x[i] = missing;
+          } else {
+            x[i] *= y[i];
+          }
+        }
+      });
+      timeKernel("divide", "vectorised",
+                 [&]() { missingAwareDivide<double>(xs, ys, missing); });
+      timeKernel("divide", "branching", [&]() {
+        for (long i = 0; i < size; ++i) {
+          if (x[i] == missing || y[i] == missing) {
+            x[i] = missing;
+          } else {
+            x[i] /= y[i];
+          }
+        }
+      });
+      timeKernel("axpy", "vectorised",
+                 [&]() { missingAwareAxpy<double>(xs, 0.5, ys, missing); });
+      timeKernel("axpy", "branching", [&]() {
+        for (long i = 0; i < size; ++i) {
+          if (x[i] == missing || y[i] == missing) {
+            x[i] = missing;
+          } else {
+            x[i] += 0.5 * y[i];
+          }
+        }
+      });
+      timeKernel("mask", "vectorised", [&]() { missingAwareMask<double>(xs, ys, missing); });
+      timeKernel("mask", "branching", [&]() {
+        for (long i = 0; i < size; ++i) {
+          if (y[i] == missing) x[i] = missing;
+        }
+      });
+    }
+  }
+
+// -----------------------------------------------------------------------------
+  /// \brief time the dot product over a RoundRobin distribution with the default and the
+  ///        reproducible summation
+  ///
+  /// The locations are spread over the tasks, so each task holds about locations / ranks of
+  /// them. The reproducible results are logged so that runs with different task counts can be
+  /// checked for bitwise agreement.
+  void benchReductions(std::vector<Result> & results, const eckit::Configuration & reduceConfig,
+                       const int numReps) const {
+    const std::size_t numVars = reduceConfig.getInt("variables", 1);
+    eckit::LocalConfiguration distConfig;
+    distConfig.set("name", "RoundRobin");
+    DistributionParametersWrapper distParams;
+    distParams.validateAndDeserialize(distConfig);
+
+    for (const long numLocs : reduceConfig.getLongVector("locations", {1000000})) {
+      std::unique_ptr<Distribution> dist =
+        DistributionFactory::create(this->getComm(), distParams.params);
+      std::vector<std::size_t> myLocs;
+      for (long i = 0; i < numLocs; ++i) {
+        dist->assignRecord(i, i, eckit::geometry::Point2(0.0, 0.0));
+        if (dist->isMyRecord(i)) myLocs.push_back(i);
+      }
+      dist->computePatchLocs();
+
+      // The values depend only on the global location, so every task count sums the same
+      // terms.
+      std::vector<double> v1(myLocs.size() * numVars);
+      std::vector<double> v2(myLocs.size() * numVars);
+      for (std::size_t i = 0; i < myLocs.size(); ++i) {
+        std::mt19937 gen(myLocs[i]);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        for (std::size_t j = 0; j < numVars; ++j) {
+          v1[i * numVars + j] = std::ldexp(uniform(gen), static_cast<int>(40 * uniform(gen)));
+          v2[i * numVars + j] = uniform(gen);
+        }
+      }
+
+      const std::string locsName = std::to_string(numLocs) + " locations";
+      double fastResult = 0.0;
+      double reproResult = 0.0;
+      addResult(results, "reductions", "dot product", locsName + " default",
+                timeIt(numReps, [&]() { fastResult = dotProduct(*dist, numVars, v1, v2); }));
+      addResult(results, "reductions", "dot product", locsName + " reproducible",
+                timeIt(numReps, [&]() {
+                  reproResult = dotProduct(*dist, numVars, v1, v2, true);
+                }));
+      oops::Log::info() << "IodaBenchmarks: " << locsName << " on " << this->getComm().size()
+                        << " tasks: default dot product " << std::setprecision(17)
+                        << fastResult << ", reproducible dot product " << reproResult
+                        << std::endl;
+    }
+  }
+
+// -----------------------------------------------------------------------------
+  void writeResults(const std::string & fileName,
+                    const std::vector<eckit::LocalConfiguration> & caseConfigs,
+                    const std::vector<Result> & results) const {
+    std::ofstream out(fileName);
+    eckit::JSON json(out);
+    json.startObject();
+    json << "ranks" << static_cast<long>(this->getComm().size());
+    json << "cases";
+    json.startList();
+    for (const auto & caseConfig : caseConfigs) {
+      const BenchCase bcase(caseConfig);
+      json.startObject();
+      json << "name" << bcase.name;
+      json << "locations" << bcase.numLocs;
+      json << "channels" << bcase.numChans;
+      json << "float variables" << bcase.numFloatVars;
+      json << "integer variables" << bcase.numIntVars;
+      json << "string variables" << bcase.numStringVars;
+      json << "string length" << bcase.stringLength;
+      json.endObject();
+    }
+    json.endList();
+    json << "results";
+    json.startList();
+    for (const auto & result : results) {
+      json.startObject();
+      json << "case" << result.caseName;
+      json << "phase" << result.phase;
+      json << "variant" << result.variant;
+      json << "seconds" << result.seconds;
+      json.endObject();
+    }
+    json.endList();
+    json.endObject();
+    out << std::endl;
+    oops::Log::info() << "IodaBenchmarks: results written to " << fileName << std::endl;
+  }
+// -----------------------------------------------------------------------------
+};
+
+}  // namespace ioda
+
+#endif  // MAINS_IODABENCHMARKS_H_
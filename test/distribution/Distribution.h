@@ -17,6 +17,7 @@
 #include <numeric>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define ECKIT_TESTING_SELF_REGISTER_CASES 0
@@ -125,6 +126,20 @@ void testDistribution(const eckit::Configuration &config,
   EXPECT_EQUAL(Recnums, ExpectedRecnums);
   EXPECT_EQUAL(PatchLocsThisPE, ExpectedPatchIndex);
 
+  // The runs of patch locations should cover exactly the locations flagged by patchObs()
+  std::vector<std::pair<std::size_t, std::size_t>> patchRuns;
+  TestDist->patchObsRuns(Index.size(), patchRuns);
+  std::vector<bool> patchBoolFromRuns(Index.size(), false);
+  std::size_t runEnd = 0;
+  for (const auto & run : patchRuns) {
+    EXPECT(run.second > 0);
+    EXPECT(run.first >= runEnd);
+    runEnd = run.first + run.second;
+    EXPECT(runEnd <= Index.size());
+    std::fill(patchBoolFromRuns.begin() + run.first, patchBoolFromRuns.begin() + runEnd, true);
+  }
+  EXPECT(patchBoolFromRuns == patchBool);
+
   // Test overloads of the allGatherv() method. We will pass to it vectors derived from the
   // Index vector and compare the results against vectors derived from ExpectedAllGatherv.
 
@@ -9,6 +9,7 @@
 #define TEST_DISTRIBUTION_DISTRIBUTIONMETHODS_H_
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <string>
@@ -28,6 +29,7 @@
 #include "ioda/distribution/Accumulator.h"
 #include "ioda/distribution/Distribution.h"
 #include "ioda/distribution/DistributionFactory.h"
+#include "ioda/distribution/DistributionUtils.h"
 
 namespace ioda {
 namespace test {
@@ -164,6 +166,30 @@ void testMinVector(const Distribution &TestDist, const std::vector<size_t> &myRe
   EXPECT_EQUAL(mins, expectedMins);
 }
 
+// The first location holds a large value cancelled by the last one, and the other locations
+// hold ones that a naive summation would lose against the large value.
+void testReproducibleDotProduct(const Distribution &TestDist,
+                                const std::vector<size_t> &myRecords, size_t nprocs) {
+  const double big = std::ldexp(1.0, 70);
+  std::vector<double> values;
+  for (const size_t rec : myRecords) {
+    if (rec == 0)
+      values.push_back(big);
+    else if (rec == nprocs - 1)
+      values.push_back(-big);
+    else
+      values.push_back(1.0);
+  }
+  const std::vector<double> ones(values.size(), 1.0);
+  const double expected = (nprocs == 1) ? big : static_cast<double>(nprocs - 2);
+
+  EXPECT_EQUAL(dotProduct(TestDist, 1, values, ones, true), expected);
+  // The result must not depend on the order in which the locations are visited.
+  std::vector<double> reversed(values.rbegin(), values.rend());
+  if (TestDist.isNonoverlapping() || TestDist.isIdentity())
+    EXPECT_EQUAL(dotProduct(TestDist, 1, reversed, ones, true), expected);
+}
+
 void testDistributionMethods() {
   eckit::LocalConfiguration conf(::test::TestEnvironment::config());
 
@@ -235,6 +261,8 @@ void testDistributionMethods() {
     testMinVector<float>(*TestDist, myRecords, expectedMin);
     testMinVector<int>(*TestDist, myRecords, expectedMin);
     testMinVector<size_t>(*TestDist, myRecords, expectedMin);
+
+    testReproducibleDotProduct(*TestDist, myRecords, nprocs);
   }
 }
 
@@ -0,0 +1,239 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_IODA_MISSINGVALUEKERNELS_H_
+#define TEST_IODA_MISSINGVALUEKERNELS_H_
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "oops/runs/Test.h"
+#include "oops/test/TestEnvironment.h"
+#include "oops/util/Logger.h"
+#include "oops/util/missingValues.h"
+
+#include "ioda/core/MissingValueKernels.h"
+
+namespace ioda {
+namespace test {
+
+// -----------------------------------------------------------------------------
+// Input vectors. Each element of x and y is one of: missing, NaN, +Inf, -Inf, zero or a
+// regular value, and the first 36 elements cover every pair of these.
+
+template <typename T>
+T kernelTestValue(const std::size_t kind, const T regular) {
+  switch (kind % 6) {
+    case 0: return util::missingValue(regular);
+    case 1: return std::numeric_limits<T>::quiet_NaN();
+    case 2: return std::numeric_limits<T>::infinity();
+    case 3: return -std::numeric_limits<T>::infinity();
+    case 4: return T(0);
+    default: return regular;
+  }
+}
+
+template <typename T>
+std::vector<T> kernelTestX(const std::size_t n) {
+  std::vector<T> x(n);
+  for (std::size_t i = 0; i < n; ++i) x[i] = kernelTestValue<T>(i, T(1.5) + T(0.25) * i);
+  return x;
+}
+
+template <typename T>
+std::vector<T> kernelTestY(const std::size_t n) {
+  std::vector<T> y(n);
+  for (std::size_t i = 0; i < n; ++i) y[i] = kernelTestValue<T>(i / 6, T(-0.75) + T(0.5) * i);
+  return y;
+}
+
+/// The kernels and the branching loops may round differently when the compiler contracts
+/// a multiply and an add, so regular values are compared with a relative tolerance.
+template <typename T>
+bool sameKernelValue(const T a, const T b) {
+  if (std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+  if (!std::isfinite(a) || !std::isfinite(b) || a == b) return a == b;
+  return std::abs(a - b) <= 4 * std::numeric_limits<T>::epsilon() * std::abs(b);
+}
+
+template <typename T>
+void expectSameKernelValues(const std::vector<T> & actual, const std::vector<T> & expected) {
+  EXPECT_EQUAL(actual.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    if (!sameKernelValue(actual[i], expected[i])) {
+      oops::Log::error() << "Element " << i << ": " << actual[i] << " != " << expected[i]
+                         << std::endl;
+    }
+    EXPECT(sameKernelValue(actual[i], expected[i]));
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The branching loops that ObsVector used before the kernels.
+
+template <typename T, typename Op>
+void branchingBinaryOp(std::vector<T> & x, const std::vector<T> & y, const T missing,
+                       const Op & op) {
+  for (std::size_t jj = 0; jj < x.size(); ++jj) {
+    if (x[jj] == missing || y[jj] == missing) {
+      x[jj] = missing;
+    } else {
+      x[jj] = op(x[jj], y[jj]);
+    }
+  }
+}
+
+template <typename T>
+void branchingScale(std::vector<T> & x, const T a, const T missing) {
+  for (std::size_t jj = 0; jj < x.size(); ++jj) {
+    if (x[jj] != missing) x[jj] = a * x[jj];
+  }
+}
+
+template <typename T>
+void branchingAxpy(std::vector<T> & x, const std::vector<T> & a, const std::vector<T> & y,
+                   const T missing) {
+  const std::size_t nvars = a.size();
+  std::size_t ivec = 0;
+  for (std::size_t jloc = 0; jloc < x.size() / nvars; ++jloc) {
+    for (std::size_t jvar = 0; jvar < nvars; ++jvar, ++ivec) {
+      if (x[ivec] == missing || y[ivec] == missing) {
+        x[ivec] = missing;
+      } else {
+        x[ivec] += a[jvar] * y[ivec];
+      }
+    }
+  }
+}
+
+template <typename T>
+void branchingInvert(std::vector<T> & x, const T missing) {
+  for (std::size_t jj = 0; jj < x.size(); ++jj) {
+    if (x[jj] != missing) x[jj] = T(1) / x[jj];
+  }
+}
+
+template <typename T>
+void branchingMask(std::vector<T> & x, const std::vector<T> & mask, const T missing) {
+  for (std::size_t jj = 0; jj < x.size(); ++jj) {
+    if (mask[jj] == missing) x[jj] = missing;
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void testKernels(const std::size_t n, const std::vector<std::size_t> & nvarsList) {
+  const T missing = util::missingValue(missing);
+  const std::vector<T> x0 = kernelTestX<T>(n);
+  const std::vector<T> y = kernelTestY<T>(n);
+  const gsl::span<const T> ySpan(y.data(), y.size());
+  const T a = T(-2.5);
+
+  {
+    std::vector<T> x = x0, expected = x0;
+    missingAwareAdd<T>(gsl::make_span(x), ySpan, missing);
+    branchingBinaryOp(expected, y, missing, [](T u, T v) { return u + v; });
+    expectSameKernelValues(x, expected);
+  }
+  {
+    std::vector<T> x = x0, expected = x0;
+    missingAwareSubtract<T>(gsl::make_span(x), ySpan, missing);
+    branchingBinaryOp(expected, y, missing, [](T u, T v) { return u - v; });
+    expectSameKernelValues(x, expected);
+  }
+  {
+    std::vector<T> x = x0, expected = x0;
+    missingAwareMultiply<T>(gsl::make_span(x), ySpan, missing);
+    branchingBinaryOp(expected, y, missing, [](T u, T v) { return u * v; });
+    expectSameKernelValues(x, expected);
+  }
+  {
+    std::vector<T> x = x0, expected = x0;
+    missingAwareDivide<T>(gsl::make_span(x), ySpan, missing);
+    branchingBinaryOp(expected, y, missing, [](T u, T v) { return u / v; });
+    expectSameKernelValues(x, expected);
+  }
+  {
+    std::vector<T> x = x0, expected = x0;
+    missingAwareScale<T>(gsl::make_span(x), a, missing);
+    branchingScale(expected, a, missing);
+    expectSameKernelValues(x, expected);
+  }
+  {
+    std::vector<T> x = x0, expected = x0;
+    missingAwareAxpy<T>(gsl::make_span(x), a, ySpan, missing);
+    branchingAxpy(expected, std::vector<T>{a}, y, missing);
+    expectSameKernelValues(x, expected);
+  }
+  for (const std::size_t nvars : nvarsList) {
+    // Interleaved variables, each with its own coefficient
+    const std::vector<T> x1 = kernelTestX<T>(n * nvars);
+    const std::vector<T> y1 = kernelTestY<T>(n * nvars);
+    std::vector<T> coefs(nvars);
+    for (std::size_t jvar = 0; jvar < nvars; ++jvar) coefs[jvar] = T(0.5) - T(jvar);
+    std::vector<T> x = x1, expected = x1;
+    missingAwareAxpy<T>(gsl::make_span(x), gsl::make_span(coefs),
+                        gsl::make_span(y1.data(), y1.size()), missing);
+    branchingAxpy(expected, coefs, y1, missing);
+    expectSameKernelValues(x, expected);
+  }
+  {
+    std::vector<T> x = x0, expected = x0;
+    missingAwareInvert<T>(gsl::make_span(x), missing);
+    branchingInvert(expected, missing);
+    expectSameKernelValues(x, expected);
+  }
+  {
+    std::vector<T> x = x0, expected = x0;
+    missingAwareMask<T>(gsl::make_span(x), ySpan, missing);
+    branchingMask(expected, y, missing);
+    expectSameKernelValues(x, expected);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void testMissingValueKernels(const eckit::LocalConfiguration & conf) {
+  const std::vector<int> nvarsConf = conf.getIntVector("variables per location");
+  const std::vector<std::size_t> nvarsList(nvarsConf.begin(), nvarsConf.end());
+  for (const int n : conf.getIntVector("vector lengths")) {
+    oops::Log::info() << "Vector length: " << n << std::endl;
+    testKernels<float>(n, nvarsList);
+    testKernels<double>(n, nvarsList);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class MissingValueKernels : public oops::Test {
+ private:
+  std::string testid() const override {return "ioda::test::MissingValueKernels";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ioda/MissingValueKernels/testMissingValueKernels")
+      { testMissingValueKernels(::test::TestEnvironment::config()); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ioda
+
+#endif  // TEST_IODA_MISSINGVALUEKERNELS_H_
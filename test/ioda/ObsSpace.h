@@ -536,6 +536,30 @@ void testPutGetChanSelect() {
       Odb->get_db(TestGroupName, VarName, TestVec, Channels);
 
       EXPECT(TestVec == OrigVec);
+
+      // The span overloads should give the same values.
+      std::vector<float> SpanVec(Nlocs);
+      Odb->get_db(TestGroupName, VarName, gsl::make_span(SpanVec), Channels);
+      EXPECT(SpanVec == OrigVec);
+
+      // Transfer the channel through one column of a (Location x Channel) buffer.
+      if (!Channels.empty()) {
+        const std::size_t Stride = 3;
+        std::vector<float> Buffer(Nlocs * Stride, 0.0f);
+        Odb->get_db(TestGroupName, VarName, Channels[0],
+                    ioda::StridedSpan<float>(gsl::make_span(Buffer), 1, Stride));
+        for (std::size_t iloc = 0; iloc < Nlocs; ++iloc) {
+          EXPECT(Buffer[iloc * Stride + 1] == OrigVec[iloc]);
+          EXPECT(Buffer[iloc * Stride] == 0.0f);
+        }
+
+        const std::string StridedGroupName = GroupName + "_StridedTest";
+        Odb->put_db(StridedGroupName, VarName, Channels[0],
+                    ioda::StridedSpan<const float>(gsl::make_span(Buffer), 1, Stride));
+        std::vector<float> StridedVec(Nlocs);
+        Odb->get_db(StridedGroupName, VarName, StridedVec, Channels);
+        EXPECT(StridedVec == OrigVec);
+      }
     }
   }
 }
@@ -591,6 +615,47 @@ void testWriteableGroup() {
 
 // -----------------------------------------------------------------------------
 
+void testRemoveRecreateVar() {
+  typedef ObsSpaceTestFixture Test_;
+
+  const std::string GroupName("TestGroup");
+  const std::string VarName("RemovedVar");
+
+  for (std::size_t jj = 0; jj < Test_::size(); ++jj) {
+    ioda::ObsSpace * Odb = &(Test_::obspace(jj));
+    const std::size_t Nlocs = Odb->nlocs();
+
+    // Create a float variable and look it up, which caches its handle
+    std::vector<float> FloatVec(Nlocs);
+    for (std::size_t i = 0; i < Nlocs; ++i) {
+      FloatVec[i] = static_cast<float>(i) + 0.5f;
+    }
+    Odb->put_db(GroupName, VarName, FloatVec);
+    EXPECT(Odb->has(GroupName, VarName));
+    EXPECT(Odb->dtype(GroupName, VarName) == ioda::ObsDtype::Float);
+
+    // Remove the variable behind the ObsSpace's back
+    Odb->getObsGroup().vars.remove(GroupName + "/" + VarName);
+    EXPECT(!Odb->has(GroupName, VarName));
+
+    // Re-create it with a different type. The stale float handle must not be used.
+    std::vector<int> IntVec(Nlocs);
+    for (std::size_t i = 0; i < Nlocs; ++i) {
+      IntVec[i] = static_cast<int>(2 * i);
+    }
+    Odb->put_db(GroupName, VarName, IntVec);
+    EXPECT(Odb->has(GroupName, VarName));
+    EXPECT(Odb->dtype(GroupName, VarName) == ioda::ObsDtype::Integer);
+    std::vector<int> TestVec(Nlocs);
+    Odb->get_db(GroupName, VarName, TestVec);
+    EXPECT(TestVec == IntVec);
+
+    Odb->getObsGroup().vars.remove(GroupName + "/" + VarName);
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 void testMultiDimTransfer() {
   typedef ObsSpaceTestFixture Test_;
 
@@ -753,6 +818,8 @@ class ObsSpace : public oops::Test {
       { testPutGetChanSelect(); });
     ts.emplace_back(CASE("ioda/ObsSpace/testWriteableGroup")
       { testWriteableGroup(); });
+    ts.emplace_back(CASE("ioda/ObsSpace/testRemoveRecreateVar")
+      { testRemoveRecreateVar(); });
     ts.emplace_back(CASE("ioda/ObsSpace/testMultiDimTransfer")
       { testMultiDimTransfer(); });
     ts.emplace_back(CASE("ioda/ObsSpace/testCleanup")
@@ -0,0 +1,142 @@
+/*
+ * (C) Copyright 2022 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#ifndef TEST_IODA_OBSSPACETRANSFERTHREADS_H_
+#define TEST_IODA_OBSSPACETRANSFERTHREADS_H_
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#define ECKIT_TESTING_SELF_REGISTER_CASES 0
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Test.h"
+#include "oops/test/TestEnvironment.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+
+#include "ioda/IodaTrait.h"
+#include "ioda/ObsSpace.h"
+#include "ioda/Variables/VarUtils.h"
+
+namespace ioda {
+namespace test {
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+bool sameValue(const T & a, const T & b) {
+  return a == b;
+}
+
+inline bool sameValue(const float a, const float b) {
+  return (a == b) || (std::isnan(a) && std::isnan(b));
+}
+
+// -----------------------------------------------------------------------------
+
+/// Check that every variable of \p actual holds the same values as in \p expected.
+void expectSameObsGroup(const ObsGroup & expected, const ObsGroup & actual) {
+  const std::vector<std::string> varNames =
+      expected.listObjects<ObjectType::Variable>(true);
+  EXPECT(actual.listObjects<ObjectType::Variable>(true) == varNames);
+
+  for (const std::string & varName : varNames) {
+    const Variable expectedVar = expected.vars.open(varName);
+    const Variable actualVar = actual.vars.open(varName);
+    EXPECT(actualVar.getDimensions().dimsCur == expectedVar.getDimensions().dimsCur);
+    VarUtils::forAnySupportedVariableType(
+          expectedVar,
+          [&](auto typeDiscriminator) {
+              typedef decltype(typeDiscriminator) T;
+              EXPECT(actualVar.isA<T>());
+              std::vector<T> expectedValues;
+              std::vector<T> actualValues;
+              expectedVar.read<T>(expectedValues);
+              actualVar.read<T>(actualValues);
+              EXPECT_EQUAL(actualValues.size(), expectedValues.size());
+              std::size_t numDiffs = 0;
+              for (std::size_t i = 0; i < expectedValues.size(); ++i) {
+                  if (!sameValue(actualValues[i], expectedValues[i])) ++numDiffs;
+              }
+              if (numDiffs > 0) {
+                  oops::Log::info() << varName << ": " << numDiffs
+                                    << " values differ" << std::endl;
+              }
+              EXPECT_EQUAL(numDiffs, 0);
+          },
+          VarUtils::ThrowIfVariableIsOfUnsupportedType(varName));
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+void testTransferThreads() {
+  const eckit::LocalConfiguration conf(::test::TestEnvironment::config());
+  util::DateTime bgn(conf.getString("window begin"));
+  util::DateTime end(conf.getString("window end"));
+
+  std::vector<eckit::LocalConfiguration> obsConfs;
+  conf.get("observations", obsConfs);
+  for (const eckit::LocalConfiguration & obsConf : obsConfs) {
+    eckit::LocalConfiguration obsSpaceConf(obsConf, "obs space");
+    oops::Log::info() << "Testing: " << obsSpaceConf.getString("name") << std::endl;
+
+    // Reference obs space, filled serially
+    ObsTopLevelParameters serialParams;
+    serialParams.validateAndDeserialize(obsSpaceConf);
+    ObsSpace serialObsSpace(serialParams, oops::mpi::world(), bgn, end, oops::mpi::myself());
+
+    for (const int numThreads : obsConf.getIntVector("transfer threads")) {
+      oops::Log::info() << "  transfer threads: " << numThreads << std::endl;
+      eckit::LocalConfiguration obsDataInConf(obsSpaceConf, "obsdatain");
+      obsDataInConf.set("transfer threads", numThreads);
+      eckit::LocalConfiguration threadedConf(obsSpaceConf);
+      threadedConf.set("obsdatain", obsDataInConf);
+
+      ObsTopLevelParameters threadedParams;
+      threadedParams.validateAndDeserialize(threadedConf);
+      ObsSpace threadedObsSpace(threadedParams, oops::mpi::world(), bgn, end,
+                                oops::mpi::myself());
+
+      EXPECT_EQUAL(threadedObsSpace.nlocs(), serialObsSpace.nlocs());
+      EXPECT_EQUAL(threadedObsSpace.nrecs(), serialObsSpace.nrecs());
+      expectSameObsGroup(serialObsSpace.getObsGroup(), threadedObsSpace.getObsGroup());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+class ObsSpaceTransferThreads : public oops::Test {
+ public:
+  ObsSpaceTransferThreads() {}
+  virtual ~ObsSpaceTransferThreads() {}
+
+ private:
+  std::string testid() const override {return "test::ObsSpaceTransferThreads<ioda::IodaTrait>";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ioda/ObsSpace/testTransferThreads")
+      { testTransferThreads(); });
+  }
+
+  void clear() const override {}
+};
+
+// -----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace ioda
+
+#endif  // TEST_IODA_OBSSPACETRANSFERTHREADS_H_
@@ -8,6 +8,7 @@
 #ifndef TEST_IODA_SORT_H_
 #define TEST_IODA_SORT_H_
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -45,17 +46,24 @@ void testSort(const eckit::LocalConfiguration &conf) {
   // Number of locations
   const size_t nlocs = obsdata.nlocs();
 
-  // All expected sort indices, obtained from input file
+  // All expected sort indices, listed in the configuration or obtained from input file
   std::vector <int> expectedIndicesAll;
-  expectedIndicesAll.assign(nlocs, 0);
-  const std::string expected_indices_name = conf.getString("expected indices name");
-  obsdata.get_db("MetaData", expected_indices_name, expectedIndicesAll, { });
+  if (conf.has("expected indices")) {
+    expectedIndicesAll = conf.getIntVector("expected indices");
+    EXPECT_EQUAL(expectedIndicesAll.size(), nlocs);
+  } else {
+    expectedIndicesAll.assign(nlocs, 0);
+    const std::string expected_indices_name = conf.getString("expected indices name");
+    obsdata.get_db("MetaData", expected_indices_name, expectedIndicesAll, { });
+  }
 
   // Record index for each location
   const std::vector <size_t> recnums = obsdata.recnum();
 
-  // List of unique record indices
+  // List of unique record indices. Every record is in the index, including records
+  // whose sort values are all missing.
   const std::vector <size_t> recnumList = obsdata.recidx_all_recnums();
+  EXPECT_EQUAL(recnumList.size(), std::set<size_t>(recnums.begin(), recnums.end()).size());
 
   for (size_t rn = 0; rn < recnumList.size(); ++rn) {
     // Expected record indices for this recnum
@@ -72,6 +80,11 @@ void testSort(const eckit::LocalConfiguration &conf) {
                                   recordIndices.end(),
                                   expectedRecordIndices.begin());
     EXPECT(equal);
+
+    // The span accessor must refer to the same locations
+    const gsl::span<const size_t> recordSpan = obsdata.recidx_span(rn);
+    EXPECT(std::equal(recordSpan.begin(), recordSpan.end(),
+                      recordIndices.begin(), recordIndices.end()));
   }
   obsdata.save();
 }